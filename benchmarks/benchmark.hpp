@@ -0,0 +1,32 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <eruptor/eruptor.hpp>
+
+#include <algorithm>
+#include <random>
+
+namespace eru::benchmark
+{
+   using Milliseconds = std::chrono::duration<double, std::milli>;
+
+   // the fastest of a few runs, as that one is the least disturbed by whatever else the machine is doing
+   template<std::invocable Function>
+   [[nodiscard]] auto measure(Function&& function, std::size_t const runs = 5) -> Milliseconds
+   {
+      Milliseconds fastest{ Milliseconds::max() };
+      for (std::size_t run{}; run < runs; ++run)
+      {
+         auto const start{ std::chrono::steady_clock::now() };
+         function();
+         fastest = std::min(fastest, Milliseconds{ std::chrono::steady_clock::now() - start });
+      }
+
+      return fastest;
+   }
+
+   auto bounding_volume_hierarchy() -> void;
+   auto frustum_culler() -> void;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include "benchmark.hpp"
+
+namespace eru::benchmark
+{
+   namespace
+   {
+      using Box = BoundingVolumeHierarchy::Box;
+      using Ray = BoundingVolumeHierarchy::Ray;
+
+      // rays running along a box's faces or edges, starting on them, hit the box; their inverse directions have
+      // infinite components, which the slab test has to keep from turning into NaN distances
+      auto check_axis_parallel_rays() -> void
+      {
+         // spread out over more than one leaf, so that inner nodes are tested against as well
+         std::vector<Box> boxes{};
+         for (float offset{}; offset < 48.0f; offset += 3.0f)
+            boxes.push_back({ glm::vec3{ offset, 0.0f, 0.0f }, glm::vec3{ offset + 1.0f, 1.0f, 1.0f } });
+
+         BoundingVolumeHierarchy hierarchy{};
+         hierarchy.build(boxes);
+
+         std::array<std::pair<Ray, std::optional<float>>, 5> const cases{
+            {
+               { { .origin{ 0.0f, 0.5f, -1.0f }, .direction{ 0.0f, 0.0f, 1.0f } }, 1.0f },
+               { { .origin{ -1.0f, 0.0f, 0.0f }, .direction{ 2.0f, 0.0f, 0.0f } }, 0.5f },
+               { { .origin{ 0.5f, 1.0f, 0.5f }, .direction{ 0.0f, 0.0f, -1.0f } }, 0.0f },
+               { { .origin{ 0.5f, 1.001f, -1.0f }, .direction{ 0.0f, 0.0f, 1.0f } }, std::nullopt },
+               { { .origin{ 1.0f, 0.5f, 2.0f }, .direction{ 0.0f, 0.0f, -1.0f }, .length{ 0.5f } }, std::nullopt }
+            }
+         };
+
+         for (std::size_t index{}; index < cases.size(); ++index)
+         {
+            auto const& [ray, distance]{ cases[index] };
+            std::optional const hit{ hierarchy.cast(ray) };
+            if (hit.has_value() not_eq distance.has_value() or
+               (hit and (hit->object not_eq 0 or std::abs(hit->distance - *distance) > 1.0e-6f)))
+               throw Exception{ std::format("axis-parallel ray {} does not hit as it should!", index) };
+         }
+      }
+   }
+
+   auto bounding_volume_hierarchy() -> void
+   {
+      check_axis_parallel_rays();
+
+      Frustum const frustum{
+         glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f) *
+         glm::lookAt(glm::vec3{}, glm::vec3{ 0.0f, 0.0f, -1.0f }, glm::vec3{ 0.0f, 1.0f, 0.0f })
+      };
+
+      for (std::size_t const object_count : { 10'000uz, 100'000uz, 1'000'000uz })
+      {
+         // the world grows with the object count, so that every size is as densely populated
+         float const extent{ 500.0f * std::cbrt(static_cast<float>(object_count) / 1.0e6f) };
+
+         // seeded, so that runs can be compared against each other
+         std::mt19937 generator{ 0 };
+         std::uniform_real_distribution position_distribution{ -extent, extent };
+         std::uniform_real_distribution size_distribution{ 0.5f, 2.0f };
+         std::uniform_real_distribution offset_distribution{ -0.5f, 0.5f };
+         std::uniform_real_distribution direction_distribution{ -1.0f, 1.0f };
+
+         auto const random_position{
+            [&]() -> glm::vec3
+            {
+               return { position_distribution(generator), position_distribution(generator), position_distribution(generator) };
+            }
+         };
+
+         std::vector<Box> boxes{};
+         std::vector<Box> moved_boxes{};
+         boxes.reserve(object_count);
+         moved_boxes.reserve(object_count);
+         for (std::size_t index{}; index < object_count; ++index)
+         {
+            glm::vec3 const minimum{ random_position() };
+            boxes.push_back({ minimum, minimum + size_distribution(generator) });
+
+            glm::vec3 const offset{ offset_distribution(generator), offset_distribution(generator), offset_distribution(generator) };
+            moved_boxes.push_back({ boxes.back().minimum + offset, boxes.back().maximum + offset });
+         }
+
+         std::vector<Box> query_boxes(1'000);
+         for (Box& box : query_boxes)
+         {
+            box.minimum = random_position();
+            box.maximum = box.minimum + 10.0f;
+         }
+
+         std::vector<Ray> rays(100'000);
+         for (Ray& ray : rays)
+         {
+            ray.origin = random_position();
+            ray.direction = { direction_distribution(generator), direction_distribution(generator), direction_distribution(generator) };
+         }
+
+         BoundingVolumeHierarchy hierarchy{};
+         Milliseconds const build_time{
+            measure([&]() -> void
+            {
+               hierarchy.build(boxes);
+            })
+         };
+
+         // alternates between the two sets of boxes, so that every run actually moves them
+         bool moved{};
+         Milliseconds const refit_time{
+            measure([&]() -> void
+            {
+               moved = not moved;
+               std::vector<Box> const& current_boxes{ moved ? moved_boxes : boxes };
+               for (std::size_t index{}; index < object_count; ++index)
+                  hierarchy.change(static_cast<std::uint32_t>(index), current_boxes[index]);
+
+               hierarchy.refit();
+            })
+         };
+
+         std::vector<std::uint32_t> frustum_objects{};
+         Milliseconds const frustum_time{
+            measure([&]() -> void
+            {
+               frustum_objects.clear();
+               hierarchy.query(frustum, frustum_objects);
+            })
+         };
+
+         std::vector<std::vector<std::uint32_t>> box_objects(query_boxes.size());
+         Milliseconds const box_time{
+            measure([&]() -> void
+            {
+               for (std::vector<std::uint32_t>& objects : box_objects)
+                  objects.clear();
+
+               hierarchy.query(query_boxes, box_objects);
+            })
+         };
+
+         std::vector<std::optional<BoundingVolumeHierarchy::Hit>> hits(rays.size());
+         Milliseconds const cast_time{
+            measure([&]() -> void
+            {
+               hierarchy.cast(rays, hits);
+            })
+         };
+
+         // against every object, for the first few queries only, as that is what the hierarchy is there to avoid
+         std::vector<Box> const& current_boxes{ moved ? moved_boxes : boxes };
+         for (std::size_t query_index{}; query_index < 16; ++query_index)
+         {
+            Box const& query_box{ query_boxes[query_index] };
+            std::vector<std::uint32_t> expected_objects{};
+            for (std::size_t index{}; index < object_count; ++index)
+               if (all(lessThanEqual(query_box.minimum, current_boxes[index].maximum)) and
+                  all(lessThanEqual(current_boxes[index].minimum, query_box.maximum)))
+                  expected_objects.push_back(static_cast<std::uint32_t>(index));
+
+            std::vector<std::uint32_t>& objects{ box_objects[query_index] };
+            std::ranges::sort(objects);
+            if (objects not_eq expected_objects)
+               throw Exception{ std::format("box query {} over {} objects found the wrong objects!", query_index, object_count) };
+         }
+
+         std::println("bounding volume hierarchy {}: build {:.2f} ms, change and refit {:.2f} ms, "
+            "frustum query {:.3f} ms ({} objects), {} box queries {:.2f} ms, {} rays {:.2f} ms",
+            object_count, build_time.count(), refit_time.count(), frustum_time.count(), frustum_objects.size(),
+            query_boxes.size(), box_time.count(), rays.size(), cast_time.count());
+      }
+   }
+}
\ No newline at end of file
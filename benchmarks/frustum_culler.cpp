@@ -0,0 +1,120 @@
+#include "benchmark.hpp"
+
+namespace eru::benchmark
+{
+   namespace
+   {
+      // how far the bounds reach to the inner side of the plane, negative when they lie entirely outside of it
+      [[nodiscard]] auto reach(glm::vec4 const& plane, FrustumCuller::Bounds const bounds,
+         FrustumCuller::Sphere const& sphere, FrustumCuller::Box const& box) -> float
+      {
+         if (bounds == FrustumCuller::Bounds::SPHERES)
+            return glm::dot(glm::vec3{ plane }, sphere.center) + plane.w + sphere.radius;
+
+         return glm::dot(glm::vec3{ plane }, glm::vec3{
+            plane.x >= 0.0f ? box.maximum.x : box.minimum.x,
+            plane.y >= 0.0f ? box.maximum.y : box.minimum.y,
+            plane.z >= 0.0f ? box.maximum.z : box.minimum.z
+         }) + plane.w;
+      }
+
+      // what culling looks like without the culler: one object at a time, straight from its bounds
+      auto cull_scalar(std::array<glm::vec4, 6> const& planes, FrustumCuller::Bounds const bounds,
+         std::span<FrustumCuller::Sphere const> const spheres, std::span<FrustumCuller::Box const> const boxes,
+         std::span<std::uint8_t> const visibility) -> void
+      {
+         for (std::size_t index{}; index < visibility.size(); ++index)
+         {
+            bool inside{ true };
+            for (glm::vec4 const& plane : planes)
+               inside = inside and reach(plane, bounds, spheres[index], boxes[index]) >= 0.0f;
+
+            visibility[index] = inside;
+         }
+      }
+   }
+
+   auto frustum_culler() -> void
+   {
+      ThreadPool& thread_pool{ Locator::get<ThreadPool>() };
+
+      Frustum const frustum{
+         glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f) *
+         glm::lookAt(glm::vec3{}, glm::vec3{ 0.0f, 0.0f, -1.0f }, glm::vec3{ 0.0f, 1.0f, 0.0f })
+      };
+
+      for (std::size_t const object_count : { 1'000'000uz, 4'000'000uz })
+      {
+         // seeded, so that runs can be compared against each other
+         std::mt19937 generator{ 0 };
+         std::uniform_real_distribution position_distribution{ -500.0f, 500.0f };
+         std::uniform_real_distribution radius_distribution{ 0.5f, 2.0f };
+
+         std::vector<FrustumCuller::Sphere> spheres{};
+         std::vector<FrustumCuller::Box> boxes{};
+         spheres.reserve(object_count);
+         boxes.reserve(object_count);
+
+         FrustumCuller culler{};
+         culler.reserve(object_count);
+         for (std::size_t index{}; index < object_count; ++index)
+         {
+            glm::vec3 const center{
+               position_distribution(generator), position_distribution(generator), position_distribution(generator)
+            };
+            float const radius{ radius_distribution(generator) };
+
+            spheres.push_back({ center, radius });
+            boxes.push_back({ center - radius, center + radius });
+            culler.push(spheres.back(), boxes.back());
+         }
+
+         std::vector<std::uint8_t> expected_visibility(object_count);
+         std::vector<std::uint8_t> visibility(object_count);
+         for (FrustumCuller::Bounds const bounds : { FrustumCuller::Bounds::SPHERES, FrustumCuller::Bounds::BOXES })
+         {
+            Milliseconds const scalar_time{
+               measure([&]() -> void
+               {
+                  cull_scalar(frustum.planes(), bounds, spheres, boxes, expected_visibility);
+               })
+            };
+
+            // a single task, so that the culler runs on one thread, like the scalar path does
+            Milliseconds const kernel_time{
+               measure([&]() -> void
+               {
+                  thread_pool.execute(1,
+                     [&](std::size_t, std::size_t) -> void
+                     {
+                        culler.cull(frustum, bounds, visibility);
+                     });
+               })
+            };
+
+            Milliseconds const threaded_time{
+               measure([&]() -> void
+               {
+                  culler.cull(frustum, bounds, visibility);
+               })
+            };
+
+            // the kernels sum in a different order, so objects touching a plane may go either way
+            for (std::size_t index{}; index < object_count; ++index)
+               if (visibility[index] not_eq expected_visibility[index] and
+                  std::ranges::none_of(frustum.planes(),
+                     [&](glm::vec4 const& plane) -> bool
+                     {
+                        return std::abs(reach(plane, bounds, spheres[index], boxes[index])) < 1.0e-3f;
+                     }))
+                  throw Exception{ std::format("the culler disagrees with the scalar path on object {}!", index) };
+
+            std::println("frustum culling {} {}: scalar {:.2f} ms, culler {:.2f} ms ({:.1f}x), over {} threads {:.2f} ms ({:.1f}x)",
+               object_count, bounds == FrustumCuller::Bounds::SPHERES ? "spheres" : "boxes",
+               scalar_time.count(),
+               kernel_time.count(), scalar_time / kernel_time,
+               thread_pool.thread_count(), threaded_time.count(), scalar_time / threaded_time);
+         }
+      }
+   }
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+#include "benchmark.hpp"
+
+auto main() -> int try
+{
+   eru::Locator::provide<eru::ThreadPool>();
+
+   eru::benchmark::bounding_volume_hierarchy();
+   eru::benchmark::frustum_culler();
+
+   eru::Locator::remove_all();
+   return 0;
+}
+catch (eru::Exception const& exception)
+{
+   std::println(std::cerr, "{}", exception.what());
+   eru::Locator::remove_all();
+   return 1;
+}
\ No newline at end of file
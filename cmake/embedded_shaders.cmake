@@ -0,0 +1,53 @@
+function (generate_embedded_shaders SHADER_DIRECTORY OUTPUT_FILE)
+   if (NOT IS_ABSOLUTE ${SHADER_DIRECTORY})
+      message(FATAL_ERROR "SHADER_DIRECTORY must be an absolute path (${SHADER_DIRECTORY})")
+   endif ()
+
+   # built up as strings rather than lists, as the sources are full of semicolons
+   set(CONTENT
+      "// Auto-generated file - do not edit\n"
+      "\n"
+      "#include \"eruptor/exception.hpp\"\n"
+      "\n"
+      "#include \"core/shader.hpp\"\n"
+      "\n"
+      "namespace eru\n"
+      "{\n"
+      "   namespace\n"
+      "   {")
+   string(CONCAT CONTENT ${CONTENT})
+   set(LOOKUP "")
+
+   file(GLOB SHADER_FILE_PATHS CONFIGURE_DEPENDS ${SHADER_DIRECTORY}/*.slang)
+   foreach (SHADER_FILE_PATH ${SHADER_FILE_PATHS})
+      # the output is only written at configure time, so any change to a shader has to configure again
+      set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${SHADER_FILE_PATH})
+
+      get_filename_component(SHADER_FILE ${SHADER_FILE_PATH} NAME)
+      string(MAKE_C_IDENTIFIER ${SHADER_FILE} SHADER_IDENTIFIER)
+      string(TOUPPER ${SHADER_IDENTIFIER} SHADER_IDENTIFIER)
+
+      # as character literals rather than a string literal, which compilers limit in length
+      file(READ ${SHADER_FILE_PATH} SHADER_BYTES HEX)
+      string(REGEX REPLACE "([0-9a-f][0-9a-f])" "'\\\\x\\1', " SHADER_BYTES "${SHADER_BYTES}")
+
+      string(APPEND CONTENT "\n      char const ${SHADER_IDENTIFIER}[]{ ${SHADER_BYTES}};")
+      string(APPEND LOOKUP
+         "      if (name == \"${SHADER_FILE}\")\n"
+         "         return { ${SHADER_IDENTIFIER}, sizeof(${SHADER_IDENTIFIER}) };\n"
+         "\n")
+   endforeach ()
+
+   string(APPEND CONTENT
+      "\n"
+      "   }\n"
+      "\n"
+      "   auto framework_shader_source(std::string_view const name) -> std::string_view\n"
+      "   {\n"
+      "${LOOKUP}"
+      "      throw Exception{ std::format(\"there is no framework shader \\\"{}\\\"!\", name) };\n"
+      "   }\n"
+      "}")
+
+   file(WRITE ${OUTPUT_FILE} "${CONTENT}")
+endfunction ()
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "eruptor/api.hpp"
 #include "eruptor/locator.hpp"
+#include "eruptor/pch.hpp"
 
 namespace eru
 {
@@ -17,8 +18,26 @@ namespace eru
          auto operator=(Application const&) -> Application& = delete;
          auto operator=(Application&&) -> Application& = delete;
 
+         // a frame of its own on the main thread; false to quit. Not called once the application is pipelined
          [[nodiscard]] virtual auto tick() -> bool = 0;
 
+         // an application rendering on demand, as tools and editors do, only has frames once `Platform::wait` returns,
+         // so that it idles while nothing changes; asked again before every frame
+         [[nodiscard]] ERU_API virtual auto on_demand() const -> bool;
+
+         // a pipelined application splits its frames in two: an update on the main thread, which writes the render
+         // state a frame needs into a snapshot, and a render on a render thread, which records, submits and presents
+         // the frame from it. With `SNAPSHOT_COUNT` snapshots, the next frame's update runs while a frame renders, and
+         // either stage only waits for the other when it gets a whole frame ahead
+         static auto constexpr SNAPSHOT_COUNT{ 2uz };
+
+         [[nodiscard]] ERU_API virtual auto pipelined() const -> bool;
+         // the only stage to poll for events or touch windows; the render stage is done with the snapshot, and nothing
+         // the render stage reads besides it may be written to. False to quit, after which nothing else is rendered
+         [[nodiscard]] ERU_API virtual auto update(std::uint8_t snapshot_index) -> bool;
+         // the only stage to use the queue, frames being rendered in the order they were updated in
+         ERU_API virtual auto render(std::uint8_t snapshot_index) -> void;
+
       protected:
          ERU_API explicit Application(PassKey<Locator>);
    };
@@ -0,0 +1,108 @@
+#ifndef BOUNDING_VOLUME_HIERARCHY_HPP
+#define BOUNDING_VOLUME_HIERARCHY_HPP
+
+#include "eruptor/api.hpp"
+#include "eruptor/frustum.hpp"
+#include "eruptor/locator.hpp"
+#include "eruptor/pch.hpp"
+#include "eruptor/thread_pool.hpp"
+
+namespace eru
+{
+   // spatial index over axis-aligned object boxes; built with the surface area heuristic, refitted in place as objects
+   // move, and stored as a flat array of nodes in depth-first order, so that a node's first child directly follows it
+   class BoundingVolumeHierarchy final
+   {
+      public:
+         struct Box final
+         {
+            glm::vec3 minimum;
+            glm::vec3 maximum;
+         };
+
+         // `direction` need not be normalized; hits are reported in multiples of it
+         struct Ray final
+         {
+            glm::vec3 origin;
+            glm::vec3 direction;
+            float length{ std::numeric_limits<float>::infinity() };
+         };
+
+         // against the object's box, not whatever it bounds
+         struct Hit final
+         {
+            std::uint32_t object;
+            float distance;
+         };
+
+         BoundingVolumeHierarchy() = default;
+         BoundingVolumeHierarchy(BoundingVolumeHierarchy const&) = delete;
+         BoundingVolumeHierarchy(BoundingVolumeHierarchy&&) = default;
+
+         ~BoundingVolumeHierarchy() = default;
+
+         auto operator=(BoundingVolumeHierarchy const&) -> BoundingVolumeHierarchy& = delete;
+         auto operator=(BoundingVolumeHierarchy&&) -> BoundingVolumeHierarchy& = delete;
+
+         // objects are indexed by their position in `boxes`
+         ERU_API auto build(std::span<Box const> boxes) -> void;
+
+         // keeps the tree as it is built; cheap enough to do every frame, but the tree degrades as objects drift away
+         // from where they were at build time, so it is worth rebuilding every now and then
+         ERU_API auto change(std::uint32_t object, Box const& box) -> void;
+         ERU_API auto refit() -> void;
+
+         // append the objects found, in no particular order
+         ERU_API auto query(Frustum const& frustum, std::vector<std::uint32_t>& objects) const -> void;
+         ERU_API auto query(Box const& box, std::vector<std::uint32_t>& objects) const -> void;
+
+         // the nearest hit along the ray, if any
+         [[nodiscard]] ERU_API auto cast(Ray const& ray) const -> std::optional<Hit>;
+
+         // split into chunks over the thread pool, unless called from within one of its tasks
+         ERU_API auto query(std::span<Box const> boxes, std::span<std::vector<std::uint32_t>> objects) const -> void;
+         ERU_API auto cast(std::span<Ray const> rays, std::span<std::optional<Hit>> hits) const -> void;
+
+         [[nodiscard]] ERU_API auto size() const -> std::size_t;
+
+      private:
+         // a leaf when it holds objects, with its children at `index + 1` and `first` otherwise
+         struct Node final
+         {
+            Box box;
+            std::uint32_t first;
+            std::uint32_t count;
+         };
+
+         struct Bin final
+         {
+            Box box{ empty_box() };
+            std::uint32_t count{};
+         };
+
+         static auto constexpr BIN_COUNT{ 16uz };
+         static auto constexpr MAXIMUM_LEAF_SIZE{ 4u };
+
+         // nodes this deep become leaves however many objects they hold, which bounds the traversal stack
+         static auto constexpr MAXIMUM_DEPTH{ 64uz };
+
+         static auto constexpr MINIMUM_QUERIES_PER_CHUNK{ 64uz };
+
+         [[nodiscard]] static auto empty_box() -> Box;
+         [[nodiscard]] static auto merged(Box const& box, Box const& other_box) -> Box;
+         [[nodiscard]] static auto surface_area(Box const& box) -> float;
+         [[nodiscard]] static auto overlap(Box const& box, Box const& other_box) -> bool;
+
+         // the distance at which the ray enters the box, if it does so within `limit`
+         [[nodiscard]] static auto entry(Box const& box, glm::vec3 const& origin, glm::vec3 const& inverse_direction,
+            float limit) -> std::optional<float>;
+
+         ThreadPool& thread_pool_{ Locator::get<ThreadPool>() };
+
+         std::vector<Box> boxes_{};
+         std::vector<std::uint32_t> objects_{};
+         std::vector<Node> nodes_{};
+   };
+}
+
+#endif
\ No newline at end of file
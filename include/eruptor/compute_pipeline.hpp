@@ -0,0 +1,49 @@
+#ifndef COMPUTE_PIPELINE_HPP
+#define COMPUTE_PIPELINE_HPP
+
+#include "eruptor/api.hpp"
+#include "eruptor/layout.hpp"
+#include "eruptor/locator.hpp"
+#include "eruptor/pch.hpp"
+
+namespace eru
+{
+   class Context;
+
+   // a compute entry point of a Slang module, along with the workgroup size it declares, so that dispatches can be
+   // sized in threads rather than workgroups
+   class ComputePipeline final
+   {
+      public:
+         // the layout has to outlive the pipeline
+         ERU_API ComputePipeline(Layout const& layout, std::filesystem::path const& shader_path, std::string_view entry_point);
+         // from SPIR-V compiled beforehand
+         ERU_API ComputePipeline(Layout const& layout, std::span<std::uint32_t const> code, std::string_view entry_point);
+         ComputePipeline(ComputePipeline const&) = delete;
+         ComputePipeline(ComputePipeline&&) = delete;
+
+         ~ComputePipeline() = default;
+
+         auto operator=(ComputePipeline const&) -> ComputePipeline& = delete;
+         auto operator=(ComputePipeline&&) -> ComputePipeline& = delete;
+
+         // the workgroups it takes to cover the given threads along every axis
+         [[nodiscard]] ERU_API auto group_count(glm::uvec3 thread_count) const -> glm::uvec3;
+
+         [[nodiscard]] ERU_API auto layout() const -> Layout const&;
+         [[nodiscard]] ERU_API auto pipeline() const -> vk::Pipeline;
+         [[nodiscard]] ERU_API auto workgroup_size() const -> glm::uvec3;
+
+      private:
+         [[nodiscard]] auto workgroup_size(std::span<std::uint32_t const> code, std::string_view entry_point) const -> glm::uvec3;
+         [[nodiscard]] auto pipeline(std::span<std::uint32_t const> code, std::string_view entry_point) const -> vk::raii::Pipeline;
+
+         Context const& context_{ Locator::get<Context>() };
+
+         Layout const& layout_;
+         glm::uvec3 const workgroup_size_;
+         vk::raii::Pipeline const pipeline_;
+   };
+}
+
+#endif
\ No newline at end of file
@@ -21,8 +21,23 @@ namespace eru
          auto operator=(Context const&) -> Context& = delete;
          auto operator=(Context&&) -> Context& = delete;
 
+         // bound to memory of its own, which stays mapped for as long as it lives when host visible
+         struct Buffer final
+         {
+            vk::raii::Buffer buffer;
+            vk::raii::DeviceMemory memory;
+            void* mapped;
+         };
+
          [[nodiscard]] auto create_buffer(vk::BufferCreateInfo const& create_info) const -> vk::raii::Buffer;
          [[nodiscard]] auto allocate_memory(vk::MemoryRequirements const& requirements, vk::MemoryPropertyFlags properties) const -> vk::raii::DeviceMemory;
+         // device local unless host visible, in which case it is host coherent as well
+         [[nodiscard]] auto create_bound_buffer(vk::DeviceSize size, vk::BufferUsageFlags usage, bool host_visible) const -> Buffer;
+         // records a one time command buffer and submits it without waiting, so it has to be kept until it completes
+         [[nodiscard]] auto submit(std::function<void(vk::raii::CommandBuffer const&)> const& record_commands) const -> vk::raii::CommandBuffer;
+         // waits for the queue to go idle, so whatever was recorded is done, and visible to what is submitted after, once
+         // this returns
+         auto submit_immediately(std::function<void(vk::raii::CommandBuffer const&)> const& record_commands) const -> void;
          [[nodiscard]] auto create_semaphores(std::uint32_t count = 1) const -> std::vector<vk::raii::Semaphore>;
          [[nodiscard]] auto create_fences(std::uint32_t count = 1) const -> std::vector<vk::raii::Fence>;
 
@@ -31,6 +46,10 @@ namespace eru
          vk::raii::DebugUtilsMessengerEXT const debug_messenger{ create_debug_messenger() };
          vk::raii::PhysicalDevice const physical_device{ pick_physical_device() };
          std::uint32_t const queue_family_index{ pick_queue_family_index() };
+         // task and mesh shaders, through VK_EXT_mesh_shader; optional, so everything has a fallback without them
+         bool const mesh_shader_support{ query_mesh_shader_support() };
+         // waiting for presentation to complete, through VK_KHR_present_id and VK_KHR_present_wait; optional as well
+         bool const present_wait_support{ query_present_wait_support() };
          vk::raii::Device const device{ create_device() };
          vk::raii::Queue const queue{ retrieve_queue() };
          vk::raii::CommandPool const command_pool{ create_command_pool() };
@@ -40,6 +59,8 @@ namespace eru
          [[nodiscard]] auto create_debug_messenger() const -> vk::raii::DebugUtilsMessengerEXT;
          [[nodiscard]] auto pick_physical_device() const -> vk::raii::PhysicalDevice;
          [[nodiscard]] auto pick_queue_family_index() const -> std::uint32_t;
+         [[nodiscard]] auto query_mesh_shader_support() const -> bool;
+         [[nodiscard]] auto query_present_wait_support() const -> bool;
          [[nodiscard]] auto create_device() const -> vk::raii::Device;
          [[nodiscard]] auto retrieve_queue() const -> vk::raii::Queue;
          [[nodiscard]] auto create_command_pool() const -> vk::raii::CommandPool;
@@ -0,0 +1,98 @@
+#ifndef DEBUG_DRAW_HPP
+#define DEBUG_DRAW_HPP
+
+#include "eruptor/api.hpp"
+#include "eruptor/constants.hpp"
+#include "eruptor/layout.hpp"
+#include "eruptor/locator.hpp"
+#include "eruptor/pch.hpp"
+
+namespace eru
+{
+   class Context;
+
+   // immediate mode lines for diagnostics; shapes are queued as lines from any thread, each thread into a list of its
+   // own, and the lists are merged into one persistently mapped vertex buffer per frame, drawn with a single draw
+   class DebugDraw final
+   {
+      public:
+         ERU_API DebugDraw(vk::Format color_format, vk::Format depth_format);
+         DebugDraw(DebugDraw const&) = delete;
+         DebugDraw(DebugDraw&&) = delete;
+
+         ~DebugDraw() = default;
+
+         auto operator=(DebugDraw const&) -> DebugDraw& = delete;
+         auto operator=(DebugDraw&&) -> DebugDraw& = delete;
+
+         // everything is in world space and queued for the next call to `update`
+         ERU_API auto line(glm::vec3 const& from, glm::vec3 const& to, glm::vec4 const& color) -> void;
+         // axis-aligned
+         ERU_API auto box(glm::vec3 const& minimum, glm::vec3 const& maximum, glm::vec4 const& color) -> void;
+         // as three great circles, one around every axis
+         ERU_API auto sphere(glm::vec3 const& center, float radius, glm::vec4 const& color) -> void;
+         // the volume the given view projection maps onto the clip volume, with depth from 0 to 1
+         ERU_API auto frustum(glm::mat4 const& view_projection, glm::vec4 const& color) -> void;
+
+         // gathers every line queued since the last call into the frame's vertex buffer; lines queued while it runs
+         // end up in either this frame or the next. The frame that last used `frame_index` must have completed
+         ERU_API auto update(std::uint8_t frame_index) -> void;
+
+         // draws the frame's lines, depth tested against but not written to the depth attachment; to be recorded
+         // within rendering to attachments in the formats given on construction
+         ERU_API auto record(vk::raii::CommandBuffer const& command_buffer, std::uint8_t frame_index,
+            glm::mat4 const& view_projection, vk::Extent2D extent) const -> void;
+
+         // clamped to the widths the device supports, and rounded to its nearest step
+         ERU_API auto change_line_width(float line_width) -> void;
+         [[nodiscard]] ERU_API auto line_width() const -> float;
+
+      private:
+         // the color is packed as normalized RGBA8
+         struct LineVertex final
+         {
+            glm::vec3 position;
+            std::uint32_t color;
+         };
+
+         struct ThreadVertices final
+         {
+            std::mutex mutex{};
+            std::vector<LineVertex> vertices{};
+         };
+
+         // persistently mapped; only grows, and only once the frame that last read it has completed
+         struct VertexBuffer final
+         {
+            vk::raii::Buffer buffer{ nullptr };
+            vk::raii::DeviceMemory memory{ nullptr };
+            LineVertex* vertices{};
+            std::size_t capacity{};
+            std::uint32_t vertex_count{};
+         };
+
+         static auto constexpr SPHERE_SEGMENTS{ 32u };
+         static auto constexpr MINIMUM_BUFFER_CAPACITY{ 4096uz };
+
+         [[nodiscard]] static auto next_id() -> std::uint64_t;
+
+         [[nodiscard]] auto thread_vertices() -> ThreadVertices&;
+         auto reserve(VertexBuffer& vertex_buffer, std::size_t count) const -> void;
+
+         [[nodiscard]] auto layout() const -> Layout;
+         [[nodiscard]] auto pipeline(vk::Format color_format, vk::Format depth_format) const -> vk::raii::Pipeline;
+
+         Context const& context_{ Locator::get<Context>() };
+
+         // tells debug draws apart in the per-thread cache of `thread_vertices`, even when one takes another's address
+         std::uint64_t const id_{ next_id() };
+         Layout const layout_{ layout() };
+         vk::raii::Pipeline const pipeline_;
+         float line_width_{ 1.0f };
+         std::mutex threads_mutex_{};
+         std::unordered_map<std::thread::id, std::unique_ptr<ThreadVertices>> threads_{};
+         std::array<VertexBuffer, MAX_FRAMES_IN_FLIGHT> vertex_buffers_{};
+   };
+}
+
+#endif
\ No newline at end of file
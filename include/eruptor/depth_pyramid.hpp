@@ -0,0 +1,72 @@
+#ifndef DEPTH_PYRAMID_HPP
+#define DEPTH_PYRAMID_HPP
+
+#include "eruptor/api.hpp"
+#include "eruptor/compute_pipeline.hpp"
+#include "eruptor/layout.hpp"
+#include "eruptor/locator.hpp"
+#include "eruptor/pch.hpp"
+#include "eruptor/unique_pointer.hpp"
+
+namespace eru
+{
+   class Context;
+
+   // mip chain of a depth buffer where every texel holds the farthest depth of the texels it covers, so that anything
+   // whose nearest depth lies beyond a texel is hidden behind what was drawn there
+   class DepthPyramid final
+   {
+      public:
+         ERU_API DepthPyramid();
+         DepthPyramid(DepthPyramid const&) = delete;
+         DepthPyramid(DepthPyramid&&) = delete;
+
+         ~DepthPyramid() = default;
+
+         auto operator=(DepthPyramid const&) -> DepthPyramid& = delete;
+         auto operator=(DepthPyramid&&) -> DepthPyramid& = delete;
+
+         // the first level matches the depth buffer's extent; the previous pyramid is handed back, if there was one, to be
+         // kept until the device no longer uses it
+         [[nodiscard]] ERU_API auto resize(vk::Extent2D extent) -> UniquePointer<void>;
+
+         // the depth buffer is read in `eShaderReadOnlyOptimal`; once built, the pyramid can be read by compute shaders,
+         // in `eGeneral`, which is the only layout it is ever in
+         ERU_API auto build(vk::raii::CommandBuffer const& command_buffer, vk::Image depth_image,
+            vk::ImageView depth_image_view) const -> void;
+
+         // covers every level
+         [[nodiscard]] ERU_API auto image_view() const -> vk::ImageView;
+         [[nodiscard]] ERU_API auto extent() const -> vk::Extent2D;
+         [[nodiscard]] ERU_API auto level_count() const -> std::uint32_t;
+
+      private:
+         // matches `ReduceConstants` in depth_pyramid.slang
+         struct ReduceConstants final
+         {
+            glm::uvec2 source_size;
+            glm::uvec2 destination_size;
+         };
+
+         static auto constexpr FORMAT{ vk::Format::eR32Sfloat };
+
+         [[nodiscard]] auto layout() const -> Layout;
+         [[nodiscard]] auto pipeline() const -> ComputePipeline;
+         [[nodiscard]] auto image(vk::Extent2D extent, std::uint32_t level_count) const -> vk::raii::Image;
+         [[nodiscard]] auto image_memory() const -> vk::raii::DeviceMemory;
+         [[nodiscard]] auto image_view(std::uint32_t first_level, std::uint32_t level_count) const -> vk::raii::ImageView;
+
+         Context const& context_{ Locator::get<Context>() };
+
+         Layout const layout_{ layout() };
+         ComputePipeline const pipeline_{ pipeline() };
+         vk::Extent2D extent_{};
+         std::uint32_t level_count_{};
+         vk::raii::Image image_{ nullptr };
+         vk::raii::DeviceMemory image_memory_{ nullptr };
+         vk::raii::ImageView image_view_{ nullptr };
+         std::vector<vk::raii::ImageView> level_image_views_{};
+   };
+}
+
+#endif
\ No newline at end of file
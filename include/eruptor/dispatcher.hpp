@@ -0,0 +1,112 @@
+#ifndef DISPATCHER_HPP
+#define DISPATCHER_HPP
+
+#include "eruptor/api.hpp"
+#include "eruptor/compute_pipeline.hpp"
+#include "eruptor/pch.hpp"
+
+namespace eru
+{
+   // gathers compute dispatches and records them with only the barriers they need; a dispatch depends on every earlier
+   // one that writes what it accesses, or that reads what it writes, which puts it at least one level above them, and
+   // every level is recorded as a whole, ordered by pipeline, with a single barrier before the next
+   class Dispatcher final
+   {
+      public:
+         enum class Access
+         {
+            READ,
+            WRITE,
+            READ_WRITE
+         };
+
+         struct BufferBinding final
+         {
+            std::uint32_t binding;
+            vk::DescriptorType type;
+            vk::Buffer buffer;
+            Access access;
+            vk::DeviceSize offset{};
+            vk::DeviceSize range{ vk::WholeSize };
+         };
+
+         // the image is what dependencies are tracked by, as a whole; it is never transitioned, so it has to stay in the
+         // given layout for as long as the dispatches using it are, has to be a color image if written, and can be left
+         // out for lone samplers
+         struct ImageBinding final
+         {
+            std::uint32_t binding;
+            vk::DescriptorType type;
+            vk::Image image;
+            vk::ImageView image_view;
+            vk::ImageLayout layout;
+            Access access;
+            vk::Sampler sampler{};
+         };
+
+         // bindings are pushed to the layout's push descriptor set; everything is copied, so none of it has to outlive
+         // the call to `dispatch`
+         struct Dispatch final
+         {
+            ComputePipeline const& pipeline;
+            glm::uvec3 thread_count;
+            std::span<BufferBinding const> buffers{};
+            std::span<ImageBinding const> images{};
+            std::span<std::byte const> push_constants{};
+         };
+
+         Dispatcher() = default;
+         Dispatcher(Dispatcher const&) = default;
+         Dispatcher(Dispatcher&&) = default;
+
+         ~Dispatcher() = default;
+
+         auto operator=(Dispatcher const&) -> Dispatcher& = default;
+         auto operator=(Dispatcher&&) -> Dispatcher& = default;
+
+         // the pipeline has to outlive the next call to `record`
+         ERU_API auto dispatch(Dispatch const& dispatch) -> void;
+
+         // records every dispatch gathered since the last call, then forgets them; whatever they wrote is made visible to
+         // the given consumer, if any, and left to the caller otherwise
+         ERU_API auto record(vk::raii::CommandBuffer const& command_buffer,
+            vk::PipelineStageFlags2 consumer_stages = vk::PipelineStageFlagBits2::eNone,
+            vk::AccessFlags2 consumer_access = vk::AccessFlagBits2::eNone) -> void;
+
+      private:
+         struct QueuedDispatch final
+         {
+            ComputePipeline const* pipeline;
+            glm::uvec3 group_count;
+            std::vector<BufferBinding> buffers;
+            std::vector<ImageBinding> images;
+            std::vector<std::byte> push_constants;
+            std::uint32_t level;
+         };
+
+         // the level a resource was last written at, and the highest it has been read at since
+         struct ResourceState final
+         {
+            std::optional<std::uint32_t> written_level{};
+            std::optional<std::uint32_t> read_level{};
+         };
+
+         // what one level wrote, to be made visible to the levels above it
+         struct LevelWrites final
+         {
+            std::vector<vk::BufferMemoryBarrier2> buffers{};
+            std::vector<vk::ImageMemoryBarrier2> images{};
+         };
+
+         [[nodiscard]] static auto writes(Access access) -> bool;
+
+         auto record_dispatch(vk::raii::CommandBuffer const& command_buffer, QueuedDispatch const& dispatch) const -> void;
+         static auto record_barrier(vk::raii::CommandBuffer const& command_buffer, LevelWrites& level_writes) -> void;
+
+         std::vector<QueuedDispatch> dispatches_{};
+         std::unordered_map<vk::Buffer, ResourceState> buffer_states_{};
+         std::unordered_map<vk::Image, ResourceState> image_states_{};
+   };
+}
+
+#endif
\ No newline at end of file
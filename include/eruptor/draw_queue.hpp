@@ -0,0 +1,81 @@
+#ifndef DRAW_QUEUE_HPP
+#define DRAW_QUEUE_HPP
+
+#include "eruptor/api.hpp"
+#include "eruptor/pch.hpp"
+
+namespace eru
+{
+   // orders draws by the state they need, most expensive to change first, so that recording them in order binds as
+   // little as possible; within equal state, draws are ordered front to back. Passes and pipelines are not a part of
+   // the key, as the renderer records every draw list once per pass, with a single pipeline bound
+   class DrawQueue final
+   {
+      public:
+         struct Key final
+         {
+            static auto constexpr MATERIAL_BITS{ 16u };
+            static auto constexpr MESH_BITS{ 16u };
+            static auto constexpr DEPTH_BITS{ 32u };
+
+            static auto constexpr MESH_MASK{ ((std::uint64_t{ 1 } << MESH_BITS) - 1) << DEPTH_BITS };
+            static auto constexpr MATERIAL_MASK{ ((std::uint64_t{ 1 } << MATERIAL_BITS) - 1) << (MESH_BITS + DEPTH_BITS) };
+            // everything above the depth bits; keys with equal state can be drawn without binding anything in between
+            static auto constexpr STATE_MASK{ MATERIAL_MASK | MESH_MASK };
+
+            // throws when the material or mesh does not fit in its bits, as it would end up in the neighbouring ones
+            [[nodiscard]] ERU_API auto packed() const -> std::uint64_t;
+
+            std::uint32_t material;
+            std::uint32_t mesh;
+            float depth;
+         };
+
+         struct Entry final
+         {
+            std::uint64_t key;
+            std::uint32_t index;
+         };
+
+         // between consecutive entries, per kind of state; a material change does not count as a mesh change
+         struct StateChanges final
+         {
+            std::size_t materials{};
+            std::size_t meshes{};
+         };
+
+         DrawQueue() = default;
+         DrawQueue(DrawQueue const&) = default;
+         DrawQueue(DrawQueue&&) = default;
+
+         ~DrawQueue() = default;
+
+         auto operator=(DrawQueue const&) -> DrawQueue& = default;
+         auto operator=(DrawQueue&&) -> DrawQueue& = default;
+
+         ERU_API auto reserve(std::size_t count) -> void;
+         ERU_API auto push(Key const& key, std::uint32_t index) -> void;
+         ERU_API auto sort() -> void;
+         ERU_API auto clear() -> void;
+
+         [[nodiscard]] ERU_API auto entries() const -> std::span<Entry const>;
+
+         // before and after the last sort
+         [[nodiscard]] ERU_API auto submission_state_changes() const -> StateChanges const&;
+         [[nodiscard]] ERU_API auto sorted_state_changes() const -> StateChanges const&;
+
+      private:
+         static auto constexpr RADIX_BITS{ 8u };
+         static auto constexpr RADIX_SIZE{ 1uz << RADIX_BITS };
+         static auto constexpr RADIX_PASSES{ 64u / RADIX_BITS };
+
+         [[nodiscard]] static auto state_changes(std::span<Entry const> entries) -> StateChanges;
+
+         std::vector<Entry> entries_{};
+         std::vector<Entry> scratch_{};
+         StateChanges submission_state_changes_{};
+         StateChanges sorted_state_changes_{};
+   };
+}
+
+#endif
\ No newline at end of file
@@ -5,24 +5,44 @@
 
 #include "eruptor/api.hpp"
 #include "eruptor/application.hpp"
+#include "eruptor/bounding_volume_hierarchy.hpp"
+#include "eruptor/compute_pipeline.hpp"
 #include "eruptor/constants.hpp"
 #include "eruptor/context.hpp"
+#include "eruptor/debug_draw.hpp"
+#include "eruptor/depth_pyramid.hpp"
+#include "eruptor/dispatcher.hpp"
+#include "eruptor/draw_queue.hpp"
 #include "eruptor/exception.hpp"
+#include "eruptor/frame_pacer.hpp"
+#include "eruptor/frame_scheduler.hpp"
+#include "eruptor/frustum.hpp"
+#include "eruptor/frustum_culler.hpp"
+#include "eruptor/geometry_pool.hpp"
 #include "eruptor/hash.hpp"
+#include "eruptor/instance.hpp"
 #include "eruptor/layout.hpp"
+#include "eruptor/light_clusters.hpp"
 #include "eruptor/locator.hpp"
 #include "eruptor/logger.hpp"
+#include "eruptor/meshlets.hpp"
 #include "eruptor/pass_key.hpp"
 #include "eruptor/pch.hpp"
 #include "eruptor/platform.hpp"
+#include "eruptor/post_processor.hpp"
 #include "eruptor/render_pass.hpp"
 #include "eruptor/renderer.hpp"
+#include "eruptor/resolution_controller.hpp"
 #include "eruptor/runtime_assert.hpp"
+#include "eruptor/skinner.hpp"
 #include "eruptor/swap_chain.hpp"
+#include "eruptor/thread_pool.hpp"
 #include "eruptor/type_index.hpp"
 #include "eruptor/unique_parameter_pack.hpp"
 #include "eruptor/unique_pointer.hpp"
+#include "eruptor/upscaler.hpp"
 #include "eruptor/vertex.hpp"
+#include "eruptor/vertex_layout.hpp"
 #include "eruptor/void_deleter.hpp"
 #include "eruptor/window.hpp"
 
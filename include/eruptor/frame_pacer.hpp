@@ -0,0 +1,93 @@
+#ifndef FRAME_PACER_HPP
+#define FRAME_PACER_HPP
+
+#include "eruptor/api.hpp"
+#include "eruptor/constants.hpp"
+#include "eruptor/locator.hpp"
+#include "eruptor/pch.hpp"
+
+namespace eru
+{
+   class Context;
+   class SwapChain;
+
+   // decides when the next frame may begin, so that frames neither pile up on their way to the screen, adding latency,
+   // nor come faster than they are wanted; waits for frames to be presented through VK_KHR_present_wait where
+   // available, and otherwise leaves waiting for them to complete to whoever submits them. The frame rate is held with
+   // sleeps that learn how much the system tends to oversleep, spinning for the rest
+   class FramePacer final
+   {
+      public:
+         struct Description final
+         {
+            // how many frames may still be on their way to the screen when the next one begins; fewer means less
+            // latency, but less overlap between the host and the device
+            std::uint32_t max_queued_frames{ MAX_FRAMES_IN_FLIGHT - 1 };
+            // in frames per second; nothing to leave the frame rate to the present mode
+            std::optional<double> target_frame_rate{};
+         };
+
+         // of the latest frame known to be presented, which lags behind the latest frame begun by the queued ones
+         struct Measurements final
+         {
+            // since the frame presented before it
+            std::chrono::duration<double, std::milli> present_interval{};
+            // from the frame beginning, around when its input is sampled, to it reaching the screen
+            std::chrono::duration<double, std::milli> latency{};
+            // without present waits, presentation is only known to be requested, and the latency is estimated by
+            // assuming every queued frame ahead of it takes a present interval
+            bool estimated{};
+         };
+
+         static auto constexpr MAX_QUEUED_FRAMES{ 8u };
+
+         ERU_API explicit FramePacer(Description const& description = {});
+         FramePacer(FramePacer const&) = delete;
+         FramePacer(FramePacer&&) = delete;
+
+         ~FramePacer() = default;
+
+         auto operator=(FramePacer const&) -> FramePacer& = delete;
+         auto operator=(FramePacer&&) -> FramePacer& = delete;
+
+         // blocks until the next frame may begin
+         ERU_API auto pace(SwapChain const& swap_chain) -> void;
+         // to present the frame begun last with; nothing without present waits
+         [[nodiscard]] ERU_API auto present_id() const -> std::uint64_t;
+         // the frame begun last was handed over for presentation with `present_id`; frames that never are, are not
+         // measured
+         ERU_API auto presented() -> void;
+
+         ERU_API auto change_max_queued_frames(std::uint32_t max_queued_frames) -> void;
+         [[nodiscard]] ERU_API auto max_queued_frames() const -> std::uint32_t;
+         ERU_API auto change_target_frame_rate(std::optional<double> target_frame_rate) -> void;
+         [[nodiscard]] ERU_API auto target_frame_rate() const -> std::optional<double>;
+
+         [[nodiscard]] ERU_API auto measurements() const -> Measurements const&;
+
+      private:
+         using Clock = std::chrono::steady_clock;
+
+         // waiting longer means presentation stalled, which pacing is no reason to hang on
+         static auto constexpr PRESENT_TIMEOUT{ std::chrono::milliseconds{ 100 } };
+
+         auto sleep_until(Clock::time_point deadline) -> void;
+         auto measure(std::uint64_t present_id, Clock::time_point present_time, bool estimated) -> void;
+
+         Context const& context_{ Locator::get<Context>() };
+
+         std::uint32_t max_queued_frames_{};
+         std::optional<double> target_frame_rate_{};
+         // when each frame still to be measured began, by present id
+         std::array<Clock::time_point, MAX_QUEUED_FRAMES + 1> begin_times_{};
+         std::uint64_t last_present_id_{};
+         std::uint64_t last_measured_present_id_{};
+         Clock::time_point last_present_time_{};
+         Clock::time_point next_deadline_{};
+         // how much longer sleeps tend to take than asked for, as a moving average
+         Clock::duration sleep_overshoot_{ std::chrono::milliseconds{ 1 } };
+         Measurements measurements_{};
+   };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,95 @@
+#ifndef FRAME_SCHEDULER_HPP
+#define FRAME_SCHEDULER_HPP
+
+#include "eruptor/api.hpp"
+#include "eruptor/constants.hpp"
+#include "eruptor/frame_pacer.hpp"
+#include "eruptor/locator.hpp"
+#include "eruptor/pass_key.hpp"
+#include "eruptor/pch.hpp"
+#include "eruptor/renderer.hpp"
+
+namespace eru
+{
+   class Context;
+   class SwapChain;
+   class Window;
+
+   // the frame loop around recording: waits for the frame in flight whose index comes around again, acquires an image
+   // to render into, and once recorded, submits and presents it; frames in flight are kept apart on the device by a
+   // single timeline semaphore, which every submission signals with a value one higher than the last
+   class FrameScheduler final
+   {
+      public:
+         // what the frame can be recorded into and with; its command buffer is to be begun and ended by whoever records
+         struct Frame final
+         {
+            Renderer::FrameData frame_data;
+            Renderer::Target target;
+            std::uint32_t image_index;
+         };
+
+         // of the latest call to `begin`
+         struct WaitTimes final
+         {
+            // for the frame pacer to let the frame begin
+            std::chrono::duration<double, std::milli> pacing{};
+            // for the frame in flight that last used the frame index to complete on the device
+            std::chrono::duration<double, std::milli> frame{};
+            // for the swap chain to hand out an image
+            std::chrono::duration<double, std::milli> image{};
+         };
+
+         ERU_API FrameScheduler(PassKey<Locator>, Window& window, FramePacer::Description const& pacing = {});
+         FrameScheduler(FrameScheduler const&) = delete;
+         FrameScheduler(FrameScheduler&&) = delete;
+
+         ERU_API ~FrameScheduler();
+
+         auto operator=(FrameScheduler const&) -> FrameScheduler& = delete;
+         auto operator=(FrameScheduler&&) -> FrameScheduler& = delete;
+
+         // nothing when no image could be acquired or the window is minimized, in which case there is no frame to end;
+         // the swap chain is recreated first when the window was resized or it no longer matches the surface, without
+         // waiting for the frames in flight, so rendering carries on while the window is being resized
+         [[nodiscard]] ERU_API auto begin() -> std::optional<Frame>;
+         // submits the frame's command buffer, waiting on the acquired image before anything writes to it as a color
+         // attachment, and presents the image once the command buffer completes
+         ERU_API auto end() -> void;
+
+         [[nodiscard]] ERU_API auto wait_times() const -> WaitTimes const&;
+         [[nodiscard]] ERU_API auto frame_pacer() -> FramePacer&;
+         [[nodiscard]] ERU_API auto frame_pacer() const -> FramePacer const&;
+         [[nodiscard]] ERU_API auto frames_in_flight() const -> std::uint8_t;
+
+      private:
+         [[nodiscard]] auto timeline_semaphore() const -> vk::raii::Semaphore;
+         [[nodiscard]] auto command_pools() const -> std::vector<vk::raii::CommandPool>;
+         [[nodiscard]] auto command_buffers() const -> std::vector<vk::raii::CommandBuffer>;
+         auto recreate_swap_chain(vk::Extent2D extent) -> void;
+
+         Context const& context_{ Locator::get<Context>() };
+
+         Window const& window_;
+         SwapChain& swap_chain_;
+         // never more than the swap chain has image available semaphores for
+         std::uint8_t const frames_in_flight_;
+         vk::raii::Semaphore const timeline_semaphore_{ timeline_semaphore() };
+         std::vector<vk::raii::CommandPool> const command_pools_{ command_pools() };
+         std::vector<vk::raii::CommandBuffer> const command_buffers_{ command_buffers() };
+         FramePacer frame_pacer_;
+         // the timeline value each frame index was last submitted with; its resources are free again once it is reached
+         std::array<std::uint64_t, MAX_FRAMES_IN_FLIGHT> submitted_values_{};
+         std::uint64_t timeline_value_{};
+         std::uint8_t frame_index_{};
+         // of the frame in progress, if any
+         std::optional<std::uint32_t> image_index_{};
+         WaitTimes wait_times_{};
+         // the window's extent in pixels the swap chain was last created for, which its own extent may differ from
+         vk::Extent2D swap_chain_window_extent_{ swap_chain_.extent() };
+         // set once presenting reports that the swap chain no longer matches the surface
+         bool out_of_date_{};
+   };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,30 @@
+#ifndef FRUSTUM_HPP
+#define FRUSTUM_HPP
+
+#include "eruptor/api.hpp"
+#include "eruptor/pch.hpp"
+
+namespace eru
+{
+   class Frustum final
+   {
+      public:
+         // clip space depth is expected to run from 0 to 1
+         ERU_API explicit Frustum(glm::mat4 const& view_projection);
+         Frustum(Frustum const&) = default;
+         Frustum(Frustum&&) = default;
+
+         ~Frustum() = default;
+
+         auto operator=(Frustum const&) -> Frustum& = default;
+         auto operator=(Frustum&&) -> Frustum& = default;
+
+         // normalized, pointing inwards, in the order left, right, bottom, top, near, far
+         [[nodiscard]] ERU_API auto planes() const -> std::array<glm::vec4, 6> const&;
+
+      private:
+         std::array<glm::vec4, 6> planes_;
+   };
+}
+
+#endif
\ No newline at end of file
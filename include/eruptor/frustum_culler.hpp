@@ -0,0 +1,85 @@
+#ifndef FRUSTUM_CULLER_HPP
+#define FRUSTUM_CULLER_HPP
+
+#include "eruptor/api.hpp"
+#include "eruptor/frustum.hpp"
+#include "eruptor/locator.hpp"
+#include "eruptor/pch.hpp"
+#include "eruptor/thread_pool.hpp"
+
+namespace eru
+{
+   // keeps object bounds as one float stream per component, so that they can be tested against a frustum several
+   // objects at a time; AVX2 or SSE kernels are used when the build targets them, a scalar one otherwise
+   class FrustumCuller final
+   {
+      public:
+         enum class Bounds
+         {
+            SPHERES,
+            BOXES
+         };
+
+         // both in world space
+         struct Sphere final
+         {
+            glm::vec3 center;
+            float radius;
+         };
+
+         struct Box final
+         {
+            glm::vec3 minimum;
+            glm::vec3 maximum;
+         };
+
+         FrustumCuller() = default;
+         FrustumCuller(FrustumCuller const&) = delete;
+         FrustumCuller(FrustumCuller&&) = default;
+
+         ~FrustumCuller() = default;
+
+         auto operator=(FrustumCuller const&) -> FrustumCuller& = delete;
+         auto operator=(FrustumCuller&&) -> FrustumCuller& = delete;
+
+         ERU_API auto reserve(std::size_t count) -> void;
+
+         // objects are indexed in the order they were pushed in
+         ERU_API auto push(Sphere const& sphere, Box const& box) -> std::uint32_t;
+         ERU_API auto change(std::uint32_t object, Sphere const& sphere, Box const& box) -> void;
+         ERU_API auto clear() -> void;
+
+         [[nodiscard]] ERU_API auto size() const -> std::size_t;
+
+         // writes 1 for every object whose bounds intersect the frustum and 0 for every other one, by object index; the
+         // objects are split into chunks over the thread pool, unless called from within one of its tasks
+         ERU_API auto cull(Frustum const& frustum, Bounds bounds, std::span<std::uint8_t> visibility) const -> void;
+
+      private:
+         // below this, splitting the objects costs more than testing them on a single thread
+         static auto constexpr MINIMUM_OBJECTS_PER_CHUNK{ 16384uz };
+
+         // chunks start at a multiple of the widest kernel, so only the last one has a scalar tail
+         static auto constexpr CHUNK_ALIGNMENT{ 8uz };
+
+         auto cull_spheres(std::array<glm::vec4, 6> const& planes, std::size_t begin, std::size_t end,
+            std::span<std::uint8_t> visibility) const -> void;
+         auto cull_boxes(std::array<glm::vec4, 6> const& planes, std::size_t begin, std::size_t end,
+            std::span<std::uint8_t> visibility) const -> void;
+
+         ThreadPool& thread_pool_{ Locator::get<ThreadPool>() };
+
+         std::vector<float> center_x_{};
+         std::vector<float> center_y_{};
+         std::vector<float> center_z_{};
+         std::vector<float> radius_{};
+         std::vector<float> minimum_x_{};
+         std::vector<float> minimum_y_{};
+         std::vector<float> minimum_z_{};
+         std::vector<float> maximum_x_{};
+         std::vector<float> maximum_y_{};
+         std::vector<float> maximum_z_{};
+   };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,91 @@
+#ifndef GEOMETRY_POOL_HPP
+#define GEOMETRY_POOL_HPP
+
+#include "eruptor/api.hpp"
+#include "eruptor/locator.hpp"
+#include "eruptor/pch.hpp"
+#include "eruptor/unique_pointer.hpp"
+
+namespace eru
+{
+   class Context;
+
+   // one device local vertex buffer and one index buffer that every mesh takes a range of, so that meshes can be drawn
+   // one after the other, or all at once, without binding anything in between; ranges are handed out first fit from a
+   // list of free ranges, which freed ranges are merged back into with their neighbours
+   class GeometryPool final
+   {
+      public:
+         // in bytes
+         struct Range final
+         {
+            vk::DeviceSize offset;
+            vk::DeviceSize size;
+         };
+
+         // the buffer the pool outgrew to fit the range is handed back, if it did, to be kept until the device no longer
+         // uses it
+         struct Allocation final
+         {
+            Range range;
+            UniquePointer<void> outgrown;
+         };
+
+         ERU_API GeometryPool();
+         GeometryPool(GeometryPool const&) = delete;
+         GeometryPool(GeometryPool&&) = delete;
+
+         ~GeometryPool() = default;
+
+         auto operator=(GeometryPool const&) -> GeometryPool& = delete;
+         auto operator=(GeometryPool&&) -> GeometryPool& = delete;
+
+         // when a range does not fit, the buffer is replaced by one twice as large, and what it held is copied over by
+         // the queue, after whatever was submitted before; offsets stay the same, but buffers recorded before do not
+         [[nodiscard]] ERU_API auto allocate_vertices(vk::DeviceSize size, vk::DeviceSize alignment) -> Allocation;
+         // 16-bit indices
+         [[nodiscard]] ERU_API auto allocate_indices(vk::DeviceSize size) -> Allocation;
+         // whatever still draws from the range has to have completed
+         ERU_API auto free_vertices(Range range) -> void;
+         ERU_API auto free_indices(Range range) -> void;
+
+         // a null handle until something is first allocated
+         [[nodiscard]] ERU_API auto vertex_buffer() const -> vk::Buffer;
+         [[nodiscard]] ERU_API auto index_buffer() const -> vk::Buffer;
+
+      private:
+         struct Arena final
+         {
+            vk::BufferUsageFlags usage;
+            vk::raii::Buffer buffer{ nullptr };
+            vk::raii::DeviceMemory memory{ nullptr };
+            vk::DeviceSize capacity{};
+            // sizes by offset
+            std::map<vk::DeviceSize, vk::DeviceSize> free_ranges{};
+         };
+
+         static auto constexpr MINIMUM_CAPACITY{ vk::DeviceSize{ 1 } << 20 };
+
+         [[nodiscard]] auto allocate(Arena& arena, vk::DeviceSize size, vk::DeviceSize alignment) const -> Allocation;
+         auto free(Arena& arena, Range range) const -> void;
+         [[nodiscard]] auto grow(Arena& arena, vk::DeviceSize minimum_capacity) const -> UniquePointer<void>;
+         [[nodiscard]] auto copy(vk::Buffer source, vk::Buffer destination, vk::DeviceSize size) const -> vk::raii::CommandBuffer;
+
+         Context const& context_{ Locator::get<Context>() };
+
+         Arena vertices_{
+            .usage{
+               vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eStorageBuffer |
+               vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst
+            }
+         };
+         Arena indices_{
+            .usage{
+               vk::BufferUsageFlagBits::eIndexBuffer | vk::BufferUsageFlagBits::eTransferSrc |
+               vk::BufferUsageFlagBits::eTransferDst
+            }
+         };
+   };
+}
+
+#endif
\ No newline at end of file
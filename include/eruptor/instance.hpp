@@ -0,0 +1,19 @@
+﻿#ifndef INSTANCE_HPP
+#define INSTANCE_HPP
+
+#include "pch.hpp"
+
+namespace eru
+{
+   // advanced once per instance, alongside the per-vertex stream at binding 0
+   struct Instance final
+   {
+      static std::array<vk::VertexInputBindingDescription, 1> const INPUT_BINDING_DESCRIPTIONS;
+      static std::array<vk::VertexInputAttributeDescription, 5> const INPUT_ATTRIBUTE_DESCRIPTIONS;
+
+      glm::mat4 transform;
+      std::uint32_t id;
+   };
+}
+
+#endif
\ No newline at end of file
@@ -10,13 +10,15 @@ namespace eru
 
    class Layout final
    {
-      struct Description final
-      {
-         std::span<std::span<vk::DescriptorSetLayoutBinding const>> const sets;
-         std::span<vk::PushConstantRange const> const push_constants;
-      };
-
       public:
+         struct Description final
+         {
+            std::span<std::span<vk::DescriptorSetLayoutBinding const> const> const sets;
+            std::span<vk::PushConstantRange const> const push_constants;
+            // the set whose descriptors are pushed rather than bound, if any; there can be at most one
+            std::optional<std::uint32_t> const push_descriptor_set{};
+         };
+
          ERU_API explicit Layout(Description const& description);
 
          Layout(Layout const&) = delete;
@@ -27,7 +29,12 @@ namespace eru
          auto operator=(Layout const&) -> Layout& = delete;
          auto operator=(Layout&&) -> Layout& = delete;
 
+         [[nodiscard]] ERU_API auto descriptor_set_layout(std::uint32_t set) const -> vk::DescriptorSetLayout;
+         [[nodiscard]] ERU_API auto pipeline_layout() const -> vk::PipelineLayout;
+         [[nodiscard]] ERU_API auto push_descriptor_set() const -> std::optional<std::uint32_t>;
+
       private:
+         std::optional<std::uint32_t> push_descriptor_set_;
          std::vector<vk::raii::DescriptorSetLayout> descriptor_set_layouts_{};
          vk::raii::PipelineLayout pipeline_layout_{ nullptr };
    };
@@ -0,0 +1,112 @@
+#ifndef LIGHT_CLUSTERS_HPP
+#define LIGHT_CLUSTERS_HPP
+
+#include "eruptor/api.hpp"
+#include "eruptor/context.hpp"
+#include "eruptor/locator.hpp"
+#include "eruptor/pch.hpp"
+
+namespace eru
+{
+   // bins point lights into a grid of view space froxels, tiled over the screen and sliced exponentially in depth, so
+   // that every fragment only walks the lights of the cluster it falls in rather than every light in the scene
+   class LightClusters final
+   {
+      public:
+         // in world space; its contribution fades out to nothing at `radius`
+         struct Light final
+         {
+            glm::vec3 position;
+            float radius;
+            glm::vec3 color;
+         };
+
+         static auto constexpr MAX_LIGHTS{ 16384uz };
+
+         ERU_API LightClusters();
+         LightClusters(LightClusters const&) = delete;
+         LightClusters(LightClusters&&) = delete;
+
+         ~LightClusters() = default;
+
+         auto operator=(LightClusters const&) -> LightClusters& = delete;
+         auto operator=(LightClusters&&) -> LightClusters& = delete;
+
+         // the frame that last used `frame_index` must have completed
+         ERU_API auto update(std::uint8_t frame_index, std::span<Light const> lights, glm::mat4 const& view,
+            glm::mat4 const& projection, float near_plane, float far_plane, vk::Extent2D extent) -> void;
+
+         // once built, the clusters can be read by fragment shaders
+         ERU_API auto build(vk::raii::CommandBuffer const& command_buffer, std::uint8_t frame_index) const -> void;
+
+         // everything a shading pass binds to walk the clusters, in the layout of renderer.slang; fixed in size, so that
+         // descriptors written once stay valid
+         [[nodiscard]] ERU_API auto frame_buffer(std::uint8_t frame_index) const -> vk::Buffer;
+         [[nodiscard]] ERU_API auto light_buffer(std::uint8_t frame_index) const -> vk::Buffer;
+         [[nodiscard]] ERU_API auto cluster_buffer(std::uint8_t frame_index) const -> vk::Buffer;
+         [[nodiscard]] ERU_API auto light_index_buffer(std::uint8_t frame_index) const -> vk::Buffer;
+
+      private:
+         // matches `ClusterFrame` in light_clusters.slang and renderer.slang
+         struct ClusterFrame final
+         {
+            glm::mat4 inverse_projection;
+            glm::uvec3 grid_size;
+            std::uint32_t light_count;
+            glm::vec2 screen_size;
+            float near_plane;
+            float far_plane;
+         };
+
+         // matches `Light` in light_clusters.slang and renderer.slang
+         struct ViewLight final
+         {
+            glm::vec3 position;
+            float radius;
+            glm::vec3 color;
+            float padding;
+         };
+
+         // matches `Cluster` in light_clusters.slang and renderer.slang
+         struct Cluster final
+         {
+            std::uint32_t first_light_index;
+            std::uint32_t light_count;
+         };
+
+         using Buffer = Context::Buffer;
+
+         struct FrameBuffers final
+         {
+            Buffer frame;
+            Buffer lights;
+            Buffer clusters;
+            Buffer light_indices;
+            Buffer light_index_count;
+         };
+
+         // a 16:9 tiling of the screen; the slices get thicker with depth, as perspective spreads distant pixels further apart
+         static auto constexpr GRID_SIZE{ std::to_array({ 16u, 9u, 24u }) };
+         static auto constexpr CLUSTER_COUNT{ GRID_SIZE[0] * GRID_SIZE[1] * GRID_SIZE[2] };
+
+         // clusters hold this many lights on average before the index list runs out, after which the clusters that come
+         // last lose theirs
+         static auto constexpr AVERAGE_LIGHTS_PER_CLUSTER{ 32u };
+
+         static auto constexpr WORKGROUP_SIZE{ 64u };
+
+         [[nodiscard]] auto descriptor_set_layout() const -> vk::raii::DescriptorSetLayout;
+         [[nodiscard]] auto pipeline_layout() const -> vk::raii::PipelineLayout;
+         [[nodiscard]] auto pipeline() const -> vk::raii::Pipeline;
+         [[nodiscard]] auto frame_buffers() const -> std::vector<FrameBuffers>;
+
+         Context const& context_{ Locator::get<Context>() };
+
+         vk::raii::DescriptorSetLayout const descriptor_set_layout_{ descriptor_set_layout() };
+         vk::raii::PipelineLayout const pipeline_layout_{ pipeline_layout() };
+         vk::raii::Pipeline const pipeline_{ pipeline() };
+         std::vector<FrameBuffers> const frame_buffers_{ frame_buffers() };
+   };
+}
+
+#endif
\ No newline at end of file
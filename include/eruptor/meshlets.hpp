@@ -0,0 +1,66 @@
+#ifndef MESHLETS_HPP
+#define MESHLETS_HPP
+
+#include "eruptor/api.hpp"
+#include "eruptor/pch.hpp"
+#include "eruptor/vertex.hpp"
+
+namespace eru
+{
+   // splits a mesh into small clusters of triangles, each with the bounds needed to cull it on its own; triangles are
+   // taken in strip order and a cluster is closed as soon as the next triangle no longer fits, which keeps clusters
+   // spatially coherent as long as the strip is
+   class Meshlets final
+   {
+      public:
+         // matches `Meshlet` in culling.slang and renderer.slang; in the mesh's own space
+         struct Meshlet final
+         {
+            glm::vec4 bounding_sphere;
+            // every triangle faces away from whoever sees the cluster's bounding sphere from within the cone around the
+            // axis whose half angle's sine is the cutoff, which is 1 when the triangles are too spread out to ever do so
+            glm::vec3 cone_axis;
+            float cone_cutoff;
+            std::uint32_t first_vertex;
+            std::uint32_t first_triangle;
+            std::uint32_t vertex_count;
+            std::uint32_t triangle_count;
+         };
+
+         // what mesh shader implementations are commonly tuned for; 124 rather than 128 triangles leaves room for the
+         // primitive indices to fit in a multiple of 128 bytes
+         static auto constexpr MAX_VERTICES{ 64u };
+         static auto constexpr MAX_TRIANGLES{ 124u };
+
+         // triangles are expected to wind counter-clockwise when seen from the front, as in the strip's first triangle
+         ERU_API Meshlets(std::span<Vertex const> vertices, std::span<std::uint16_t const> strip_indices);
+         Meshlets(Meshlets const&) = default;
+         Meshlets(Meshlets&&) = default;
+
+         ~Meshlets() = default;
+
+         auto operator=(Meshlets const&) -> Meshlets& = default;
+         auto operator=(Meshlets&&) -> Meshlets& = default;
+
+         [[nodiscard]] ERU_API auto meshlets() const -> std::span<Meshlet const>;
+
+         // for every meshlet vertex, the mesh vertex it stands for
+         [[nodiscard]] ERU_API auto vertices() const -> std::span<std::uint32_t const>;
+
+         // for every meshlet triangle, its three meshlet vertices, packed in the lowest three bytes
+         [[nodiscard]] ERU_API auto triangles() const -> std::span<std::uint32_t const>;
+
+         // for every meshlet triangle, its three mesh vertices, so that meshlets can also be drawn as indexed triangle lists
+         [[nodiscard]] ERU_API auto indices() const -> std::span<std::uint16_t const>;
+
+      private:
+         auto close(Meshlet meshlet, std::span<Vertex const> vertices, std::vector<std::uint32_t>& local_vertices) -> void;
+
+         std::vector<Meshlet> meshlets_{};
+         std::vector<std::uint32_t> vertices_{};
+         std::vector<std::uint32_t> triangles_{};
+         std::vector<std::uint16_t> indices_{};
+   };
+}
+
+#endif
\ No newline at end of file
@@ -2,10 +2,13 @@
 #define PCH_HPP
 
 #include <array>
+#include <atomic>
+#include <bit>
 #include <bitset>
 #include <chrono>
 #include <concepts>
 #include <condition_variable>
+#include <deque>
 #include <filesystem>
 #include <fstream>
 #include <functional>
@@ -22,10 +25,13 @@
 #include <tuple>
 #include <typeindex>
 #include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <glm/glm.hpp>
+#include <glm/gtc/matrix_access.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
 #include <vulkan/vulkan_raii.hpp>
 
 #endif
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "eruptor/api.hpp"
 #include "eruptor/pass_key.hpp"
+#include "eruptor/pch.hpp"
 
 namespace eru
 {
@@ -21,6 +22,18 @@ namespace eru
          auto operator=(Platform&&) -> Platform& = delete;
 
          ERU_API auto poll() const -> void;
+         // blocks, handling events as they come in, until a redraw is due, and takes it; input to or a change of any
+         // window requests one, as does `request_redraw`
+         ERU_API auto wait() -> void;
+
+         // wakes up `wait`, either right away or once the delay has passed, as for animations; requests for later
+         // redraws only shorten the wait. Safe to call from any thread
+         ERU_API auto request_redraw(std::chrono::steady_clock::duration delay = {}) -> void;
+
+      private:
+         std::mutex mutex_{};
+         // the first frame is always due
+         std::optional<std::chrono::steady_clock::time_point> redraw_time_{ std::chrono::steady_clock::now() };
    };
 }
 
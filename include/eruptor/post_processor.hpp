@@ -0,0 +1,146 @@
+#ifndef POST_PROCESSOR_HPP
+#define POST_PROCESSOR_HPP
+
+#include "eruptor/api.hpp"
+#include "eruptor/locator.hpp"
+#include "eruptor/pch.hpp"
+#include "eruptor/unique_pointer.hpp"
+
+namespace eru
+{
+   class Context;
+
+   // turns a high dynamic range image into a displayable one; every effect that only looks at its own pixel is fused
+   // into a single dispatch, so that the image is read and written once, and only bloom, which needs a neighborhood at
+   // several scales, gets passes of its own, each over a smaller image than the last
+   class PostProcessor final
+   {
+      public:
+         struct BloomSettings final
+         {
+            // brightness above which pixels bloom, faded in over the knee below it
+            float threshold{ 1.0f };
+            float knee{ 0.5f };
+            float intensity{ 0.05f };
+         };
+
+         struct Settings final
+         {
+            float exposure{ 1.0f };
+            // grading happens before tonemapping, on the exposed scene; contrast is around middle grey
+            glm::vec3 tint{ 1.0f };
+            float saturation{ 1.0f };
+            float contrast{ 1.0f };
+            // darkening at the corners, growing with the distance to the center raised to the falloff
+            float vignette_intensity{ 0.25f };
+            float vignette_falloff{ 2.0f };
+            // breaks up banding in smooth gradients, at the cost of a little noise
+            bool dithering{ true };
+            std::optional<BloomSettings> bloom{};
+         };
+
+         // what the scene is to be rendered in
+         static auto constexpr SOURCE_FORMAT{ vk::Format::eR16G16B16A16Sfloat };
+         // sRGB encoded; written through a linear view, as sRGB images cannot be stored to
+         static auto constexpr OUTPUT_FORMAT{ vk::Format::eR8G8B8A8Srgb };
+
+         ERU_API explicit PostProcessor(Settings const& settings);
+         PostProcessor(PostProcessor const&) = delete;
+         PostProcessor(PostProcessor&&) = delete;
+
+         ~PostProcessor() = default;
+
+         auto operator=(PostProcessor const&) -> PostProcessor& = delete;
+         auto operator=(PostProcessor&&) -> PostProcessor& = delete;
+
+         // the output matches the source's extent; the previous images are handed back, if there were any, to be kept
+         // until the device no longer uses them
+         [[nodiscard]] ERU_API auto resize(vk::Extent2D extent) -> UniquePointer<void>;
+
+         // the source is read in `eShaderReadOnlyOptimal` by compute shaders; the output is left in
+         // `eShaderReadOnlyOptimal`, for fragment shaders to read
+         ERU_API auto record(vk::raii::CommandBuffer const& command_buffer, vk::ImageView source) const -> void;
+
+         ERU_API auto change_settings(Settings const& settings) -> void;
+         [[nodiscard]] ERU_API auto settings() const -> Settings const&;
+
+         [[nodiscard]] ERU_API auto image() const -> vk::Image;
+         // in `OUTPUT_FORMAT`, so reads are decoded back to linear
+         [[nodiscard]] ERU_API auto image_view() const -> vk::ImageView;
+         [[nodiscard]] ERU_API auto extent() const -> vk::Extent2D;
+
+      private:
+         enum class Stage
+         {
+            BLOOM_PREFILTER,
+            BLOOM_DOWNSAMPLE,
+            BLOOM_UPSAMPLE,
+            FUSE
+         };
+
+         // matches `PostConstants` in post_processing.slang; shared by every stage, each reading what it needs
+         struct PostConstants final
+         {
+            glm::uvec2 source_size;
+            glm::uvec2 destination_size;
+            float exposure;
+            float saturation;
+            float contrast;
+            float vignette_intensity;
+            glm::vec3 tint;
+            float vignette_falloff;
+            float bloom_threshold;
+            float bloom_knee;
+            float bloom_intensity;
+            std::uint32_t dithering;
+         };
+
+         // the output's format as far as compute shaders are concerned, which encode to sRGB themselves
+         static auto constexpr STORAGE_FORMAT{ vk::Format::eR8G8B8A8Unorm };
+         static auto constexpr BLOOM_FORMAT{ vk::Format::eR16G16B16A16Sfloat };
+         // the first is at half the output's resolution, every next one at half the one before
+         static auto constexpr MAX_BLOOM_LEVELS{ 6u };
+         static auto constexpr WORKGROUP_SIZE{ 8u };
+
+         // the bloom image is only read by the fused stage
+         auto record_stage(vk::raii::CommandBuffer const& command_buffer, Stage stage, vk::DescriptorImageInfo const& source,
+            vk::Extent2D source_extent, vk::ImageView destination, vk::Extent2D destination_extent,
+            vk::DescriptorImageInfo const& bloom) const -> void;
+         [[nodiscard]] auto bloom_extent(std::uint32_t level) const -> vk::Extent2D;
+
+         [[nodiscard]] auto sampler() const -> vk::raii::Sampler;
+         [[nodiscard]] auto descriptor_set_layout() const -> vk::raii::DescriptorSetLayout;
+         [[nodiscard]] auto pipeline_layout() const -> vk::raii::PipelineLayout;
+         [[nodiscard]] auto shader_code() const -> std::vector<std::uint32_t>;
+         [[nodiscard]] auto pipeline(Stage stage) const -> vk::raii::Pipeline;
+         [[nodiscard]] auto image(vk::Format format, vk::Extent2D extent, std::uint32_t level_count,
+            vk::ImageCreateFlags flags) const -> vk::raii::Image;
+         [[nodiscard]] auto image_memory(vk::raii::Image const& image) const -> vk::raii::DeviceMemory;
+         [[nodiscard]] auto image_view(vk::raii::Image const& image, vk::Format format,
+            std::uint32_t level) const -> vk::raii::ImageView;
+
+         Context const& context_{ Locator::get<Context>() };
+
+         Settings settings_;
+         std::vector<std::uint32_t> const shader_code_{ shader_code() };
+         vk::raii::Sampler const sampler_{ sampler() };
+         vk::raii::DescriptorSetLayout const descriptor_set_layout_{ descriptor_set_layout() };
+         vk::raii::PipelineLayout const pipeline_layout_{ pipeline_layout() };
+         vk::raii::Pipeline const bloom_prefilter_pipeline_{ pipeline(Stage::BLOOM_PREFILTER) };
+         vk::raii::Pipeline const bloom_downsample_pipeline_{ pipeline(Stage::BLOOM_DOWNSAMPLE) };
+         vk::raii::Pipeline const bloom_upsample_pipeline_{ pipeline(Stage::BLOOM_UPSAMPLE) };
+         vk::raii::Pipeline const fuse_pipeline_{ pipeline(Stage::FUSE) };
+         vk::Extent2D extent_{};
+         vk::raii::Image image_{ nullptr };
+         vk::raii::DeviceMemory image_memory_{ nullptr };
+         vk::raii::ImageView image_view_{ nullptr };
+         vk::raii::ImageView storage_image_view_{ nullptr };
+         // kept whether bloom is on or not, so that turning it on does not have to wait for the device
+         std::uint32_t bloom_level_count_{};
+         vk::raii::Image bloom_image_{ nullptr };
+         vk::raii::DeviceMemory bloom_image_memory_{ nullptr };
+         std::vector<vk::raii::ImageView> bloom_level_image_views_{};
+   };
+}
+
+#endif
\ No newline at end of file
@@ -2,8 +2,21 @@
 #define RENDERER_HPP
 
 #include "eruptor/api.hpp"
+#include "eruptor/constants.hpp"
+#include "eruptor/debug_draw.hpp"
+#include "eruptor/depth_pyramid.hpp"
+#include "eruptor/frustum.hpp"
+#include "eruptor/geometry_pool.hpp"
+#include "eruptor/instance.hpp"
 #include "eruptor/layout.hpp"
+#include "eruptor/light_clusters.hpp"
+#include "eruptor/meshlets.hpp"
 #include "eruptor/pch.hpp"
+#include "eruptor/post_processor.hpp"
+#include "eruptor/resolution_controller.hpp"
+#include "eruptor/skinner.hpp"
+#include "eruptor/thread_pool.hpp"
+#include "eruptor/upscaler.hpp"
 #include "eruptor/vertex.hpp"
 #include "eruptor/window.hpp"
 
@@ -13,14 +26,83 @@ namespace eru
 {
    struct UniformBufferObject final
    {
-      glm::mat4 model;
       glm::mat4 view;
       glm::mat4 projection;
+      // for the task shader to cull meshlets with
+      std::array<glm::vec4, 6> frustum_planes;
+      glm::vec4 camera_position;
    };
 
    class Renderer final
    {
       public:
+         enum class DepthMode
+         {
+            DIRECT,
+            PRE_PASS
+         };
+
+         struct Description final
+         {
+            vk::Format color_format{ vk::Format::eB8G8R8A8Srgb };
+            vk::Format depth_format{ vk::Format::eD32Sfloat };
+            DepthMode depth_mode{ DepthMode::DIRECT };
+            // without mesh shaders, vertices are fetched by the input assembler from a vertex buffer bound per mesh,
+            // unless this is set, in which case the vertex shader pulls them from a storage buffer itself, the layout
+            // given per draw; with mesh shaders, they always are pulled
+            bool vertex_pulling{ false };
+            // without it, the scene is rendered straight into the target, at the target's resolution
+            std::optional<ResolutionController::Settings> dynamic_resolution{};
+            // without it, the scene is rendered in the color format and shown as is; with it, in a high dynamic range
+            // format, then post-processed into the color format; it can be tuned later on, but not turned on or off
+            std::optional<PostProcessor::Settings> post_processing{};
+         };
+
+         struct Timings final
+         {
+            std::chrono::duration<double, std::milli> light_clustering{};
+            std::chrono::duration<double, std::milli> culling{};
+            std::chrono::duration<double, std::milli> depth_pyramid{};
+            std::chrono::duration<double, std::milli> depth_pre_pass{};
+            std::chrono::duration<double, std::milli> main_pass{};
+            std::chrono::duration<double, std::milli> post_processing{};
+            std::chrono::duration<double, std::milli> upscaling{};
+            // from the start of the first pass to the end of the last one
+            std::chrono::duration<double, std::milli> frame{};
+            std::chrono::duration<double, std::milli> recording{};
+         };
+
+         // binds are counted over the whole draw list, before it is split into chunks; avoided ones are those sorting saved
+         // over drawing in submission order
+         struct Statistics final
+         {
+            std::size_t draws{};
+            std::size_t instanced_draws{};
+            std::size_t material_binds{};
+            std::size_t mesh_binds{};
+            std::size_t avoided_material_binds{};
+            std::size_t avoided_mesh_binds{};
+         };
+
+         // instances as counted by the culling passes, static segments included; matches `VisibilityCounters` in culling.slang
+         struct VisibilityCounters final
+         {
+            std::uint32_t frustum_culled{};
+            std::uint32_t occlusion_culled{};
+            std::uint32_t early_drawn{};
+            std::uint32_t late_drawn{};
+         };
+
+         // `id` also keys the draw's visibility from one frame to the next, so it should stay the same for as long as the
+         // draw does, and ids should be kept small, as visibility is stored for every id up to the largest one
+         struct Draw final
+         {
+            glm::mat4 transform;
+            std::uint32_t mesh;
+            std::uint32_t material;
+            std::uint32_t id;
+         };
+
          struct FrameData final
          {
             vk::raii::CommandBuffer const& command_buffer;
@@ -36,7 +118,7 @@ namespace eru
             vk::Format format;
          };
 
-         ERU_API explicit Renderer();
+         ERU_API explicit Renderer(Description const& description);
          Renderer(Renderer const&) = delete;
          Renderer(Renderer&&) noexcept = delete;
 
@@ -45,74 +127,496 @@ namespace eru
          auto operator=(Renderer const&) -> Renderer& = delete;
          auto operator=(Renderer&&) -> Renderer& = delete;
 
+         // meshes are given as triangle strips, and split into meshlets that are culled and drawn one by one; the stream
+         // layout only matters to the input assembler, so meshes are always interleaved when vertices are pulled; either
+         // way, vertices are stored packed
+         [[nodiscard]] ERU_API auto create_mesh(std::span<Vertex const> vertices, std::span<std::uint16_t const> indices,
+            Vertex::StreamLayout stream_layout = Vertex::StreamLayout::INTERLEAVED) -> std::uint32_t;
+         // drawn with the positions of an instance of the renderer's skinner, one vertex of the instance per vertex given;
+         // these give the rest, and the bind pose the mesh is split into meshlets and culled by, so poses should not reach
+         // far past it
+         [[nodiscard]] ERU_API auto create_skinned_mesh(std::uint32_t skinned_instance, std::span<Vertex const> vertices,
+            std::span<std::uint16_t const> indices) -> std::uint32_t;
+         [[nodiscard]] ERU_API auto create_material(std::string_view texture_path) -> std::uint32_t;
+
+         // queues a draw for the next call to `record`; draws sharing a mesh and material are drawn as one instanced draw
+         ERU_API auto draw(Draw const& draw) -> void;
+
+         // queues a light for the next call to `record`, which clusters every queued light before shading with them
+         ERU_API auto light(LightClusters::Light const& light) -> void;
+
+         // static draws are recorded once and replayed every frame until they, or what they were recorded against, change
+         [[nodiscard]] ERU_API auto create_static_segment(std::vector<Draw> draws) -> std::uint32_t;
+         ERU_API auto change_static_segment(std::uint32_t segment, std::vector<Draw> draws) -> void;
+         ERU_API auto destroy_static_segment(std::uint32_t segment) -> void;
+
          ERU_API auto record(FrameData frame_data, Target const& target) -> void;
 
+         ERU_API auto change_depth_mode(DepthMode depth_mode) -> void;
+         [[nodiscard]] ERU_API auto depth_mode() const -> DepthMode;
+
+         // with dynamic resolution, the scene is rendered offscreen at a scale picked from the GPU time of past frames,
+         // then upscaled onto the target
+         ERU_API auto change_dynamic_resolution(std::optional<ResolutionController::Settings> const& settings) -> void;
+         [[nodiscard]] ERU_API auto dynamic_resolution() const -> std::optional<ResolutionController::Settings>;
+
+         // only with post-processing enabled in the description
+         ERU_API auto change_post_processing(PostProcessor::Settings const& settings) -> void;
+         [[nodiscard]] ERU_API auto post_processing() const -> std::optional<PostProcessor::Settings>;
+
+         // lines queued to it from any thread are drawn over the scene by the next call to `record`, before
+         // post-processing and upscaling
+         [[nodiscard]] ERU_API auto debug_draw() -> DebugDraw&;
+
+         // instances posed on it are skinned at the start of the next call to `record`, before anything is culled or
+         // drawn, and every pass draws their skinned meshes from that
+         [[nodiscard]] ERU_API auto skinner() -> Skinner&;
+
+         // of the next recorded frame; 1 without dynamic resolution
+         [[nodiscard]] ERU_API auto resolution_scale() const -> float;
+
+         // GPU timings of the last completed frame that used the frame index being recorded, CPU timings of the latest one
+         [[nodiscard]] ERU_API auto timings() const -> Timings const&;
+
+         // of the latest recorded frame, static segments included
+         [[nodiscard]] ERU_API auto statistics() const -> Statistics const&;
+
+         // of the last completed frame that used the frame index being recorded
+         [[nodiscard]] ERU_API auto visibility_counters() const -> VisibilityCounters const&;
+
       private:
+         enum class Pass
+         {
+            DEPTH_PRE_PASS,
+            MAIN
+         };
+
+         // the early phase draws what was visible last frame, the late phase what turns out visible against the depth
+         // pyramid of the early phase
+         enum class Phase
+         {
+            EARLY,
+            LATE
+         };
+
+         // per-thread, per-frame command pool; reset as a whole at the start of its frame
+         struct RecordingPool final
+         {
+            vk::raii::CommandPool command_pool;
+            std::deque<vk::raii::CommandBuffer> command_buffers{};
+            std::size_t used_command_buffers{};
+         };
+
+         struct MeshBuffer final
+         {
+            vk::raii::Buffer buffer{ nullptr };
+            vk::raii::DeviceMemory memory{ nullptr };
+         };
+
+         // without mesh shaders, meshlets are drawn from the index range, which lists their triangles one after the
+         // other; with them, from the meshlet vertex and triangle buffers, which are left empty otherwise; split meshes
+         // hold only positions in the vertex range, the rest in the attribute range, which is left empty otherwise.
+         // Ranges are in the geometry pool; interleaved vertices are aligned to whole vertices, so that every
+         // interleaved mesh is drawn from the pool's vertex buffer bound once, its first vertex being the base vertex,
+         // while split meshes bind their own ranges and have a base vertex of 0. Skinned meshes are split, with an empty
+         // vertex range, as their positions are those of the skinner instance
+         struct Mesh final
+         {
+            GeometryPool::Range vertices;
+            GeometryPool::Range attributes;
+            Vertex::StreamLayout stream_layout;
+            GeometryPool::Range indices;
+            std::int32_t base_vertex;
+            std::uint32_t first_index;
+            MeshBuffer meshlet_vertices;
+            MeshBuffer meshlet_triangles;
+            std::uint32_t first_meshlet;
+            std::uint32_t meshlet_count;
+            glm::vec4 bounding_sphere;
+            std::optional<std::uint32_t> skinned_instance;
+         };
+
+         // where a mesh's positions and other attributes are read from, offsets and strides being in bytes
+         struct VertexStreams final
+         {
+            vk::Buffer position_buffer;
+            vk::DeviceSize position_offset;
+            vk::DeviceSize position_stride;
+            vk::Buffer attribute_buffer;
+            vk::DeviceSize attribute_offset;
+            vk::DeviceSize attribute_stride;
+         };
+
+         // a copy into a device local buffer, through a staging buffer
+         struct Upload final
+         {
+            vk::Buffer buffer;
+            vk::DeviceSize offset;
+            std::span<std::byte const> data;
+         };
+
+         struct Material final
+         {
+            vk::raii::Image image;
+            vk::raii::DeviceMemory image_memory;
+            vk::raii::ImageView image_view;
+            vk::raii::DescriptorSet descriptor_set;
+         };
+
+         struct StagingBuffer final
+         {
+            vk::raii::Buffer buffer;
+            vk::raii::DeviceMemory memory;
+         };
+
+         // persistently mapped; only grows, and only once the frame that last read it has completed
+         template<typename Element>
+         struct MappedBuffer final
+         {
+            vk::raii::Buffer buffer{ nullptr };
+            vk::raii::DeviceMemory memory{ nullptr };
+            Element* elements{};
+            std::size_t capacity{};
+         };
+
+         // only written by the device; grows under the same rules as a mapped buffer
+         template<typename Element>
+         struct DeviceBuffer final
+         {
+            vk::raii::Buffer buffer{ nullptr };
+            vk::raii::DeviceMemory memory{ nullptr };
+            std::size_t capacity{};
+         };
+
+         // matches `CullBatch` in culling.slang
+         struct CullBatch final
+         {
+            glm::vec4 bounding_sphere;
+            std::uint32_t first_instance;
+            std::uint32_t instance_count;
+            std::uint32_t first_meshlet;
+            std::uint32_t meshlet_count;
+            std::uint32_t first_command;
+            std::uint32_t first_index;
+            std::int32_t base_vertex;
+            std::uint32_t padding;
+         };
+
+         // matches `CullFrame` in culling.slang
+         struct CullFrame final
+         {
+            glm::mat4 view_projection;
+            std::array<glm::vec4, 6> frustum_planes;
+            glm::vec4 camera_position;
+            glm::uvec2 pyramid_size;
+            std::uint32_t pyramid_level_count;
+            std::uint32_t padding;
+         };
+
+         // matches `CullConstants` in culling.slang
+         struct CullConstants final
+         {
+            std::uint32_t batch_count;
+            std::uint32_t instance_count;
+            std::uint32_t instance_stride;
+            std::uint32_t command_count;
+            std::uint32_t mesh_shading;
+         };
+
+         // matches `DrawCount` in culling.slang; with mesh shaders, it is the batch's task dispatch in itself, one row of
+         // task workgroups per drawn instance
+         struct DrawCount final
+         {
+            std::uint32_t group_count_x;
+            std::uint32_t count;
+            std::uint32_t group_count_z;
+         };
+
+         // matches `VertexPulling` in renderer.slang; the mesh's vertex streams, as offsets and strides into their buffers
+         struct VertexPulling final
+         {
+            std::uint32_t position_offset;
+            std::uint32_t position_stride;
+            std::uint32_t attribute_offset;
+            std::uint32_t attribute_stride;
+         };
+
+         // matches `MeshletDraw` in meshlets.slang
+         struct MeshletDraw final
+         {
+            std::uint32_t first_command;
+            std::uint32_t first_meshlet;
+            std::uint32_t meshlet_count;
+            std::uint32_t instance_stride;
+            std::uint32_t position_offset;
+            std::uint32_t position_stride;
+            std::uint32_t attribute_offset;
+            std::uint32_t attribute_stride;
+         };
+
+         // shared by every draw list culled in one frame in flight
+         struct CullFrameBuffers final
+         {
+            MappedBuffer<CullFrame> frame;
+            MappedBuffer<VisibilityCounters> counters;
+         };
+
+         // everything a batched draw list needs on the device for one frame in flight; each culling phase fills in one
+         // indirect command per meshlet it draws, in its own command range of that meshlet's batch, the late phase's
+         // commands and draw counts following those of the early phase; with mesh shaders, there is one command per
+         // instance instead, of which only the first instance is used, and the meshlets are culled by the task shader
+         struct DrawListBuffers final
+         {
+            MappedBuffer<Instance> instances{};
+            MappedBuffer<CullBatch> batches{};
+            DeviceBuffer<vk::DrawIndexedIndirectCommand> commands{};
+            DeviceBuffer<DrawCount> draw_counts{};
+            std::uint32_t batch_count{};
+            std::uint32_t instance_count{};
+            std::uint32_t command_count{};
+         };
+
+         // whether each of a draw list's draws, by id, was visible at the end of the last frame that culled it; read and
+         // written by every frame in flight, one after the other
+         struct Visibility final
+         {
+            DeviceBuffer<std::uint32_t> flags{};
+            bool initialized{};
+         };
+
+         // a draw list as it is culled in one frame
+         struct CullList final
+         {
+            DrawListBuffers const& buffers;
+            Visibility& visibility;
+         };
+
+         // one instanced draw; its instances are contiguous in the instance buffer it was gathered into
+         struct Batch final
+         {
+            std::uint32_t mesh;
+            std::uint32_t material;
+            std::uint32_t first_instance;
+            std::uint32_t instance_count;
+            std::uint32_t first_command;
+            std::uint32_t command_count;
+         };
+
+         // everything recorded commands depend on besides the draws themselves and per-frame data
+         struct RecordingInputs final
+         {
+            vk::Pipeline depth_pre_pass_pipeline;
+            vk::Pipeline pipeline;
+            vk::Buffer meshlet_buffer;
+            vk::Buffer vertex_buffer;
+            vk::Buffer index_buffer;
+            vk::Format color_format;
+            vk::Extent2D extent;
+            DepthMode depth_mode;
+
+            [[nodiscard]] auto operator==(RecordingInputs const&) const -> bool = default;
+         };
+
+         // command buffers are kept per frame in flight, as each one binds that frame's uniform buffer, and per phase
+         struct StaticSegment final
+         {
+            std::vector<Draw> draws;
+            vk::raii::CommandPool command_pool;
+            std::vector<vk::raii::CommandBuffer> depth_pre_pass_command_buffers;
+            std::vector<vk::raii::CommandBuffer> main_command_buffers;
+            std::array<DrawListBuffers, MAX_FRAMES_IN_FLIGHT> buffers{};
+            Visibility visibility{};
+            Statistics statistics{};
+            std::array<std::optional<RecordingInputs>, MAX_FRAMES_IN_FLIGHT> recorded_inputs{};
+         };
+
+         // render targets replaced while frames in flight may still be using them; released once as many frames as can
+         // be in flight have been recorded since, as a frame is only recorded once the last one at its index completed
+         struct RetiredResources final
+         {
+            UniquePointer<void> resources;
+            std::size_t remaining_frames;
+         };
+
+         static auto constexpr PHASE_COUNT{ 2uz };
+
+         // beginning and end of the light clustering, the early culling, the early rendering, the depth pyramid, the late
+         // culling, the late rendering, the shading, the post-processing and the upscaling, in that order; rendering is the
+         // depth pre-pass when there is one, the main pass otherwise
+         static auto constexpr TIMESTAMPS_PER_FRAME{ 18u };
+
+         static auto constexpr NEAR_PLANE{ 0.1f };
+         static auto constexpr FAR_PLANE{ 10.0f };
+
+         // below this, splitting the batches costs more than recording them on a single thread
+         static auto constexpr MINIMUM_BATCHES_PER_CHUNK{ 256uz };
+
+         static auto constexpr MINIMUM_BUFFER_CAPACITY{ 64uz };
+         static auto constexpr CULLING_WORKGROUP_SIZE{ 64u };
+         // meshlets culled by each task workgroup; matches `MESHLETS_PER_TASK` in meshlets.slang
+         static auto constexpr MESHLETS_PER_TASK{ 32u };
+
+         // every material takes one set out of the descriptor pool
+         static auto constexpr MAX_MATERIALS{ 256u };
+
+         auto read_timings(std::uint8_t frame_index) -> void;
+         auto read_visibility_counters(std::uint8_t frame_index) -> void;
+         auto prepare_depth_image(vk::Extent2D extent) -> void;
+         auto prepare_color_image(vk::Extent2D extent) -> void;
+         auto retire(UniquePointer<void> resources) -> void;
+         auto release_retired_resources() -> void;
+         [[nodiscard]] auto scene_format() const -> vk::Format;
+         [[nodiscard]] auto scene_target(Target const& target) -> Target;
+         auto reset_recording_pools(std::uint8_t frame_index) -> void;
+         [[nodiscard]] auto secondary_command_buffer(std::uint8_t frame_index, std::size_t thread_index) -> vk::raii::CommandBuffer const&;
+         [[nodiscard]] auto batch(std::span<Draw const> draws, glm::mat4 const& view, DrawListBuffers& buffers,
+            Statistics& statistics) const -> std::vector<Batch>;
+         template<typename Element>
+         auto reserve(MappedBuffer<Element>& buffer, std::size_t count, vk::BufferUsageFlags usage) const -> void;
+         template<typename Element>
+         auto reserve(DeviceBuffer<Element>& buffer, std::size_t count, vk::BufferUsageFlags usage) const -> void;
+         auto reserve_visibility(Visibility& visibility, std::span<Draw const> draws) -> void;
+         auto record_culling(vk::raii::CommandBuffer const& command_buffer, Phase phase, std::span<CullList const> cull_lists,
+            std::uint8_t frame_index) const -> void;
+         auto record_depth_pyramid(vk::raii::CommandBuffer const& command_buffer) const -> void;
+         [[nodiscard]] auto record_debug_draw(std::uint8_t frame_index, glm::mat4 const& view_projection,
+            vk::Extent2D extent) -> vk::CommandBuffer;
+         auto record_post_processing(vk::raii::CommandBuffer const& command_buffer, Target const& scene_target) const -> void;
+         auto record_upscaling(vk::raii::CommandBuffer const& command_buffer, Target const& source,
+            Target const& target) const -> void;
+         auto record_rendering(vk::raii::CommandBuffer const& command_buffer, Pass pass, Target const& target,
+            vk::AttachmentLoadOp color_load_op, vk::AttachmentLoadOp depth_load_op, vk::AttachmentStoreOp depth_store_op,
+            std::span<vk::CommandBuffer const> command_buffers) const -> void;
+         auto record_chunk(vk::raii::CommandBuffer const& command_buffer, vk::CommandBufferUsageFlags usage, Pass pass,
+            Phase phase, std::uint8_t frame_index, std::span<Batch const> batches, std::size_t first_batch,
+            DrawListBuffers const& buffers, vk::Extent2D extent) const -> void;
+         auto push_meshlet_descriptors(vk::raii::CommandBuffer const& command_buffer, DrawListBuffers const& buffers,
+            Mesh const& mesh) const -> void;
+         auto push_vertex_descriptors(vk::raii::CommandBuffer const& command_buffer, Mesh const& mesh) const -> void;
+         auto bind_vertex_streams(vk::raii::CommandBuffer const& command_buffer, Pass pass, Mesh const& mesh) const -> void;
+         [[nodiscard]] auto vertex_streams(Mesh const& mesh) const -> VertexStreams;
+         auto add_mesh(std::span<Vertex const> vertices, std::span<std::uint16_t const> indices,
+            Vertex::StreamLayout stream_layout, std::optional<std::uint32_t> skinned_instance) -> std::uint32_t;
+         [[nodiscard]] auto vertex_pulling() const -> bool;
+         auto update_static_segments(std::uint8_t frame_index, RecordingInputs const& inputs, glm::mat4 const& view) -> void;
+         [[nodiscard]] auto recording_inputs(Target const& target) const -> RecordingInputs;
+
+         [[nodiscard]] auto static_segment(std::vector<Draw> draws) const -> StaticSegment;
+
+         [[nodiscard]] auto recording_pools() const -> std::vector<RecordingPool>;
+
          [[nodiscard]] auto uniform_buffer_descriptor_set_layout() const -> vk::raii::DescriptorSetLayout;
-         [[nodiscard]] auto sampler_descriptor_set_layout() const -> vk::raii::DescriptorSetLayout;
+         [[nodiscard]] auto material_descriptor_set_layout() const -> vk::raii::DescriptorSetLayout;
+         [[nodiscard]] auto meshlet_descriptor_set_layout() const -> vk::raii::DescriptorSetLayout;
+         [[nodiscard]] auto vertex_descriptor_set_layout() const -> vk::raii::DescriptorSetLayout;
          [[nodiscard]] auto descriptor_pool() const -> vk::raii::DescriptorPool;
          [[nodiscard]] auto uniform_buffer_descriptor_sets() const -> std::vector<vk::raii::DescriptorSet>;
-         [[nodiscard]] auto sampler_descriptor_set() const -> vk::raii::DescriptorSet;
+         [[nodiscard]] auto material_descriptor_set() const -> vk::raii::DescriptorSet;
 
          [[nodiscard]] auto pipeline_layout() const -> vk::raii::PipelineLayout;
+         [[nodiscard]] auto shader_code() const -> std::vector<std::uint32_t>;
+         [[nodiscard]] auto meshlet_shader_code() const -> std::vector<std::uint32_t>;
          [[nodiscard]] auto pipeline() const -> vk::raii::Pipeline;
+         [[nodiscard]] auto depth_pre_pass_pipeline() const -> vk::raii::Pipeline;
 
-         [[nodiscard]] auto vertex_buffer() const -> vk::raii::Buffer;
-         [[nodiscard]] auto vertex_buffer_memory() const -> vk::raii::DeviceMemory;
+         [[nodiscard]] auto cull_descriptor_set_layout() const -> vk::raii::DescriptorSetLayout;
+         [[nodiscard]] auto cull_pipeline_layout() const -> vk::raii::PipelineLayout;
+         [[nodiscard]] auto cull_shader_code() const -> std::vector<std::uint32_t>;
+         [[nodiscard]] auto cull_pipeline(Phase phase) const -> vk::raii::Pipeline;
+         [[nodiscard]] auto cull_frame_buffers() const -> std::vector<CullFrameBuffers>;
 
-         [[nodiscard]] auto index_buffer() const -> vk::raii::Buffer;
-         [[nodiscard]] auto index_buffer_memory() const -> vk::raii::DeviceMemory;
+         [[nodiscard]] auto staging_buffer(std::span<std::byte const> data) const -> StagingBuffer;
+         [[nodiscard]] auto mesh_buffer(std::size_t size, vk::BufferUsageFlags usage) const -> MeshBuffer;
+         template<typename Element>
+         [[nodiscard]] auto mapped_buffer(std::size_t capacity, vk::BufferUsageFlags usage) const -> MappedBuffer<Element>;
+         template<typename Element>
+         [[nodiscard]] auto device_buffer(std::size_t capacity, vk::BufferUsageFlags usage) const -> DeviceBuffer<Element>;
 
          [[nodiscard]] auto uniform_buffers() const -> std::vector<vk::raii::Buffer>;
          [[nodiscard]] auto uniform_buffer_memories() const -> std::vector<vk::raii::DeviceMemory>;
 
          [[nodiscard]] auto texture(std::string_view path) const -> UniquePointer<ktxTexture2>;
-         [[nodiscard]] auto image() const -> vk::raii::Image;
-         [[nodiscard]] auto image_memory() const -> vk::raii::DeviceMemory;
-         [[nodiscard]] auto image_view() const -> vk::raii::ImageView;
+         [[nodiscard]] auto image(ktxTexture2 const& texture) const -> vk::raii::Image;
+         [[nodiscard]] auto image_memory(vk::raii::Image const& image) const -> vk::raii::DeviceMemory;
+         [[nodiscard]] auto image_view(vk::raii::Image const& image, vk::Format format) const -> vk::raii::ImageView;
 
          [[nodiscard]] auto sampler() const -> vk::raii::Sampler;
 
-         [[nodiscard]] auto depth_image() const -> vk::raii::Image;
+         [[nodiscard]] auto depth_image(vk::Extent2D extent) const -> vk::raii::Image;
          [[nodiscard]] auto depth_image_view() const -> vk::raii::ImageView;
          [[nodiscard]] auto depth_image_memory() const -> vk::raii::DeviceMemory;
 
-         std::vector<Vertex> const vertices_{
-            { .position = { -0.5f, -0.5f, -0.2f }, .color = { 1.0f, 0.0f, 0.0f }, .texture_coordinate = { 1.0f, 0.0f } },
-            { .position = { 0.5f, -0.5f, -0.2 }, .color = { 0.0f, 1.0f, 0.0f }, .texture_coordinate = { 0.0f, 0.0f } },
-            { .position = { 0.5f, 0.5f, 0.2f }, .color = { 0.0f, 0.0f, 1.0f }, .texture_coordinate = { 0.0f, 1.0f } },
-            { .position = { -0.5f, 0.5f, 0.2f }, .color = { 1.0f, 1.0f, 1.0f }, .texture_coordinate = { 1.0f, 1.0f } },
-            { .position = { -0.5f, -0.5f, 0.0f }, .color = { 1.0f, 0.0f, 0.0f }, .texture_coordinate = { 1.0f, 0.0f } },
-            { .position = { 0.5f, -0.5f, 0.0f }, .color = { 0.0f, 1.0f, 0.0f }, .texture_coordinate = { 0.0f, 0.0f } },
-            { .position = { 0.5f, 0.5f, 0.0f }, .color = { 0.0f, 0.0f, 1.0f }, .texture_coordinate = { 0.0f, 1.0f } },
-            { .position = { -0.5f, 0.5f, 0.0f }, .color = { 1.0f, 1.0f, 1.0f }, .texture_coordinate = { 1.0f, 1.0f } }
-         };
-         std::vector<uint16_t> const indices_{ 0, 1, 3, 2, 4, 5, 7, 6 };
+         [[nodiscard]] auto color_image(vk::Extent2D extent) const -> vk::raii::Image;
+         [[nodiscard]] auto color_image_view() const -> vk::raii::ImageView;
+         [[nodiscard]] auto color_image_memory() const -> vk::raii::DeviceMemory;
+
+         [[nodiscard]] auto timestamp_query_pool() const -> vk::raii::QueryPool;
 
          Context const& context_{ Locator::get<Context>() };
+         ThreadPool& thread_pool_{ Locator::get<ThreadPool>() };
+
+         Description const description_;
+         DepthMode depth_mode_{ description_.depth_mode };
+         std::optional<ResolutionController> resolution_controller_{ description_.dynamic_resolution };
 
-         vk::raii::Image depth_image_{ depth_image() };
-         vk::raii::DeviceMemory depth_image_memory_{ depth_image_memory() };
+         vk::Extent2D depth_image_extent_{};
+         vk::raii::Image depth_image_{ nullptr };
+         vk::raii::DeviceMemory depth_image_memory_{ nullptr };
          vk::raii::ImageView depth_image_view_{ nullptr };
+         // what the scene is rendered into with dynamic resolution or post-processing, before either is applied
+         vk::Extent2D color_image_extent_{};
+         vk::raii::Image color_image_{ nullptr };
+         vk::raii::DeviceMemory color_image_memory_{ nullptr };
+         vk::raii::ImageView color_image_view_{ nullptr };
+         DepthPyramid depth_pyramid_{};
+         LightClusters light_clusters_{};
+         std::optional<PostProcessor> post_processor_{ description_.post_processing };
+         DebugDraw debug_draw_{ scene_format(), description_.depth_format };
+         Skinner skinner_{};
+         // also copies the post-processed image onto the target when it is not to be scaled, which it then does exactly
+         Upscaler const upscaler_{ description_.color_format };
          vk::raii::DescriptorSetLayout const uniform_buffer_descriptor_set_layout_{ uniform_buffer_descriptor_set_layout() };
-         vk::raii::DescriptorSetLayout const sampler_descriptor_set_layout_{ sampler_descriptor_set_layout() };
+         vk::raii::DescriptorSetLayout const material_descriptor_set_layout_{ material_descriptor_set_layout() };
+         vk::raii::DescriptorSetLayout const meshlet_descriptor_set_layout_{ meshlet_descriptor_set_layout() };
+         vk::raii::DescriptorSetLayout const vertex_descriptor_set_layout_{ vertex_descriptor_set_layout() };
          vk::raii::PipelineLayout const pipeline_layout_{ pipeline_layout() };
+         std::vector<std::uint32_t> const shader_code_{ shader_code() };
+         std::vector<std::uint32_t> const meshlet_shader_code_{ meshlet_shader_code() };
          vk::raii::Pipeline const pipeline_{ pipeline() };
-         vk::raii::Buffer const vertex_buffer_{ vertex_buffer() };
-         vk::raii::DeviceMemory const vertex_buffer_memory_{ vertex_buffer_memory() };
-         vk::raii::Buffer const index_buffer_{ index_buffer() };
-         vk::raii::DeviceMemory const index_buffer_memory_{ index_buffer_memory() };
+         vk::raii::Pipeline const depth_pre_pass_pipeline_{ depth_pre_pass_pipeline() };
+         vk::raii::DescriptorSetLayout const cull_descriptor_set_layout_{ cull_descriptor_set_layout() };
+         vk::raii::PipelineLayout const cull_pipeline_layout_{ cull_pipeline_layout() };
+         std::vector<std::uint32_t> const cull_shader_code_{ cull_shader_code() };
+         vk::raii::Pipeline const early_cull_pipeline_{ cull_pipeline(Phase::EARLY) };
+         vk::raii::Pipeline const late_cull_pipeline_{ cull_pipeline(Phase::LATE) };
+         std::vector<CullFrameBuffers> cull_frame_buffers_{ cull_frame_buffers() };
          std::vector<vk::raii::Buffer> uniform_buffers_{ uniform_buffers() };
          std::vector<vk::raii::DeviceMemory> uniform_buffer_memories_{ uniform_buffer_memories() };
          std::vector<UniformBufferObject*> uniform_buffer_mapped_{};
-         UniquePointer<ktxTexture2> const texture_{ texture("assets/textures/test.png") };
-         vk::raii::Image const image_{ image() };
-         vk::raii::ImageView image_view_{ nullptr };
          vk::raii::Sampler const sampler_{ sampler() };
-         vk::raii::DeviceMemory const image_memory_{ image_memory() };
          vk::raii::DescriptorPool const descriptor_pool_{ descriptor_pool() };
          std::vector<vk::raii::DescriptorSet> const uniform_buffer_descriptor_sets_{ uniform_buffer_descriptor_sets() };
-         vk::raii::DescriptorSet const sampler_descriptor_set_{ sampler_descriptor_set() };
+         std::vector<Mesh> meshes_{};
+         // every mesh's meshlets, one after the other; uploaded as meshes are created and shared by every frame in flight
+         std::vector<Meshlets::Meshlet> meshlets_{};
+         DeviceBuffer<Meshlets::Meshlet> meshlet_buffer_{};
+         GeometryPool geometry_pool_{};
+         std::vector<Material> materials_{};
+         float const timestamp_period_{ context_.physical_device.getProperties2().properties.limits.timestampPeriod };
+         vk::raii::QueryPool const timestamp_query_pool_{ timestamp_query_pool() };
+         // of the last frame recorded at each frame index, if any; the timestamps are read back accordingly
+         std::array<std::optional<DepthMode>, MAX_FRAMES_IN_FLIGHT> recorded_depth_modes_{};
+         Timings timings_{};
+         Statistics statistics_{};
+         VisibilityCounters visibility_counters_{};
+         std::vector<RecordingPool> recording_pools_{ recording_pools() };
+         std::array<DrawListBuffers, MAX_FRAMES_IN_FLIGHT> draw_list_buffers_{};
+         std::vector<Draw> draws_{};
+         std::vector<LightClusters::Light> lights_{};
+         Visibility visibility_{};
+         std::unordered_map<std::uint32_t, StaticSegment> static_segments_{};
+         std::uint32_t next_static_segment_{};
+         std::vector<RetiredResources> retired_resources_{};
    };
 }
 
@@ -0,0 +1,56 @@
+#ifndef RESOLUTION_CONTROLLER_HPP
+#define RESOLUTION_CONTROLLER_HPP
+
+#include "eruptor/api.hpp"
+#include "eruptor/pch.hpp"
+
+namespace eru
+{
+   // picks the scale to render at from measured GPU frame times; the cost of a frame is taken to grow with its pixel
+   // count, so with the square of the scale, and the scale only moves in steps, as every change resizes render targets
+   class ResolutionController final
+   {
+      public:
+         struct Settings final
+         {
+            std::chrono::duration<double, std::milli> target_frame_time{ 1000.0 / 60.0 };
+            float minimum_scale{ 0.5f };
+            float maximum_scale{ 1.0f };
+         };
+
+         ERU_API explicit ResolutionController(Settings const& settings);
+         ResolutionController(ResolutionController const&) = default;
+         ResolutionController(ResolutionController&&) = default;
+
+         ~ResolutionController() = default;
+
+         auto operator=(ResolutionController const&) -> ResolutionController& = default;
+         auto operator=(ResolutionController&&) -> ResolutionController& = default;
+
+         // to be fed the GPU time of every completed frame, in the order they complete
+         ERU_API auto update(std::chrono::duration<double, std::milli> frame_time) -> void;
+
+         // keeps the current scale, as far as the new bounds allow
+         ERU_API auto change_settings(Settings const& settings) -> void;
+
+         [[nodiscard]] ERU_API auto settings() const -> Settings const&;
+
+         // relative to the size of the final image, along either axis
+         [[nodiscard]] ERU_API auto scale() const -> float;
+
+      private:
+         // frame times are averaged over this many frames before the scale is reconsidered
+         static auto constexpr FRAMES_PER_ADJUSTMENT{ 8uz };
+         static auto constexpr SCALE_STEP{ 0.05f };
+
+         // of the target frame time, aimed for so that small spikes do not immediately miss it
+         static auto constexpr HEADROOM{ 0.9 };
+
+         Settings settings_;
+         float scale_{ settings_.maximum_scale };
+         std::chrono::duration<double, std::milli> accumulated_frame_time_{};
+         std::size_t accumulated_frames_{};
+   };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,117 @@
+#ifndef SKINNER_HPP
+#define SKINNER_HPP
+
+#include "eruptor/api.hpp"
+#include "eruptor/compute_pipeline.hpp"
+#include "eruptor/constants.hpp"
+#include "eruptor/context.hpp"
+#include "eruptor/layout.hpp"
+#include "eruptor/locator.hpp"
+#include "eruptor/pch.hpp"
+#include "eruptor/vertex_layout.hpp"
+
+namespace eru
+{
+   // deforms skinned meshes on the device, once per change of pose rather than once per pass; every instance gets
+   // buffers of its own that hold its skinned vertices, which depth, shadow and shading passes all draw from as they
+   // are, and which are only skinned again once the instance's joints have moved
+   class Skinner final
+   {
+      public:
+         // the weights are expected to sum up to one; joints index the palette of whichever instance is being skinned
+         struct Vertex final
+         {
+            glm::vec3 position;
+            glm::vec3 normal;
+            glm::u16vec4 joints;
+            glm::vec4 weights;
+         };
+
+         // matches `SkinnedVertex` in skinning.slang; the position is in the format of the renderer's position stream,
+         // so that the renderer draws straight from it, and the normal is octahedral (see `decode_octahedral`)
+         struct SkinnedVertex final
+         {
+            Half4 position;
+            Snorm16x2 normal;
+            std::uint32_t padding;
+         };
+
+         static auto constexpr MAX_JOINTS{ 256uz };
+
+         ERU_API Skinner();
+         Skinner(Skinner const&) = delete;
+         Skinner(Skinner&&) = delete;
+
+         ~Skinner() = default;
+
+         auto operator=(Skinner const&) -> Skinner& = delete;
+         auto operator=(Skinner&&) -> Skinner& = delete;
+
+         // the bind pose, shared by every instance of the mesh
+         [[nodiscard]] ERU_API auto create_mesh(std::span<Vertex const> vertices) -> std::uint32_t;
+         // starts out in the bind pose, once recorded, and stays in it until it is first posed
+         [[nodiscard]] ERU_API auto create_instance(std::uint32_t mesh) -> std::uint32_t;
+
+         // the palette holds a matrix per joint, taking bind pose model space to posed model space; an instance whose
+         // palette has not changed is not skinned again. The frame that last used `frame_index` must have completed
+         ERU_API auto pose(std::uint32_t instance, std::uint8_t frame_index, std::span<glm::mat4 const> palette) -> void;
+
+         // skins every instance posed for the frame since the last call; once done, the skinned vertices can be read as
+         // vertex input or by any shader, until the next call overwrites them
+         ERU_API auto record(vk::raii::CommandBuffer const& command_buffer, std::uint8_t frame_index) -> void;
+
+         // holds a `SkinnedVertex` per vertex of the instance's mesh
+         [[nodiscard]] ERU_API auto vertex_buffer(std::uint32_t instance) const -> vk::Buffer;
+         [[nodiscard]] ERU_API auto vertex_count(std::uint32_t instance) const -> std::uint32_t;
+
+      private:
+         // matches `Vertex` in skinning.slang; the joints are packed two to a word
+         struct PackedVertex final
+         {
+            glm::vec3 position;
+            std::uint32_t joints_0;
+            glm::vec3 normal;
+            std::uint32_t joints_1;
+            glm::vec4 weights;
+         };
+
+         // matches `SkinConstants` in skinning.slang
+         struct SkinConstants final
+         {
+            std::uint32_t vertex_count;
+         };
+
+         using Buffer = Context::Buffer;
+
+         struct Mesh final
+         {
+            Buffer vertices;
+            std::uint32_t vertex_count;
+         };
+
+         struct Instance final
+         {
+            std::uint32_t mesh;
+            Buffer skinned_vertices;
+            // one per frame in flight, so that posing never touches a palette still being read
+            std::vector<Buffer> palettes;
+            // what the instance was last posed with, to tell whether a new pose changes anything
+            std::vector<glm::mat4> palette{};
+            // whether it has been posed since it was last skinned
+            bool pending{};
+         };
+
+         [[nodiscard]] auto layout() const -> Layout;
+         [[nodiscard]] auto pipeline() const -> ComputePipeline;
+         auto upload(Buffer const& destination, std::span<std::byte const> data) const -> void;
+
+         Context const& context_{ Locator::get<Context>() };
+
+         Layout const layout_{ layout() };
+         ComputePipeline const pipeline_{ pipeline() };
+         std::vector<Mesh> meshes_{};
+         std::vector<Instance> instances_{};
+   };
+}
+
+#endif
\ No newline at end of file
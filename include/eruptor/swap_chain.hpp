@@ -1,6 +1,8 @@
 ﻿#ifndef SWAP_CHAIN_HPP
 #define SWAP_CHAIN_HPP
 
+#include "eruptor/api.hpp"
+#include "eruptor/constants.hpp"
 #include "eruptor/context.hpp"
 #include "eruptor/pch.hpp"
 
@@ -14,7 +16,7 @@ namespace eru
       public:
          struct Description final
          {
-            std::uint32_t frames_in_flight{ 1u };
+            std::uint32_t frames_in_flight{ MAX_FRAMES_IN_FLIGHT };
             std::uint32_t minimal_image_count{ 3u };
             vk::Extent2D extent{};
             vk::Format format{ vk::Format::eB8G8R8A8Srgb };
@@ -31,19 +33,73 @@ namespace eru
          auto operator=(SwapChain const&) -> SwapChain& = delete;
          auto operator=(SwapChain&&) -> SwapChain& = delete;
 
+         // signals the frame's image available semaphore once the image can be rendered to; nothing when the swap chain
+         // no longer matches the surface, in which case nothing is signaled
+         [[nodiscard]] ERU_API auto acquire(std::uint8_t frame_index) const -> std::optional<std::uint32_t>;
+         // once the image's present semaphore is signaled; false when the swap chain no longer matches the surface as well
+         // as it could, although the image may still have been presented. A nonzero present id, which has to be higher
+         // than any presented with before, can be waited on with `wait_for_present`
+         [[nodiscard]] ERU_API auto present(std::uint32_t image_index, std::uint64_t present_id = 0) -> bool;
+         // until the image presented with the id, or one presented after it, is on screen; false on timing out. Ids
+         // presented from a swap chain since replaced count as presented. Requires `Context::present_wait_support`
+         ERU_API auto wait_for_present(std::uint64_t present_id, std::chrono::nanoseconds timeout) const -> bool;
+
+         // replaces the swap chain with one for the given extent, handing the current one over as the old one; it is
+         // only destroyed once the presentation engine is done with every image presented from it, so nothing has to
+         // wait for the device to go idle. No image acquired from the current swap chain may still be left to present
+         ERU_API auto recreate(vk::Extent2D extent) -> void;
+
+         // one per frame in flight, as images are acquired before it is known which one comes next
+         [[nodiscard]] ERU_API auto image_available_semaphore(std::uint8_t frame_index) const -> vk::Semaphore;
+         // one per image, as an image's presentation may still be waiting on it when its frame index comes around again
+         [[nodiscard]] ERU_API auto present_semaphore(std::uint32_t image_index) const -> vk::Semaphore;
+
+         [[nodiscard]] ERU_API auto image(std::uint32_t image_index) const -> vk::Image;
+         [[nodiscard]] ERU_API auto image_view(std::uint32_t image_index) const -> vk::ImageView;
+         [[nodiscard]] ERU_API auto image_count() const -> std::uint32_t;
+         [[nodiscard]] ERU_API auto extent() const -> vk::Extent2D;
+         [[nodiscard]] ERU_API auto format() const -> vk::Format;
+         [[nodiscard]] ERU_API auto frames_in_flight() const -> std::uint32_t;
+
       private:
-         [[nodiscard]] auto swap_chain(Description const& parameters) const -> vk::raii::SwapchainKHR;
+         // whatever presentation may still be using of a replaced swap chain
+         struct RetiredSwapChain final
+         {
+            vk::raii::SwapchainKHR swap_chain;
+            std::vector<vk::raii::ImageView> image_views;
+            std::vector<vk::raii::Semaphore> present_semaphores;
+            std::vector<vk::raii::Fence> present_fences;
+         };
+
+         [[nodiscard]] auto surface_format() const -> vk::SurfaceFormatKHR;
+         [[nodiscard]] auto image_extent(vk::Extent2D requested_extent) const -> vk::Extent2D;
+         [[nodiscard]] auto swap_chain(vk::SwapchainKHR old_swap_chain) const -> vk::raii::SwapchainKHR;
          [[nodiscard]] auto swap_chain_images() const -> std::vector<vk::Image>;
-         [[nodiscard]] auto swap_chain_image_views(vk::Format format) const -> std::vector<vk::raii::ImageView>;
+         [[nodiscard]] auto swap_chain_image_views() const -> std::vector<vk::raii::ImageView>;
+         [[nodiscard]] auto present_fence() -> vk::raii::Fence;
+         // recycles the fences of completed presentations and destroys retired swap chains that are no longer presented
+         auto release_presented() -> void;
 
          Context const& context_{ Locator::get<Context>() };
 
          vk::raii::SurfaceKHR const& surface_;
+         Description const description_;
          std::vector<vk::raii::Semaphore> const image_available_semaphores_;
 
+         vk::SurfaceFormatKHR const surface_format_;
+         vk::Extent2D extent_;
          vk::raii::SwapchainKHR swap_chain_;
          std::vector<vk::Image> swap_chain_images_{ swap_chain_images() };
-         std::vector<vk::raii::ImageView> swap_chain_image_views_;
+         std::vector<vk::raii::ImageView> swap_chain_image_views_{ swap_chain_image_views() };
+         std::vector<vk::raii::Semaphore> present_semaphores_{ context_.create_semaphores(image_count()) };
+         // signaled once the presentation engine is done with an image presented from the current swap chain, along
+         // with its present semaphore
+         std::vector<vk::raii::Fence> present_fences_{};
+         std::vector<vk::raii::Fence> free_present_fences_{};
+         std::vector<RetiredSwapChain> retired_swap_chains_{};
+         std::uint64_t last_present_id_{};
+         // ids below were presented from swap chains since replaced, which can no longer be waited on
+         std::uint64_t first_present_id_{};
    };
 }
 
@@ -0,0 +1,54 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include "eruptor/api.hpp"
+#include "eruptor/pass_key.hpp"
+#include "eruptor/pch.hpp"
+
+namespace eru
+{
+   class Locator;
+
+   class ThreadPool final
+   {
+      public:
+         using Task = std::function<void(std::size_t task_index, std::size_t thread_index)>;
+
+         ERU_API explicit ThreadPool(PassKey<Locator>,
+            std::size_t thread_count = std::max(std::thread::hardware_concurrency(), 1u));
+         ThreadPool(ThreadPool const&) = delete;
+         ThreadPool(ThreadPool&&) = delete;
+
+         ERU_API ~ThreadPool();
+
+         auto operator=(ThreadPool const&) -> ThreadPool& = delete;
+         auto operator=(ThreadPool&&) -> ThreadPool& = delete;
+
+         // the calling thread takes part in the work as thread index 0; called from within a task, the tasks are all
+         // run right away on the calling thread instead, with the thread index of the task calling
+         ERU_API auto execute(std::size_t task_count, Task const& task) -> void;
+
+         // including the calling thread; thread indices passed to tasks are always below this
+         [[nodiscard]] ERU_API auto thread_count() const -> std::size_t;
+
+      private:
+         auto work(std::stop_token const& stop_token, std::size_t thread_index) -> void;
+         auto run_tasks(Task const& task, std::size_t task_count, std::size_t thread_index) -> std::size_t;
+
+         std::mutex execution_mutex_{};
+         std::mutex mutex_{};
+         std::condition_variable condition_{};
+         std::condition_variable done_condition_{};
+
+         Task const* task_{};
+         std::size_t task_count_{};
+         std::atomic<std::size_t> next_task_index_{};
+         std::size_t remaining_tasks_{};
+         std::size_t busy_threads_{};
+         std::uint64_t generation_{};
+
+         std::vector<std::jthread> threads_{};
+   };
+}
+
+#endif
\ No newline at end of file
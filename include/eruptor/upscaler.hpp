@@ -0,0 +1,53 @@
+#ifndef UPSCALER_HPP
+#define UPSCALER_HPP
+
+#include "eruptor/api.hpp"
+#include "eruptor/locator.hpp"
+#include "eruptor/pch.hpp"
+
+namespace eru
+{
+   class Context;
+
+   // stretches an image over a larger one in a single full-screen pass, filtering with a Catmull-Rom spline, which
+   // keeps edges noticeably sharper than bilinear filtering does at the cost of five bilinear fetches instead of one
+   class Upscaler final
+   {
+      public:
+         ERU_API explicit Upscaler(vk::Format target_format);
+         Upscaler(Upscaler const&) = delete;
+         Upscaler(Upscaler&&) = delete;
+
+         ~Upscaler() = default;
+
+         auto operator=(Upscaler const&) -> Upscaler& = delete;
+         auto operator=(Upscaler&&) -> Upscaler& = delete;
+
+         // the source is read in `eShaderReadOnlyOptimal`, the target is overwritten as a whole in `eColorAttachmentOptimal`
+         ERU_API auto record(vk::raii::CommandBuffer const& command_buffer, vk::ImageView source, vk::Extent2D source_extent,
+            vk::ImageView target, vk::Extent2D target_extent) const -> void;
+
+      private:
+         // matches `UpscaleConstants` in upscaling.slang
+         struct UpscaleConstants final
+         {
+            glm::vec2 source_size;
+            glm::vec2 target_size;
+         };
+
+         [[nodiscard]] auto sampler() const -> vk::raii::Sampler;
+         [[nodiscard]] auto descriptor_set_layout() const -> vk::raii::DescriptorSetLayout;
+         [[nodiscard]] auto pipeline_layout() const -> vk::raii::PipelineLayout;
+         [[nodiscard]] auto pipeline() const -> vk::raii::Pipeline;
+
+         Context const& context_{ Locator::get<Context>() };
+
+         vk::Format const target_format_;
+         vk::raii::Sampler const sampler_{ sampler() };
+         vk::raii::DescriptorSetLayout const descriptor_set_layout_{ descriptor_set_layout() };
+         vk::raii::PipelineLayout const pipeline_layout_{ pipeline_layout() };
+         vk::raii::Pipeline const pipeline_{ pipeline() };
+   };
+}
+
+#endif
\ No newline at end of file
@@ -1,14 +1,51 @@
 ﻿#ifndef VERTEX_HPP
 #define VERTEX_HPP
 
+#include "api.hpp"
 #include "pch.hpp"
+#include "vertex_layout.hpp"
 
 namespace eru
 {
    struct Vertex final
    {
-      static std::array<vk::VertexInputBindingDescription, 1> const INPUT_BINDING_DESCRIPTIONS;
+      // how a mesh stores its vertices on the device; split, the positions are tightly packed in a stream of their own
+      // and everything else follows in a second one, so that position-only passes never read the rest
+      enum class StreamLayout
+      {
+         INTERLEAVED,
+         SPLIT
+      };
+
+      // everything but the position, quantized; the color is clamped to [0, 1] and so are the texture coordinates,
+      // which therefore cannot rely on the sampler to repeat a texture
+      struct Attributes final
+      {
+         Unorm8x4 color;
+         Unorm16x2 texture_coordinate;
+      };
+
+      // a vertex as shaders read it, through the input assembler, pulled or by mesh shaders; the attributes form its tail,
+      // so that the attribute stream of either layout is read through the same attribute descriptions
+      struct Packed final
+      {
+         Half4 position;
+         Attributes attributes;
+      };
+
+      // what the descriptions below are generated from
+      using PositionLayout = VertexLayout<Half4>;
+      using AttributeLayout = VertexLayout<Unorm8x4, Unorm16x2>;
+
+      [[nodiscard]] ERU_API auto packed() const -> Packed;
+
+      // the position stream at binding 0 and the attribute stream at binding 2; the strides are those of the interleaved
+      // layout, where both streams are the same buffer of packed vertices, the second bound from
+      // `offsetof(Packed, attributes)`, and are meant to be set dynamically for split meshes
+      static std::array<vk::VertexInputBindingDescription, 2> const INPUT_BINDING_DESCRIPTIONS;
       static std::array<vk::VertexInputAttributeDescription, 3> const INPUT_ATTRIBUTE_DESCRIPTIONS;
+      static std::array<vk::VertexInputBindingDescription, 1> const POSITION_INPUT_BINDING_DESCRIPTIONS;
+      static std::array<vk::VertexInputAttributeDescription, 1> const POSITION_INPUT_ATTRIBUTE_DESCRIPTIONS;
 
       glm::vec3 position;
       glm::vec3 color;
@@ -0,0 +1,194 @@
+#ifndef VERTEX_LAYOUT_HPP
+#define VERTEX_LAYOUT_HPP
+
+#include "eruptor/api.hpp"
+#include "eruptor/pch.hpp"
+
+namespace eru
+{
+   // quantized attribute types, each stored as the bits the input assembler expands back into floats; see the encode
+   // functions below for how to fill them in
+   struct Half2 final
+   {
+      std::array<std::uint16_t, 2> bits;
+   };
+
+   // positions in three components are padded to four, as three component half formats are rarely supported
+   struct Half4 final
+   {
+      std::array<std::uint16_t, 4> bits;
+   };
+
+   struct Unorm8x4 final
+   {
+      std::array<std::uint8_t, 4> values;
+   };
+
+   struct Unorm16x2 final
+   {
+      std::array<std::uint16_t, 2> values;
+   };
+
+   // a unit vector folded onto an octahedron and unfolded into a square; see `encode_octahedral`
+   struct Snorm16x2 final
+   {
+      std::array<std::int16_t, 2> values;
+   };
+
+   // the format an attribute type is read in; specialized for every type a vertex layout can be made of
+   template<typename Attribute>
+   struct VertexFormat;
+
+   template<typename Attribute>
+   concept VertexAttribute = requires { { VertexFormat<Attribute>::FORMAT } -> std::convertible_to<vk::Format>; };
+
+   template<>
+   struct VertexFormat<float> final
+   {
+      static auto constexpr FORMAT{ vk::Format::eR32Sfloat };
+   };
+
+   template<>
+   struct VertexFormat<glm::vec2> final
+   {
+      static auto constexpr FORMAT{ vk::Format::eR32G32Sfloat };
+   };
+
+   template<>
+   struct VertexFormat<glm::vec3> final
+   {
+      static auto constexpr FORMAT{ vk::Format::eR32G32B32Sfloat };
+   };
+
+   template<>
+   struct VertexFormat<glm::vec4> final
+   {
+      static auto constexpr FORMAT{ vk::Format::eR32G32B32A32Sfloat };
+   };
+
+   template<>
+   struct VertexFormat<std::uint32_t> final
+   {
+      static auto constexpr FORMAT{ vk::Format::eR32Uint };
+   };
+
+   template<>
+   struct VertexFormat<Half2> final
+   {
+      static auto constexpr FORMAT{ vk::Format::eR16G16Sfloat };
+   };
+
+   template<>
+   struct VertexFormat<Half4> final
+   {
+      static auto constexpr FORMAT{ vk::Format::eR16G16B16A16Sfloat };
+   };
+
+   template<>
+   struct VertexFormat<Unorm8x4> final
+   {
+      static auto constexpr FORMAT{ vk::Format::eR8G8B8A8Unorm };
+   };
+
+   template<>
+   struct VertexFormat<Unorm16x2> final
+   {
+      static auto constexpr FORMAT{ vk::Format::eR16G16Unorm };
+   };
+
+   template<>
+   struct VertexFormat<Snorm16x2> final
+   {
+      static auto constexpr FORMAT{ vk::Format::eR16G16Snorm };
+   };
+
+   // the attributes of one vertex stream, in order, laid out as they would be as the members of a struct, so that a
+   // struct declaring them in the same order can be checked against `STRIDE` and `OFFSETS` and uploaded as it is
+   template<VertexAttribute... Attributes>
+      requires (sizeof...(Attributes) > 0)
+   class VertexLayout final
+   {
+      public:
+         static auto constexpr ATTRIBUTE_COUNT{ sizeof...(Attributes) };
+
+         static auto constexpr OFFSETS{
+            []
+            {
+               std::array<std::uint32_t, ATTRIBUTE_COUNT> offsets{};
+               std::uint32_t offset{};
+               std::size_t index{};
+               ((offset = (offset + alignof(Attributes) - 1) / alignof(Attributes) * alignof(Attributes),
+                  offsets[index++] = offset,
+                  offset += sizeof(Attributes)), ...);
+
+               return offsets;
+            }()
+         };
+
+         static auto constexpr STRIDE{
+            []
+            {
+               std::uint32_t offset{};
+               ((offset = (offset + alignof(Attributes) - 1) / alignof(Attributes) * alignof(Attributes),
+                  offset += sizeof(Attributes)), ...);
+
+               std::uint32_t const alignment{ std::max({ static_cast<std::uint32_t>(alignof(Attributes))... }) };
+               return (offset + alignment - 1) / alignment * alignment;
+            }()
+         };
+
+         VertexLayout() = delete;
+
+         [[nodiscard]] static constexpr auto binding_description(std::uint32_t const binding,
+            vk::VertexInputRate const input_rate = vk::VertexInputRate::eVertex) -> vk::VertexInputBindingDescription
+         {
+            return {
+               .binding{ binding },
+               .stride{ STRIDE },
+               .inputRate{ input_rate }
+            };
+         }
+
+         // locations are handed out in order from the first one
+         [[nodiscard]] static constexpr auto attribute_descriptions(std::uint32_t const binding,
+            std::uint32_t const first_location = 0) -> std::array<vk::VertexInputAttributeDescription, ATTRIBUTE_COUNT>
+         {
+            std::array<vk::Format, ATTRIBUTE_COUNT> constexpr formats{ VertexFormat<Attributes>::FORMAT... };
+
+            std::array<vk::VertexInputAttributeDescription, ATTRIBUTE_COUNT> descriptions{};
+            for (std::uint32_t index{}; index < ATTRIBUTE_COUNT; ++index)
+               descriptions[index] = {
+                  .location{ first_location + index },
+                  .binding{ binding },
+                  .format{ formats[index] },
+                  .offset{ OFFSETS[index] }
+               };
+
+            return descriptions;
+         }
+   };
+
+   // for vertices spread over several streams, each with a layout of its own
+   template<std::size_t... Counts>
+   [[nodiscard]] constexpr auto join(std::array<vk::VertexInputAttributeDescription, Counts> const&... descriptions)
+      -> std::array<vk::VertexInputAttributeDescription, (Counts + ...)>
+   {
+      std::array<vk::VertexInputAttributeDescription, (Counts + ...)> joined{};
+      std::size_t index{};
+      ((std::ranges::copy(descriptions, joined.begin() + index), index += Counts), ...);
+
+      return joined;
+   }
+
+   // the fourth component is 1, so that positions can be transformed as they are
+   [[nodiscard]] ERU_API auto encode_half(glm::vec3 const& value) -> Half4;
+   [[nodiscard]] ERU_API auto encode_half(glm::vec2 const& value) -> Half2;
+   // components are clamped to [0, 1]
+   [[nodiscard]] ERU_API auto encode_unorm8(glm::vec4 const& value) -> Unorm8x4;
+   [[nodiscard]] ERU_API auto encode_unorm16(glm::vec2 const& value) -> Unorm16x2;
+   // the normal has to be of unit length; shaders decode it the way `decode_octahedral` does
+   [[nodiscard]] ERU_API auto encode_octahedral(glm::vec3 const& normal) -> Snorm16x2;
+   [[nodiscard]] ERU_API auto decode_octahedral(Snorm16x2 const& encoded_normal) -> glm::vec3;
+}
+
+#endif
\ No newline at end of file
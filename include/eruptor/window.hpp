@@ -29,6 +29,8 @@ namespace eru
 
          ERU_API auto change_extent(glm::uvec2 extent) -> void;
          [[nodiscard]] ERU_API auto extent(bool in_physical_pixels = false) const -> glm::uvec2;
+         // in physical pixels, as of the last poll for events; unlike everything else here, safe to call from any thread
+         [[nodiscard]] ERU_API auto framebuffer_extent() const -> glm::uvec2;
 
          ERU_API auto change_position(glm::uvec2 position) -> void;
          [[nodiscard]] ERU_API auto position() const -> glm::uvec2;
@@ -36,12 +38,14 @@ namespace eru
          ERU_API auto change_title(std::string_view title) -> void;
          [[nodiscard]] ERU_API auto title() const -> std::string_view;
 
+         [[nodiscard]] ERU_API auto swap_chain() -> SwapChain&;
          [[nodiscard]] ERU_API auto swap_chain() const -> SwapChain const&;
 
       private:
          UniquePointer<NativeHandle> native_window_;
          vk::raii::SurfaceKHR surface_;
          SwapChain swap_chain_;
+         std::atomic<glm::uvec2> framebuffer_extent_{ extent(true) };
    };
 }
 
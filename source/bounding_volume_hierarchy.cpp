@@ -0,0 +1,429 @@
+#include "eruptor/bounding_volume_hierarchy.hpp"
+#include "eruptor/runtime_assert.hpp"
+
+namespace eru
+{
+   auto BoundingVolumeHierarchy::build(std::span<Box const> const boxes) -> void
+   {
+      RUNTIME_ASSERT(boxes.size() <= std::numeric_limits<std::uint32_t>::max(),
+         "too many objects for a bounding volume hierarchy!");
+
+      auto const object_count{ static_cast<std::uint32_t>(boxes.size()) };
+
+      boxes_.assign(boxes.begin(), boxes.end());
+      objects_.resize(object_count);
+      std::iota(objects_.begin(), objects_.end(), 0u);
+      nodes_.clear();
+      if (not object_count)
+         return;
+
+      nodes_.reserve(2 * object_count - 1);
+
+      std::vector<glm::vec3> centroids{};
+      centroids.reserve(object_count);
+      for (Box const& box : boxes_)
+         centroids.push_back((box.minimum + box.maximum) * 0.5f);
+
+      // every node takes the objects in [begin, end) of the object order, and the right child of a split is only given its
+      // index once the left one's whole subtree is in place, which keeps the nodes in depth-first order
+      struct Task final
+      {
+         std::uint32_t begin;
+         std::uint32_t end;
+         std::size_t depth;
+         std::optional<std::uint32_t> parent{};
+      };
+
+      std::vector<Task> tasks{
+         {
+            .begin{ 0 },
+            .end{ object_count },
+            .depth{ 0 }
+         }
+      };
+
+      while (not tasks.empty())
+      {
+         Task const task{ tasks.back() };
+         tasks.pop_back();
+
+         auto const node_index{ static_cast<std::uint32_t>(nodes_.size()) };
+         if (task.parent)
+            nodes_[*task.parent].first = node_index;
+
+         Box box{ empty_box() };
+         Box centroid_box{ empty_box() };
+         for (std::uint32_t index{ task.begin }; index < task.end; ++index)
+         {
+            std::uint32_t const object{ objects_[index] };
+            box = merged(box, boxes_[object]);
+            centroid_box = merged(centroid_box, { .minimum{ centroids[object] }, .maximum{ centroids[object] } });
+         }
+
+         std::uint32_t const count{ task.end - task.begin };
+         nodes_.push_back({
+            .box{ box },
+            .first{ task.begin },
+            .count{ count }
+         });
+
+         if (count <= MAXIMUM_LEAF_SIZE or task.depth + 1 >= MAXIMUM_DEPTH)
+            continue;
+
+         // objects are binned by centroid along every axis, and the boundary between two bins with the lowest expected
+         // cost of testing both sides is where the node gets split, unless leaving it a leaf costs less still
+         float best_cost{ static_cast<float>(count) * surface_area(box) };
+         std::optional<glm::length_t> best_axis{};
+         std::size_t best_split{};
+         for (glm::length_t axis{}; axis < 3; ++axis)
+         {
+            float const extent{ centroid_box.maximum[axis] - centroid_box.minimum[axis] };
+            if (extent <= 0.0f)
+               continue;
+
+            float const scale{ static_cast<float>(BIN_COUNT) / extent };
+            std::array<Bin, BIN_COUNT> bins{};
+            for (std::uint32_t index{ task.begin }; index < task.end; ++index)
+            {
+               std::uint32_t const object{ objects_[index] };
+               auto const bin_index{
+                  std::min(static_cast<std::size_t>((centroids[object][axis] - centroid_box.minimum[axis]) * scale), BIN_COUNT - 1)
+               };
+               bins[bin_index].box = merged(bins[bin_index].box, boxes_[object]);
+               ++bins[bin_index].count;
+            }
+
+            std::array<float, BIN_COUNT - 1> left_costs{};
+            std::array<std::uint32_t, BIN_COUNT - 1> left_counts{};
+            Box left_box{ empty_box() };
+            std::uint32_t left_count{};
+            for (std::size_t split{ 1 }; split < BIN_COUNT; ++split)
+            {
+               left_box = merged(left_box, bins[split - 1].box);
+               left_count += bins[split - 1].count;
+               left_costs[split - 1] = static_cast<float>(left_count) * surface_area(left_box);
+               left_counts[split - 1] = left_count;
+            }
+
+            Box right_box{ empty_box() };
+            std::uint32_t right_count{};
+            for (std::size_t split{ BIN_COUNT - 1 }; split > 0; --split)
+            {
+               right_box = merged(right_box, bins[split].box);
+               right_count += bins[split].count;
+               if (not left_counts[split - 1] or not right_count)
+                  continue;
+
+               float const cost{ left_costs[split - 1] + static_cast<float>(right_count) * surface_area(right_box) };
+               if (cost < best_cost)
+               {
+                  best_cost = cost;
+                  best_axis = axis;
+                  best_split = split;
+               }
+            }
+         }
+
+         if (not best_axis)
+            continue;
+
+         glm::length_t const axis{ *best_axis };
+         float const scale{ static_cast<float>(BIN_COUNT) / (centroid_box.maximum[axis] - centroid_box.minimum[axis]) };
+         auto const right_objects{
+            std::ranges::partition(objects_.begin() + task.begin, objects_.begin() + task.end,
+               [&](std::uint32_t const object) -> bool
+               {
+                  return std::min(static_cast<std::size_t>((centroids[object][axis] - centroid_box.minimum[axis]) * scale),
+                     BIN_COUNT - 1) < best_split;
+               })
+         };
+         auto const split{ static_cast<std::uint32_t>(right_objects.begin() - objects_.begin()) };
+
+         nodes_.back().count = 0;
+         tasks.push_back({
+            .begin{ split },
+            .end{ task.end },
+            .depth{ task.depth + 1 },
+            .parent{ node_index }
+         });
+         tasks.push_back({
+            .begin{ task.begin },
+            .end{ split },
+            .depth{ task.depth + 1 }
+         });
+      }
+   }
+
+   auto BoundingVolumeHierarchy::change(std::uint32_t const object, Box const& box) -> void
+   {
+      RUNTIME_ASSERT(object < boxes_.size(),
+         std::format("object {} does not exist!", object));
+
+      boxes_[object] = box;
+   }
+
+   auto BoundingVolumeHierarchy::refit() -> void
+   {
+      // children always come after their parent, so walking the nodes backwards refits every child before its parent
+      for (std::size_t node_index{ nodes_.size() }; node_index-- > 0;)
+      {
+         Node& node{ nodes_[node_index] };
+         if (node.count)
+         {
+            node.box = empty_box();
+            for (std::uint32_t index{ node.first }; index < node.first + node.count; ++index)
+               node.box = merged(node.box, boxes_[objects_[index]]);
+         }
+         else
+            node.box = merged(nodes_[node_index + 1].box, nodes_[node.first].box);
+      }
+   }
+
+   auto BoundingVolumeHierarchy::query(Frustum const& frustum, std::vector<std::uint32_t>& objects) const -> void
+   {
+      if (nodes_.empty())
+         return;
+
+      std::array<glm::vec4, 6> const& planes{ frustum.planes() };
+
+      // nothing when the box is outside, whether it is entirely inside otherwise
+      auto const classify{
+         [&planes](Box const& box) -> std::optional<bool>
+         {
+            bool inside{ true };
+            for (glm::vec4 const& plane : planes)
+            {
+               glm::vec3 const normal{ plane };
+               glm::bvec3 const positive{ greaterThanEqual(normal, glm::vec3{ 0.0f }) };
+
+               if (dot(normal, mix(box.minimum, box.maximum, positive)) + plane.w < 0.0f)
+                  return std::nullopt;
+
+               inside = inside and dot(normal, mix(box.maximum, box.minimum, positive)) + plane.w >= 0.0f;
+            }
+
+            return inside;
+         }
+      };
+
+      // a node entirely inside the frustum has all of its descendants inside as well, so they are no longer tested
+      std::array<std::pair<std::uint32_t, bool>, MAXIMUM_DEPTH> stack{};
+      std::size_t stack_size{};
+      std::uint32_t node_index{};
+      bool parent_inside{};
+      while (true)
+      {
+         Node const& node{ nodes_[node_index] };
+         std::optional<bool> const inside{ parent_inside ? std::optional{ true } : classify(node.box) };
+         if (inside and not node.count)
+         {
+            stack[stack_size++] = { node.first, *inside };
+            node_index = node_index + 1;
+            parent_inside = *inside;
+            continue;
+         }
+
+         if (inside)
+            for (std::uint32_t index{ node.first }; index < node.first + node.count; ++index)
+               if (*inside or classify(boxes_[objects_[index]]))
+                  objects.push_back(objects_[index]);
+
+         if (not stack_size)
+            break;
+
+         std::tie(node_index, parent_inside) = stack[--stack_size];
+      }
+   }
+
+   auto BoundingVolumeHierarchy::query(Box const& box, std::vector<std::uint32_t>& objects) const -> void
+   {
+      if (nodes_.empty())
+         return;
+
+      std::array<std::uint32_t, MAXIMUM_DEPTH> stack{};
+      std::size_t stack_size{};
+      std::uint32_t node_index{};
+      while (true)
+      {
+         Node const& node{ nodes_[node_index] };
+         if (overlap(node.box, box))
+         {
+            if (not node.count)
+            {
+               stack[stack_size++] = node.first;
+               node_index = node_index + 1;
+               continue;
+            }
+
+            for (std::uint32_t index{ node.first }; index < node.first + node.count; ++index)
+               if (overlap(boxes_[objects_[index]], box))
+                  objects.push_back(objects_[index]);
+         }
+
+         if (not stack_size)
+            break;
+
+         node_index = stack[--stack_size];
+      }
+   }
+
+   auto BoundingVolumeHierarchy::cast(Ray const& ray) const -> std::optional<Hit>
+   {
+      if (nodes_.empty())
+         return std::nullopt;
+
+      glm::vec3 const inverse_direction{ 1.0f / ray.direction };
+      float limit{ ray.length };
+      if (not entry(nodes_.front().box, ray.origin, inverse_direction, limit))
+         return std::nullopt;
+
+      // the nearer child is visited first, so that hits in it cut the farther one short, or rule it out altogether
+      std::optional<Hit> nearest_hit{};
+      std::array<std::pair<std::uint32_t, float>, MAXIMUM_DEPTH> stack{};
+      std::size_t stack_size{};
+      std::optional<std::uint32_t> node_index{ 0u };
+      while (node_index)
+      {
+         Node const& node{ nodes_[*node_index] };
+         node_index.reset();
+
+         if (node.count)
+         {
+            for (std::uint32_t index{ node.first }; index < node.first + node.count; ++index)
+               if (std::optional const distance{ entry(boxes_[objects_[index]], ray.origin, inverse_direction, limit) })
+               {
+                  limit = *distance;
+                  nearest_hit = Hit{
+                     .object{ objects_[index] },
+                     .distance{ *distance }
+                  };
+               }
+         }
+         else
+         {
+            std::uint32_t near_child{ static_cast<std::uint32_t>(&node - nodes_.data()) + 1 };
+            std::uint32_t far_child{ node.first };
+            std::optional near_distance{ entry(nodes_[near_child].box, ray.origin, inverse_direction, limit) };
+            std::optional far_distance{ entry(nodes_[far_child].box, ray.origin, inverse_direction, limit) };
+            if (far_distance and (not near_distance or *far_distance < *near_distance))
+            {
+               std::swap(near_child, far_child);
+               std::swap(near_distance, far_distance);
+            }
+
+            if (far_distance)
+               stack[stack_size++] = { far_child, *far_distance };
+
+            if (near_distance)
+               node_index = near_child;
+         }
+
+         // whatever was pushed before the latest hit may have been ruled out by it since
+         while (not node_index and stack_size)
+         {
+            auto const [candidate, distance]{ stack[--stack_size] };
+            if (distance <= limit)
+               node_index = candidate;
+         }
+      }
+
+      return nearest_hit;
+   }
+
+   auto BoundingVolumeHierarchy::query(std::span<Box const> const boxes, std::span<std::vector<std::uint32_t>> const objects) const -> void
+   {
+      RUNTIME_ASSERT(objects.size() >= boxes.size(),
+         std::format("only {} results for {} queries!", objects.size(), boxes.size()));
+
+      std::size_t const chunk_count{
+         std::min(thread_pool_.thread_count(), (boxes.size() + MINIMUM_QUERIES_PER_CHUNK - 1) / MINIMUM_QUERIES_PER_CHUNK)
+      };
+
+      thread_pool_.execute(chunk_count,
+         [&](std::size_t const chunk_index, std::size_t) -> void
+         {
+            std::size_t const end{ (chunk_index + 1) * boxes.size() / chunk_count };
+            for (std::size_t index{ chunk_index * boxes.size() / chunk_count }; index < end; ++index)
+               query(boxes[index], objects[index]);
+         });
+   }
+
+   auto BoundingVolumeHierarchy::cast(std::span<Ray const> const rays, std::span<std::optional<Hit>> const hits) const -> void
+   {
+      RUNTIME_ASSERT(hits.size() >= rays.size(),
+         std::format("only {} results for {} rays!", hits.size(), rays.size()));
+
+      std::size_t const chunk_count{
+         std::min(thread_pool_.thread_count(), (rays.size() + MINIMUM_QUERIES_PER_CHUNK - 1) / MINIMUM_QUERIES_PER_CHUNK)
+      };
+
+      thread_pool_.execute(chunk_count,
+         [&](std::size_t const chunk_index, std::size_t) -> void
+         {
+            std::size_t const end{ (chunk_index + 1) * rays.size() / chunk_count };
+            for (std::size_t index{ chunk_index * rays.size() / chunk_count }; index < end; ++index)
+               hits[index] = cast(rays[index]);
+         });
+   }
+
+   auto BoundingVolumeHierarchy::size() const -> std::size_t
+   {
+      return boxes_.size();
+   }
+
+   auto BoundingVolumeHierarchy::empty_box() -> Box
+   {
+      return {
+         .minimum{ glm::vec3{ std::numeric_limits<float>::max() } },
+         .maximum{ glm::vec3{ std::numeric_limits<float>::lowest() } }
+      };
+   }
+
+   auto BoundingVolumeHierarchy::merged(Box const& box, Box const& other_box) -> Box
+   {
+      return {
+         .minimum{ min(box.minimum, other_box.minimum) },
+         .maximum{ max(box.maximum, other_box.maximum) }
+      };
+   }
+
+   auto BoundingVolumeHierarchy::surface_area(Box const& box) -> float
+   {
+      glm::vec3 const extent{ box.maximum - box.minimum };
+      return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+   }
+
+   auto BoundingVolumeHierarchy::overlap(Box const& box, Box const& other_box) -> bool
+   {
+      return all(lessThanEqual(box.minimum, other_box.maximum)) and all(lessThanEqual(other_box.minimum, box.maximum));
+   }
+
+   auto BoundingVolumeHierarchy::entry(Box const& box, glm::vec3 const& origin, glm::vec3 const& inverse_direction,
+      float const limit) -> std::optional<float>
+   {
+      float enter{ 0.0f };
+      float exit{ limit };
+      for (glm::length_t axis{}; axis < 3; ++axis)
+      {
+         // a ray parallel to the slab never crosses it, so it is either inside it all along or never; the distances
+         // would otherwise come out as 0 * inf, so NaN, for an origin lying on one of its planes
+         if (std::isinf(inverse_direction[axis]))
+         {
+            if (origin[axis] < box.minimum[axis] or origin[axis] > box.maximum[axis])
+               return std::nullopt;
+
+            continue;
+         }
+
+         float const minimum_distance{ (box.minimum[axis] - origin[axis]) * inverse_direction[axis] };
+         float const maximum_distance{ (box.maximum[axis] - origin[axis]) * inverse_direction[axis] };
+         enter = std::max(enter, std::min(minimum_distance, maximum_distance));
+         exit = std::min(exit, std::max(minimum_distance, maximum_distance));
+      }
+
+      if (enter > exit)
+         return std::nullopt;
+
+      return enter;
+   }
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "eruptor/compute_pipeline.hpp"
+#include "eruptor/context.hpp"
+#include "eruptor/exception.hpp"
+#include "eruptor/runtime_assert.hpp"
+
+#include "core/shader.hpp"
+
+namespace eru
+{
+   ComputePipeline::ComputePipeline(Layout const& layout, std::filesystem::path const& shader_path,
+      std::string_view const entry_point)
+      : ComputePipeline{ layout, compile_shader(shader_path), entry_point }
+   {
+   }
+
+   ComputePipeline::ComputePipeline(Layout const& layout, std::span<std::uint32_t const> const code,
+      std::string_view const entry_point)
+      : layout_{ layout }
+      , workgroup_size_{ workgroup_size(code, entry_point) }
+      , pipeline_{ pipeline(code, entry_point) }
+   {
+   }
+
+   auto ComputePipeline::group_count(glm::uvec3 const thread_count) const -> glm::uvec3
+   {
+      return (thread_count + workgroup_size_ - 1u) / workgroup_size_;
+   }
+
+   auto ComputePipeline::layout() const -> Layout const&
+   {
+      return layout_;
+   }
+
+   auto ComputePipeline::pipeline() const -> vk::Pipeline
+   {
+      return pipeline_;
+   }
+
+   auto ComputePipeline::workgroup_size() const -> glm::uvec3
+   {
+      return workgroup_size_;
+   }
+
+   auto ComputePipeline::workgroup_size(std::span<std::uint32_t const> const code, std::string_view const entry_point) const
+      -> glm::uvec3
+   {
+      // the module may hold several entry points, so the one asked for is looked up by name first, then the local size
+      // declared for it; both come before any function in the module, so there is no need to look any further
+      static auto constexpr HEADER_WORDS{ 5uz };
+      static auto constexpr OP_ENTRY_POINT{ 15u };
+      static auto constexpr OP_EXECUTION_MODE{ 16u };
+      static auto constexpr OP_FUNCTION{ 54u };
+      static auto constexpr EXECUTION_MODEL_GL_COMPUTE{ 5u };
+      static auto constexpr EXECUTION_MODE_LOCAL_SIZE{ 17u };
+
+      std::optional<std::uint32_t> entry_point_id{};
+      for (std::size_t offset{ HEADER_WORDS }; offset < code.size();)
+      {
+         std::uint32_t const word_count{ code[offset] >> 16 };
+         std::uint32_t const opcode{ code[offset] & 0xFFFF };
+         RUNTIME_ASSERT(word_count and offset + word_count <= code.size(),
+            "malformed SPIR-V!");
+
+         if (opcode == OP_FUNCTION)
+            break;
+
+         // names are null-terminated and padded to a whole word, within the instruction
+         if (opcode == OP_ENTRY_POINT and code[offset + 1] == EXECUTION_MODEL_GL_COMPUTE and
+            std::string_view{ reinterpret_cast<char const*>(&code[offset + 3]) } == entry_point)
+            entry_point_id = code[offset + 2];
+         else if (opcode == OP_EXECUTION_MODE and word_count >= 6 and entry_point_id == code[offset + 1] and
+            code[offset + 2] == EXECUTION_MODE_LOCAL_SIZE)
+            return { code[offset + 3], code[offset + 4], code[offset + 5] };
+
+         offset += word_count;
+      }
+
+      throw Exception{ std::format("no compute entry point \"{}\" with a workgroup size was found!", entry_point) };
+   }
+
+   auto ComputePipeline::pipeline(std::span<std::uint32_t const> const code, std::string_view const entry_point) const
+      -> vk::raii::Pipeline
+   {
+      vk::ShaderModuleCreateInfo const shader_module_create_info{
+         .codeSize{ code.size_bytes() },
+         .pCode{ code.data() }
+      };
+
+      std::string const name{ entry_point };
+
+      vk::ResultValue pipeline{
+         context_.device.createComputePipeline(nullptr, {
+            .stage{
+               .pNext{ &shader_module_create_info },
+               .stage{ vk::ShaderStageFlagBits::eCompute },
+               .pName{ name.c_str() }
+            },
+            .layout{ layout_.pipeline_layout() }
+         })
+      };
+      RUNTIME_ASSERT(pipeline.has_value(),
+         std::format("failed create a compute pipeline! ({})", to_string(pipeline.result)));
+
+      return std::move(*pipeline);
+   }
+}
\ No newline at end of file
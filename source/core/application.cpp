@@ -5,4 +5,23 @@ namespace eru
    Application::Application(PassKey<Locator>)
    {
    }
+
+   auto Application::on_demand() const -> bool
+   {
+      return false;
+   }
+
+   auto Application::pipelined() const -> bool
+   {
+      return false;
+   }
+
+   auto Application::update(std::uint8_t) -> bool
+   {
+      return tick();
+   }
+
+   auto Application::render(std::uint8_t) -> void
+   {
+   }
 }
\ No newline at end of file
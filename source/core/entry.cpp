@@ -1,5 +1,7 @@
 #include "eruptor/eruptor.hpp"
 
+#include "core/frame_pipeline.hpp"
+
 namespace eru
 {
    auto provide_application(std::span<char const* const> arguments) -> void;
@@ -10,11 +12,22 @@ auto main(int const arguments_count, char const* const* arguments) -> int try
    eru::Locator::provide<eru::Logger>();
    eru::Locator::provide<eru::Platform>();
    eru::Locator::provide<eru::Context>();
+   eru::Locator::provide<eru::ThreadPool>();
    eru::provide_application({ arguments, static_cast<std::size_t>(arguments_count) });
 
-   while (eru::Locator::get<eru::Application>().tick())
-   {
-   }
+   // pipelined applications update the next frame while the current one renders, on a thread of its own
+   if (eru::Application& application{ eru::Locator::get<eru::Application>() }; application.pipelined())
+      eru::FramePipeline{ application }.run();
+   else
+      while (true)
+      {
+         // only frames that are due are ticked, and so rendered
+         if (application.on_demand())
+            eru::Locator::get<eru::Platform>().wait();
+
+         if (not application.tick())
+            break;
+      }
 
    eru::Locator::remove_all();
    return 0;
@@ -0,0 +1,116 @@
+#include "eruptor/platform.hpp"
+
+#include "core/frame_pipeline.hpp"
+
+namespace eru
+{
+   FramePipeline::FramePipeline(Application& application)
+      : application_{ application }
+   {
+   }
+
+   auto FramePipeline::run() -> void
+   {
+      std::jthread render_thread{
+         [this]
+         {
+            render_frames();
+         }
+      };
+
+      std::exception_ptr update_exception{};
+      try
+      {
+         std::uint8_t snapshot_index{};
+         while (true)
+         {
+            {
+               std::unique_lock lock{ mutex_ };
+               condition_.wait(lock,
+                  [this, snapshot_index]
+                  {
+                     return not updated_[snapshot_index] or render_exception_;
+                  });
+
+               if (render_exception_)
+                  break;
+            }
+
+            // only frames that are due are updated, and so rendered
+            if (application_.on_demand())
+               Locator::get<Platform>().wait();
+
+            if (not application_.update(snapshot_index))
+               break;
+
+            {
+               std::lock_guard const lock{ mutex_ };
+               updated_[snapshot_index] = true;
+            }
+
+            condition_.notify_all();
+            snapshot_index = static_cast<std::uint8_t>((snapshot_index + 1) % Application::SNAPSHOT_COUNT);
+         }
+      }
+      catch (...)
+      {
+         update_exception = std::current_exception();
+      }
+
+      {
+         std::lock_guard const lock{ mutex_ };
+         updates_done_ = true;
+      }
+
+      condition_.notify_all();
+      render_thread.join();
+
+      if (update_exception)
+         std::rethrow_exception(update_exception);
+
+      if (render_exception_)
+         std::rethrow_exception(render_exception_);
+   }
+
+   auto FramePipeline::render_frames() -> void
+   {
+      try
+      {
+         std::uint8_t snapshot_index{};
+         while (true)
+         {
+            {
+               std::unique_lock lock{ mutex_ };
+               condition_.wait(lock,
+                  [this, snapshot_index]
+                  {
+                     return updated_[snapshot_index] or updates_done_;
+                  });
+
+               // snapshots are updated in turn, so once updates are done, one not updated means none are left
+               if (not updated_[snapshot_index])
+                  return;
+            }
+
+            application_.render(snapshot_index);
+
+            {
+               std::lock_guard const lock{ mutex_ };
+               updated_[snapshot_index] = false;
+            }
+
+            condition_.notify_all();
+            snapshot_index = static_cast<std::uint8_t>((snapshot_index + 1) % Application::SNAPSHOT_COUNT);
+         }
+      }
+      catch (...)
+      {
+         {
+            std::lock_guard const lock{ mutex_ };
+            render_exception_ = std::current_exception();
+         }
+
+         condition_.notify_all();
+      }
+   }
+}
\ No newline at end of file
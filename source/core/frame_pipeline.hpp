@@ -0,0 +1,41 @@
+#ifndef FRAME_PIPELINE_HPP
+#define FRAME_PIPELINE_HPP
+
+#include "eruptor/application.hpp"
+#include "eruptor/pch.hpp"
+
+namespace eru
+{
+   // runs a pipelined application's updates on the calling thread and its renders on a thread of its own, handing the
+   // snapshots over from one to the other in turn
+   class FramePipeline final
+   {
+      public:
+         explicit FramePipeline(Application& application);
+         FramePipeline(FramePipeline const&) = delete;
+         FramePipeline(FramePipeline&&) = delete;
+
+         ~FramePipeline() = default;
+
+         auto operator=(FramePipeline const&) -> FramePipeline& = delete;
+         auto operator=(FramePipeline&&) -> FramePipeline& = delete;
+
+         // until an update returns false and every frame updated before it has rendered; rethrows whatever either
+         // stage threw, once both have stopped
+         auto run() -> void;
+
+      private:
+         auto render_frames() -> void;
+
+         Application& application_;
+
+         std::mutex mutex_{};
+         std::condition_variable condition_{};
+         // whether each snapshot has been updated, but not yet rendered
+         std::array<bool, Application::SNAPSHOT_COUNT> updated_{};
+         bool updates_done_{};
+         std::exception_ptr render_exception_{};
+   };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "eruptor/exception.hpp"
+#include "eruptor/runtime_assert.hpp"
+
+#include "core/dependencies.hpp"
+#include "core/shader.hpp"
+
+namespace eru
+{
+   namespace
+   {
+      // the path only names the module in diagnostics
+      auto compile(std::string const& module_name, std::string const& path, std::string const& source)
+         -> std::vector<std::uint32_t>
+      {
+         static Slang::ComPtr<slang::IGlobalSession> const GLOBAL_SESSION{
+            [] -> Slang::ComPtr<slang::IGlobalSession>
+            {
+               Slang::ComPtr<slang::IGlobalSession> global_session;
+               createGlobalSession(global_session.writeRef());
+               RUNTIME_ASSERT(global_session,
+                  std::format("failed to create a global session! ({})", slang::getLastInternalErrorMessage()));
+
+               return global_session;
+            }()
+         };
+
+         std::array slang_targets{
+            std::to_array<slang::TargetDesc>({
+               {
+                  .format{ SLANG_SPIRV }
+               }
+            })
+         };
+
+         slang::SessionDesc const slang_session_description{
+            .targets{ std::ranges::data(slang_targets) },
+            .targetCount{ static_cast<SlangInt>(std::ranges::size(slang_targets)) },
+            .defaultMatrixLayoutMode{ SLANG_MATRIX_LAYOUT_COLUMN_MAJOR }
+         };
+
+         Slang::ComPtr<slang::ISession> slang_session;
+         GLOBAL_SESSION->createSession(slang_session_description, slang_session.writeRef());
+         RUNTIME_ASSERT(slang_session,
+            std::format("failed to create a slang session! ({})", slang::getLastInternalErrorMessage()));
+
+         Slang::ComPtr<slang::IBlob> diagnostics;
+         Slang::ComPtr const slang_module{
+            slang_session->loadModuleFromSourceString(module_name.c_str(), path.c_str(), source.c_str(),
+               diagnostics.writeRef())
+         };
+         if (not slang_module)
+            throw Exception{
+               std::format("failed to load slang module \"{}\"! ({})", path,
+                  diagnostics
+                     ? static_cast<char const*>(diagnostics->getBufferPointer())
+                     : slang::getLastInternalErrorMessage())
+            };
+
+         Slang::ComPtr<ISlangBlob> spirv;
+         slang_module->getTargetCode(0, spirv.writeRef());
+         RUNTIME_ASSERT(spirv,
+            std::format("failed to load get target code! ({})", slang::getLastInternalErrorMessage()));
+
+         std::vector<std::uint32_t> code(spirv->getBufferSize() / sizeof(std::uint32_t));
+         std::memcpy(code.data(), spirv->getBufferPointer(), code.size() * sizeof(std::uint32_t));
+         return code;
+      }
+   }
+
+   auto compile_framework_shader(std::string_view const name) -> std::vector<std::uint32_t>
+   {
+      std::filesystem::path const path{ name };
+      return compile(path.stem().string(), path.string(), std::string{ framework_shader_source(name) });
+   }
+
+   auto compile_shader(std::filesystem::path const& path) -> std::vector<std::uint32_t>
+   {
+      if (not std::filesystem::exists(path))
+         throw Exception{ std::format("\"{}\" does not exist!", path.string()) };
+
+      if (not std::filesystem::is_regular_file(path))
+         throw Exception{ std::format("\"{}\" is not a regular file!", path.string()) };
+
+      std::ifstream file{ path };
+      std::string const source{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+      return compile(path.stem().string(), path.string(), source);
+   }
+}
\ No newline at end of file
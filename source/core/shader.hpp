@@ -0,0 +1,14 @@
+#ifndef SHADER_HPP
+#define SHADER_HPP
+
+#include "eruptor/pch.hpp"
+
+namespace eru
+{
+   // the source of one of the framework's own shaders, by file name; embedded at build time
+   [[nodiscard]] auto framework_shader_source(std::string_view name) -> std::string_view;
+   [[nodiscard]] auto compile_framework_shader(std::string_view name) -> std::vector<std::uint32_t>;
+   [[nodiscard]] auto compile_shader(std::filesystem::path const& path) -> std::vector<std::uint32_t>;
+}
+
+#endif
\ No newline at end of file
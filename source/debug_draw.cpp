@@ -0,0 +1,424 @@
+#include "eruptor/context.hpp"
+#include "eruptor/debug_draw.hpp"
+#include "eruptor/runtime_assert.hpp"
+
+#include "core/shader.hpp"
+
+#include <glm/gtc/packing.hpp>
+
+namespace eru
+{
+   DebugDraw::DebugDraw(vk::Format const color_format, vk::Format const depth_format)
+      : pipeline_{ pipeline(color_format, depth_format) }
+   {
+   }
+
+   auto DebugDraw::line(glm::vec3 const& from, glm::vec3 const& to, glm::vec4 const& color) -> void
+   {
+      std::uint32_t const packed_color{ glm::packUnorm4x8(color) };
+
+      ThreadVertices& thread_vertices{ this->thread_vertices() };
+      std::lock_guard const lock{ thread_vertices.mutex };
+      thread_vertices.vertices.push_back({ from, packed_color });
+      thread_vertices.vertices.push_back({ to, packed_color });
+   }
+
+   auto DebugDraw::box(glm::vec3 const& minimum, glm::vec3 const& maximum, glm::vec4 const& color) -> void
+   {
+      std::uint32_t const packed_color{ glm::packUnorm4x8(color) };
+
+      // corner `index` takes the maximum along every axis whose bit is set
+      auto const corner{
+         [&minimum, &maximum](std::uint32_t const index) -> glm::vec3
+         {
+            return {
+               index & 1u ? maximum.x : minimum.x,
+               index & 2u ? maximum.y : minimum.y,
+               index & 4u ? maximum.z : minimum.z
+            };
+         }
+      };
+
+      ThreadVertices& thread_vertices{ this->thread_vertices() };
+      std::lock_guard const lock{ thread_vertices.mutex };
+
+      // every edge joins two corners one bit apart
+      for (std::uint32_t index{}; index < 8; ++index)
+         for (std::uint32_t const bit : { 1u, 2u, 4u })
+            if (not (index & bit))
+            {
+               thread_vertices.vertices.push_back({ corner(index), packed_color });
+               thread_vertices.vertices.push_back({ corner(index | bit), packed_color });
+            }
+   }
+
+   auto DebugDraw::sphere(glm::vec3 const& center, float const radius, glm::vec4 const& color) -> void
+   {
+      std::uint32_t const packed_color{ glm::packUnorm4x8(color) };
+
+      std::array<glm::vec2, SPHERE_SEGMENTS + 1> circle{};
+      for (std::uint32_t segment{}; segment <= SPHERE_SEGMENTS; ++segment)
+      {
+         float const angle{ glm::two_pi<float>() * segment / SPHERE_SEGMENTS };
+         circle[segment] = glm::vec2{ std::cos(angle), std::sin(angle) } * radius;
+      }
+
+      ThreadVertices& thread_vertices{ this->thread_vertices() };
+      std::lock_guard const lock{ thread_vertices.mutex };
+      thread_vertices.vertices.reserve(thread_vertices.vertices.size() + 3 * 2 * SPHERE_SEGMENTS);
+
+      // the circle around an axis lies in the plane of the two axes after it
+      for (glm::length_t axis{}; axis < 3; ++axis)
+         for (std::uint32_t segment{}; segment < SPHERE_SEGMENTS; ++segment)
+            for (std::uint32_t const next : { segment, segment + 1 })
+            {
+               glm::vec3 position{ center };
+               position[(axis + 1) % 3] += circle[next].x;
+               position[(axis + 2) % 3] += circle[next].y;
+               thread_vertices.vertices.push_back({ position, packed_color });
+            }
+   }
+
+   auto DebugDraw::frustum(glm::mat4 const& view_projection, glm::vec4 const& color) -> void
+   {
+      std::uint32_t const packed_color{ glm::packUnorm4x8(color) };
+      glm::mat4 const inverse_view_projection{ inverse(view_projection) };
+
+      // the clip volume's corners, taken back into world space
+      std::array<glm::vec3, 8> corners{};
+      for (std::uint32_t index{}; index < 8; ++index)
+      {
+         glm::vec4 const corner{
+            inverse_view_projection * glm::vec4{
+               index & 1u ? 1.0f : -1.0f,
+               index & 2u ? 1.0f : -1.0f,
+               index & 4u ? 1.0f : 0.0f,
+               1.0f
+            }
+         };
+
+         corners[index] = glm::vec3{ corner } / corner.w;
+      }
+
+      ThreadVertices& thread_vertices{ this->thread_vertices() };
+      std::lock_guard const lock{ thread_vertices.mutex };
+
+      for (std::uint32_t index{}; index < 8; ++index)
+         for (std::uint32_t const bit : { 1u, 2u, 4u })
+            if (not (index & bit))
+            {
+               thread_vertices.vertices.push_back({ corners[index], packed_color });
+               thread_vertices.vertices.push_back({ corners[index | bit], packed_color });
+            }
+   }
+
+   auto DebugDraw::update(std::uint8_t const frame_index) -> void
+   {
+      VertexBuffer& vertex_buffer{ vertex_buffers_[frame_index] };
+
+      std::lock_guard const threads_lock{ threads_mutex_ };
+
+      std::size_t vertex_count{};
+      for (std::unique_ptr<ThreadVertices> const& thread_vertices : threads_ | std::views::values)
+      {
+         std::lock_guard const lock{ thread_vertices->mutex };
+         vertex_count += thread_vertices->vertices.size();
+      }
+
+      reserve(vertex_buffer, vertex_count);
+
+      // lines queued since they were counted are left for the next frame; the lists keep their capacity, so that
+      // threads queueing as many lines every frame stop allocating
+      std::size_t offset{};
+      for (std::unique_ptr<ThreadVertices> const& thread_vertices : threads_ | std::views::values)
+      {
+         std::lock_guard const lock{ thread_vertices->mutex };
+         std::vector<LineVertex>& vertices{ thread_vertices->vertices };
+         auto const end{ vertices.begin() + static_cast<std::ptrdiff_t>(std::min(vertices.size(), vertex_count - offset)) };
+         offset = std::ranges::copy(vertices.begin(), end, vertex_buffer.vertices + offset).out - vertex_buffer.vertices;
+         vertices.erase(vertices.begin(), end);
+      }
+
+      vertex_buffer.vertex_count = static_cast<std::uint32_t>(vertex_count);
+   }
+
+   auto DebugDraw::record(vk::raii::CommandBuffer const& command_buffer, std::uint8_t const frame_index,
+      glm::mat4 const& view_projection, vk::Extent2D const extent) const -> void
+   {
+      VertexBuffer const& vertex_buffer{ vertex_buffers_[frame_index] };
+      if (not vertex_buffer.vertex_count)
+         return;
+
+      command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline_);
+      command_buffer.bindVertexBuffers(0, { *vertex_buffer.buffer }, { 0 });
+      command_buffer.pushConstants<glm::mat4>(layout_.pipeline_layout(), vk::ShaderStageFlagBits::eVertex, 0,
+         view_projection);
+
+      command_buffer.setViewport(0, {
+         {
+            .width{ static_cast<float>(extent.width) },
+            .height{ static_cast<float>(extent.height) },
+            .maxDepth{ 1.0f },
+         }
+      });
+
+      command_buffer.setScissor(0, {
+         {
+            .extent{ extent }
+         }
+      });
+
+      command_buffer.setLineWidth(line_width_);
+      command_buffer.draw(vertex_buffer.vertex_count, 1, 0, 0);
+   }
+
+   auto DebugDraw::change_line_width(float const line_width) -> void
+   {
+      RUNTIME_ASSERT(line_width > 0.0f,
+         "the line width has to be positive!");
+
+      // anything outside of the device's range, or in between its steps, would be invalid to set
+      vk::PhysicalDeviceProperties2 const properties{ context_.physical_device.getProperties2() };
+      float const minimum{ properties.properties.limits.lineWidthRange[0] };
+      float const maximum{ properties.properties.limits.lineWidthRange[1] };
+      float const granularity{ properties.properties.limits.lineWidthGranularity };
+      float const clamped_width{ std::clamp(line_width, minimum, maximum) };
+      line_width_ = granularity > 0.0f
+         ? std::min(minimum + std::round((clamped_width - minimum) / granularity) * granularity, maximum)
+         : clamped_width;
+   }
+
+   auto DebugDraw::line_width() const -> float
+   {
+      return line_width_;
+   }
+
+   auto DebugDraw::next_id() -> std::uint64_t
+   {
+      static std::atomic<std::uint64_t> next_id{ 1 };
+      return next_id++;
+   }
+
+   auto DebugDraw::thread_vertices() -> ThreadVertices&
+   {
+      // a thread only ever takes the lock below once per debug draw it queues lines to in a row, which in practice
+      // means once in its lifetime
+      thread_local std::uint64_t cached_id{};
+      thread_local ThreadVertices* cached_thread_vertices{};
+      if (cached_id == id_)
+         return *cached_thread_vertices;
+
+      std::lock_guard const lock{ threads_mutex_ };
+      std::unique_ptr<ThreadVertices>& thread_vertices{ threads_[std::this_thread::get_id()] };
+      if (not thread_vertices)
+         thread_vertices = std::make_unique<ThreadVertices>();
+
+      cached_id = id_;
+      cached_thread_vertices = thread_vertices.get();
+      return *thread_vertices;
+   }
+
+   auto DebugDraw::reserve(VertexBuffer& vertex_buffer, std::size_t const count) const -> void
+   {
+      if (count <= vertex_buffer.capacity)
+         return;
+
+      std::size_t const capacity{ std::bit_ceil(std::max(count, MINIMUM_BUFFER_CAPACITY)) };
+
+      vertex_buffer.memory.clear();
+      vertex_buffer.buffer = context_.create_buffer({
+         .size{ capacity * sizeof(LineVertex) },
+         .usage{ vk::BufferUsageFlagBits::eVertexBuffer },
+         .sharingMode{ vk::SharingMode::eExclusive }
+      });
+
+      vertex_buffer.memory = context_.allocate_memory(vertex_buffer.buffer.getMemoryRequirements(),
+         vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+
+      vk::Result const result{ vertex_buffer.buffer.bindMemory(vertex_buffer.memory, 0) };
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to bind debug draw vertex buffer's memory! ({})", to_string(result)));
+
+      vk::ResultValue const mapped_memory{ vertex_buffer.memory.mapMemory(0, vk::WholeSize) };
+      RUNTIME_ASSERT(mapped_memory.has_value(),
+         std::format("failed to map debug draw vertex buffer's memory! ({})", to_string(mapped_memory.result)));
+
+      vertex_buffer.vertices = static_cast<LineVertex*>(*mapped_memory);
+      vertex_buffer.capacity = capacity;
+   }
+
+   auto DebugDraw::layout() const -> Layout
+   {
+      std::array constexpr push_constant_ranges{
+         std::to_array<vk::PushConstantRange>({
+            {
+               .stageFlags{ vk::ShaderStageFlagBits::eVertex },
+               .offset{ 0 },
+               .size{ sizeof(glm::mat4) }
+            }
+         })
+      };
+
+      return Layout{ {
+         .sets{},
+         .push_constants{ push_constant_ranges }
+      } };
+   }
+
+   auto DebugDraw::pipeline(vk::Format const color_format, vk::Format const depth_format) const -> vk::raii::Pipeline
+   {
+      std::vector<std::uint32_t> const code{ compile_framework_shader("debug_draw.slang") };
+
+      vk::ShaderModuleCreateInfo const shader_module_create_info{
+         .codeSize{ code.size() * sizeof(decltype(code)::value_type) },
+         .pCode{ code.data() }
+      };
+
+      std::array const shader_stage_create_infos{
+         std::to_array<vk::PipelineShaderStageCreateInfo>({
+            {
+               .pNext{ &shader_module_create_info },
+               .stage{ vk::ShaderStageFlagBits::eVertex },
+               .pName{ "vertMain" }
+            },
+            {
+               .pNext{ &shader_module_create_info },
+               .stage{ vk::ShaderStageFlagBits::eFragment },
+               .pName{ "fragMain" }
+            }
+         })
+      };
+
+      std::array constexpr dynamic_states{
+         vk::DynamicState::eViewport,
+         vk::DynamicState::eScissor,
+         vk::DynamicState::eLineWidth
+      };
+
+      vk::PipelineDynamicStateCreateInfo const dynamic_state_create_info{
+         .dynamicStateCount{ static_cast<uint32_t>(std::ranges::size(dynamic_states)) },
+         .pDynamicStates{ std::ranges::data(dynamic_states) }
+      };
+
+      std::array constexpr binding_descriptions{
+         std::to_array<vk::VertexInputBindingDescription>({
+            {
+               .binding{ 0 },
+               .stride{ sizeof(LineVertex) },
+               .inputRate{ vk::VertexInputRate::eVertex }
+            }
+         })
+      };
+
+      std::array constexpr attribute_descriptions{
+         std::to_array<vk::VertexInputAttributeDescription>({
+            {
+               .location{ 0 },
+               .binding{ 0 },
+               .format{ vk::Format::eR32G32B32Sfloat },
+               .offset{ offsetof(LineVertex, position) }
+            },
+            {
+               .location{ 1 },
+               .binding{ 0 },
+               .format{ vk::Format::eR8G8B8A8Unorm },
+               .offset{ offsetof(LineVertex, color) }
+            }
+         })
+      };
+
+      vk::PipelineVertexInputStateCreateInfo const vertex_input_state_create_info{
+         .vertexBindingDescriptionCount{ static_cast<std::uint32_t>(std::ranges::size(binding_descriptions)) },
+         .pVertexBindingDescriptions{ std::ranges::data(binding_descriptions) },
+         .vertexAttributeDescriptionCount{ static_cast<std::uint32_t>(std::ranges::size(attribute_descriptions)) },
+         .pVertexAttributeDescriptions{ std::ranges::data(attribute_descriptions) }
+      };
+
+      vk::PipelineInputAssemblyStateCreateInfo constexpr input_assembly_state_create_info{
+         .topology{ vk::PrimitiveTopology::eLineList }
+      };
+
+      vk::PipelineViewportStateCreateInfo constexpr viewport_state_create_info{
+         .viewportCount{ 1 },
+         .scissorCount{ 1 }
+      };
+
+      vk::PipelineRasterizationStateCreateInfo constexpr rasterization_state_create_info{
+         .depthClampEnable{ vk::False },
+         .rasterizerDiscardEnable{ vk::False },
+         .polygonMode{ vk::PolygonMode::eFill },
+         .cullMode{ vk::CullModeFlagBits::eNone },
+         .frontFace{ vk::FrontFace::eCounterClockwise },
+         .depthBiasEnable{ vk::False },
+         .lineWidth{ 1.0f }
+      };
+
+      vk::PipelineMultisampleStateCreateInfo constexpr multisample_state_create_info{
+         .rasterizationSamples{ vk::SampleCountFlagBits::e1 },
+         .sampleShadingEnable{ vk::False }
+      };
+
+      // lines lying on a surface are drawn over it rather than fighting it
+      vk::PipelineDepthStencilStateCreateInfo constexpr depth_stencil_state_create_info{
+         .depthTestEnable{ vk::True },
+         .depthWriteEnable{ vk::False },
+         .depthCompareOp{ vk::CompareOp::eLessOrEqual },
+         .depthBoundsTestEnable{ vk::False },
+         .stencilTestEnable{ vk::False },
+      };
+
+      std::array constexpr color_blend_attachment_state{
+         std::to_array<vk::PipelineColorBlendAttachmentState>({
+            {
+               .blendEnable{ vk::True },
+               .srcColorBlendFactor{ vk::BlendFactor::eSrcAlpha },
+               .dstColorBlendFactor{ vk::BlendFactor::eOneMinusSrcAlpha },
+               .colorBlendOp{ vk::BlendOp::eAdd },
+               .srcAlphaBlendFactor{ vk::BlendFactor::eOne },
+               .dstAlphaBlendFactor{ vk::BlendFactor::eOneMinusSrcAlpha },
+               .alphaBlendOp{ vk::BlendOp::eAdd },
+               .colorWriteMask{
+                  vk::ColorComponentFlagBits::eR |
+                  vk::ColorComponentFlagBits::eG |
+                  vk::ColorComponentFlagBits::eB |
+                  vk::ColorComponentFlagBits::eA
+               }
+            }
+         })
+      };
+
+      vk::PipelineColorBlendStateCreateInfo const color_blend_state_create_info{
+         .logicOpEnable{ vk::False },
+         .logicOp{ vk::LogicOp::eCopy },
+         .attachmentCount{ static_cast<std::uint32_t>(std::ranges::size(color_blend_attachment_state)) },
+         .pAttachments{ std::ranges::data(color_blend_attachment_state) }
+      };
+
+      vk::PipelineRenderingCreateInfo const pipeline_rendering_create_info{
+         .colorAttachmentCount{ 1 },
+         .pColorAttachmentFormats{ &color_format },
+         .depthAttachmentFormat{ depth_format }
+      };
+
+      vk::ResultValue pipeline{
+         context_.device.createGraphicsPipeline(nullptr, {
+            .pNext{ &pipeline_rendering_create_info },
+            .stageCount{ static_cast<std::uint32_t>(std::ranges::size(shader_stage_create_infos)) },
+            .pStages{ std::ranges::data(shader_stage_create_infos) },
+            .pVertexInputState{ &vertex_input_state_create_info },
+            .pInputAssemblyState{ &input_assembly_state_create_info },
+            .pViewportState{ &viewport_state_create_info },
+            .pRasterizationState{ &rasterization_state_create_info },
+            .pMultisampleState{ &multisample_state_create_info },
+            .pDepthStencilState{ &depth_stencil_state_create_info },
+            .pColorBlendState{ &color_blend_state_create_info },
+            .pDynamicState{ &dynamic_state_create_info },
+            .layout{ layout_.pipeline_layout() },
+         })
+      };
+      RUNTIME_ASSERT(pipeline.has_value(),
+         std::format("failed create a debug draw pipeline! ({})", to_string(pipeline.result)));
+
+      return std::move(*pipeline);
+   }
+}
\ No newline at end of file
@@ -0,0 +1,247 @@
+#include "eruptor/context.hpp"
+#include "eruptor/depth_pyramid.hpp"
+#include "eruptor/dispatcher.hpp"
+#include "eruptor/runtime_assert.hpp"
+#include "eruptor/void_deleter.hpp"
+
+#include "core/shader.hpp"
+
+namespace eru
+{
+   DepthPyramid::DepthPyramid() = default;
+
+   auto DepthPyramid::resize(vk::Extent2D const extent) -> UniquePointer<void>
+   {
+      if (extent == extent_)
+         return {};
+
+      // in member order, so that the views are destroyed first
+      struct Retired final
+      {
+         vk::raii::Image image;
+         vk::raii::DeviceMemory image_memory;
+         vk::raii::ImageView image_view;
+         std::vector<vk::raii::ImageView> level_image_views;
+      };
+
+      UniquePointer<void> retired{
+         new Retired{
+            std::move(image_),
+            std::move(image_memory_),
+            std::move(image_view_),
+            std::exchange(level_image_views_, {})
+         },
+         void_deleter<Retired>
+      };
+
+      // down to a single texel, as far away objects can cover very little of the screen
+      level_count_ = static_cast<std::uint32_t>(std::bit_width(std::max(extent.width, extent.height)));
+      image_ = image(extent, level_count_);
+      image_memory_ = image_memory();
+
+      vk::Result const result{ image_.bindMemory(image_memory_, 0) };
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to bind depth pyramid's memory! ({})", to_string(result)));
+
+      image_view_ = image_view(0, level_count_);
+      level_image_views_.reserve(level_count_);
+      for (std::uint32_t level{}; level < level_count_; ++level)
+         level_image_views_.push_back(image_view(level, 1));
+
+      extent_ = extent;
+      return retired;
+   }
+
+   auto DepthPyramid::build(vk::raii::CommandBuffer const& command_buffer, vk::Image const depth_image,
+      vk::ImageView const depth_image_view) const -> void
+   {
+      RUNTIME_ASSERT(level_count_,
+         "the depth pyramid has not been sized yet!");
+
+      // every level is overwritten, so whatever the previous frame left behind can be discarded
+      vk::ImageMemoryBarrier2 const begin_barrier{
+         .srcStageMask{ vk::PipelineStageFlagBits2::eComputeShader },
+         .srcAccessMask{ vk::AccessFlagBits2::eNone },
+         .dstStageMask{ vk::PipelineStageFlagBits2::eComputeShader },
+         .dstAccessMask{ vk::AccessFlagBits2::eShaderStorageWrite },
+         .oldLayout{ vk::ImageLayout::eUndefined },
+         .newLayout{ vk::ImageLayout::eGeneral },
+         .image{ image_ },
+         .subresourceRange{
+            .aspectMask{ vk::ImageAspectFlagBits::eColor },
+            .levelCount{ level_count_ },
+            .layerCount{ 1 }
+         }
+      };
+
+      command_buffer.pipelineBarrier2({
+         .imageMemoryBarrierCount{ 1 },
+         .pImageMemoryBarriers{ &begin_barrier }
+      });
+
+      auto const level_extent{
+         [this](std::uint32_t const level) -> glm::uvec2
+         {
+            return { std::max(extent_.width >> level, 1u), std::max(extent_.height >> level, 1u) };
+         }
+      };
+
+      // every level reads the one before it, so the dispatcher puts a barrier between each of them
+      Dispatcher dispatcher{};
+      for (std::uint32_t level{}; level < level_count_; ++level)
+      {
+         // the first level is a copy of the depth buffer itself, every next one reduces the one before it
+         std::array const images{
+            std::to_array<Dispatcher::ImageBinding>({
+               {
+                  .binding{ 0 },
+                  .type{ vk::DescriptorType::eSampledImage },
+                  .image{ level ? *image_ : depth_image },
+                  .image_view{ level ? *level_image_views_[level - 1] : depth_image_view },
+                  .layout{ level ? vk::ImageLayout::eGeneral : vk::ImageLayout::eShaderReadOnlyOptimal },
+                  .access{ Dispatcher::Access::READ }
+               },
+               {
+                  .binding{ 1 },
+                  .type{ vk::DescriptorType::eStorageImage },
+                  .image{ image_ },
+                  .image_view{ level_image_views_[level] },
+                  .layout{ vk::ImageLayout::eGeneral },
+                  .access{ Dispatcher::Access::WRITE }
+               }
+            })
+         };
+
+         ReduceConstants const reduce_constants{
+            .source_size{ level ? level_extent(level - 1) : level_extent(0) },
+            .destination_size{ level_extent(level) }
+         };
+
+         dispatcher.dispatch({
+            .pipeline{ pipeline_ },
+            .thread_count{ reduce_constants.destination_size, 1 },
+            .images{ images },
+            .push_constants{ std::as_bytes(std::span{ &reduce_constants, 1 }) }
+         });
+      }
+
+      // for whoever reads the pyramid once it is built
+      dispatcher.record(command_buffer, vk::PipelineStageFlagBits2::eComputeShader, vk::AccessFlagBits2::eShaderSampledRead);
+   }
+
+   auto DepthPyramid::image_view() const -> vk::ImageView
+   {
+      return image_view_;
+   }
+
+   auto DepthPyramid::extent() const -> vk::Extent2D
+   {
+      return extent_;
+   }
+
+   auto DepthPyramid::level_count() const -> std::uint32_t
+   {
+      return level_count_;
+   }
+
+   auto DepthPyramid::layout() const -> Layout
+   {
+      std::array constexpr bindings{
+         std::to_array<vk::DescriptorSetLayoutBinding>({
+            {
+               .binding{ 0 },
+               .descriptorType{ vk::DescriptorType::eSampledImage },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            },
+            {
+               .binding{ 1 },
+               .descriptorType{ vk::DescriptorType::eStorageImage },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            }
+         })
+      };
+
+      std::array const sets{
+         std::to_array<std::span<vk::DescriptorSetLayoutBinding const>>({
+            bindings
+         })
+      };
+
+      std::array constexpr push_constant_ranges{
+         std::to_array<vk::PushConstantRange>({
+            {
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute },
+               .offset{ 0 },
+               .size{ sizeof(ReduceConstants) }
+            }
+         })
+      };
+
+      // pushed per level, as every level is read as the source of the next one
+      return Layout{ {
+         .sets{ sets },
+         .push_constants{ push_constant_ranges },
+         .push_descriptor_set{ 0 }
+      } };
+   }
+
+   auto DepthPyramid::pipeline() const -> ComputePipeline
+   {
+      return { layout_, compile_framework_shader("depth_pyramid.slang"), "reduceMain" };
+   }
+
+   auto DepthPyramid::image(vk::Extent2D const extent, std::uint32_t const level_count) const -> vk::raii::Image
+   {
+      vk::ResultValue image{
+         context_.device.createImage({
+            .imageType{ vk::ImageType::e2D },
+            .format{ FORMAT },
+            .extent{
+               .width{ extent.width },
+               .height{ extent.height },
+               .depth{ 1 }
+            },
+            .mipLevels{ level_count },
+            .arrayLayers{ 1 },
+            .samples{ vk::SampleCountFlagBits::e1 },
+            .tiling{ vk::ImageTiling::eOptimal },
+            .usage{ vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eSampled },
+            .sharingMode{ vk::SharingMode::eExclusive },
+            .initialLayout{ vk::ImageLayout::eUndefined },
+         })
+      };
+      RUNTIME_ASSERT(image.result == vk::Result::eSuccess,
+         std::format("failed to create depth pyramid image! ({})", to_string(image.result)));
+
+      return std::move(*image);
+   }
+
+   auto DepthPyramid::image_memory() const -> vk::raii::DeviceMemory
+   {
+      return context_.allocate_memory(image_.getMemoryRequirements(), vk::MemoryPropertyFlagBits::eDeviceLocal);
+   }
+
+   auto DepthPyramid::image_view(std::uint32_t const first_level, std::uint32_t const level_count) const -> vk::raii::ImageView
+   {
+      vk::ResultValue image_view{
+         context_.device.createImageView({
+            .image{ image_ },
+            .viewType{ vk::ImageViewType::e2D },
+            .format{ FORMAT },
+            .subresourceRange{
+               .aspectMask{ vk::ImageAspectFlagBits::eColor },
+               .baseMipLevel{ first_level },
+               .levelCount{ level_count },
+               .baseArrayLayer{ 0 },
+               .layerCount{ 1 }
+            }
+         })
+      };
+      RUNTIME_ASSERT(image_view.result == vk::Result::eSuccess,
+         std::format("failed to create depth pyramid image view! ({})", to_string(image_view.result)));
+
+      return std::move(*image_view);
+   }
+}
\ No newline at end of file
@@ -0,0 +1,252 @@
+#include "eruptor/dispatcher.hpp"
+#include "eruptor/runtime_assert.hpp"
+
+namespace eru
+{
+   auto Dispatcher::dispatch(Dispatch const& dispatch) -> void
+   {
+      std::uint32_t level{};
+      auto const depend{
+         [&level](auto const& states, auto const resource, Access const access)
+         {
+            auto const state{ states.find(resource) };
+            if (state == states.end())
+               return;
+
+            if (state->second.written_level)
+               level = std::max(level, *state->second.written_level + 1);
+
+            if (writes(access) and state->second.read_level)
+               level = std::max(level, *state->second.read_level + 1);
+         }
+      };
+
+      auto const track{
+         [&level](ResourceState& state, Access const access)
+         {
+            if (writes(access))
+            {
+               state.written_level = level;
+               state.read_level.reset();
+            }
+            else
+               state.read_level = std::max(state.read_level.value_or(0), level);
+         }
+      };
+
+      for (BufferBinding const& buffer : dispatch.buffers)
+         depend(buffer_states_, buffer.buffer, buffer.access);
+
+      for (ImageBinding const& image : dispatch.images)
+         if (image.image)
+            depend(image_states_, image.image, image.access);
+
+      for (BufferBinding const& buffer : dispatch.buffers)
+         track(buffer_states_[buffer.buffer], buffer.access);
+
+      for (ImageBinding const& image : dispatch.images)
+         if (image.image)
+            track(image_states_[image.image], image.access);
+
+      std::vector<BufferBinding> buffers{};
+      buffers.append_range(dispatch.buffers);
+      std::vector<ImageBinding> images{};
+      images.append_range(dispatch.images);
+      std::vector<std::byte> push_constants{};
+      push_constants.append_range(dispatch.push_constants);
+
+      dispatches_.push_back({
+         .pipeline{ &dispatch.pipeline },
+         .group_count{ dispatch.pipeline.group_count(dispatch.thread_count) },
+         .buffers{ std::move(buffers) },
+         .images{ std::move(images) },
+         .push_constants{ std::move(push_constants) },
+         .level{ level }
+      });
+   }
+
+   auto Dispatcher::record(vk::raii::CommandBuffer const& command_buffer, vk::PipelineStageFlags2 const consumer_stages,
+      vk::AccessFlags2 const consumer_access) -> void
+   {
+      // within a level, dispatches are independent of one another, so they can be ordered to bind each pipeline once
+      std::vector<std::size_t> order(dispatches_.size());
+      for (std::size_t index{}; index < order.size(); ++index)
+         order[index] = index;
+
+      std::ranges::stable_sort(order, {},
+         [this](std::size_t const index)
+         {
+            QueuedDispatch const& dispatch{ dispatches_[index] };
+            return std::pair{ dispatch.level, dispatch.pipeline };
+         });
+
+      LevelWrites level_writes{};
+      std::optional<std::uint32_t> level{};
+      ComputePipeline const* bound_pipeline{};
+      for (std::size_t const index : order)
+      {
+         QueuedDispatch const& dispatch{ dispatches_[index] };
+         if (level not_eq dispatch.level)
+         {
+            if (level)
+               record_barrier(command_buffer, level_writes);
+
+            level = dispatch.level;
+         }
+
+         if (bound_pipeline not_eq dispatch.pipeline)
+         {
+            command_buffer.bindPipeline(vk::PipelineBindPoint::eCompute, dispatch.pipeline->pipeline());
+            bound_pipeline = dispatch.pipeline;
+         }
+
+         record_dispatch(command_buffer, dispatch);
+
+         // a resource is only ever written by a single dispatch per level
+         for (BufferBinding const& buffer : dispatch.buffers)
+            if (writes(buffer.access))
+               level_writes.buffers.push_back({
+                  .buffer{ buffer.buffer },
+                  .offset{ buffer.offset },
+                  .size{ buffer.range }
+               });
+
+         for (ImageBinding const& image : dispatch.images)
+            if (image.image and writes(image.access))
+               level_writes.images.push_back({
+                  .oldLayout{ image.layout },
+                  .newLayout{ image.layout },
+                  .image{ image.image },
+                  .subresourceRange{
+                     .aspectMask{ vk::ImageAspectFlagBits::eColor },
+                     .levelCount{ vk::RemainingMipLevels },
+                     .layerCount{ vk::RemainingArrayLayers }
+                  }
+               });
+      }
+
+      // earlier levels' writes were only made visible to the levels above them, so this covers all of them at once
+      if (level and consumer_stages not_eq vk::PipelineStageFlagBits2::eNone)
+      {
+         vk::MemoryBarrier2 const consumer_barrier{
+            .srcStageMask{ vk::PipelineStageFlagBits2::eComputeShader },
+            .srcAccessMask{ vk::AccessFlagBits2::eShaderWrite },
+            .dstStageMask{ consumer_stages },
+            .dstAccessMask{ consumer_access }
+         };
+
+         command_buffer.pipelineBarrier2({
+            .memoryBarrierCount{ 1 },
+            .pMemoryBarriers{ &consumer_barrier }
+         });
+      }
+
+      dispatches_.clear();
+      buffer_states_.clear();
+      image_states_.clear();
+   }
+
+   auto Dispatcher::writes(Access const access) -> bool
+   {
+      return access not_eq Access::READ;
+   }
+
+   auto Dispatcher::record_dispatch(vk::raii::CommandBuffer const& command_buffer, QueuedDispatch const& dispatch) const -> void
+   {
+      Layout const& layout{ dispatch.pipeline->layout() };
+
+      if (not dispatch.buffers.empty() or not dispatch.images.empty())
+      {
+         RUNTIME_ASSERT(layout.push_descriptor_set(),
+            "the dispatch has bindings, but its pipeline's layout has no push descriptor set!");
+
+         // reserved up front, as the writes point into them
+         std::vector<vk::DescriptorBufferInfo> buffer_infos{};
+         buffer_infos.reserve(dispatch.buffers.size());
+         std::vector<vk::DescriptorImageInfo> image_infos{};
+         image_infos.reserve(dispatch.images.size());
+
+         std::vector<vk::WriteDescriptorSet> writes{};
+         writes.reserve(dispatch.buffers.size() + dispatch.images.size());
+
+         for (BufferBinding const& buffer : dispatch.buffers)
+            writes.push_back({
+               .dstBinding{ buffer.binding },
+               .descriptorCount{ 1 },
+               .descriptorType{ buffer.type },
+               .pBufferInfo{
+                  &buffer_infos.emplace_back(vk::DescriptorBufferInfo{
+                     .buffer{ buffer.buffer },
+                     .offset{ buffer.offset },
+                     .range{ buffer.range }
+                  })
+               }
+            });
+
+         for (ImageBinding const& image : dispatch.images)
+            writes.push_back({
+               .dstBinding{ image.binding },
+               .descriptorCount{ 1 },
+               .descriptorType{ image.type },
+               .pImageInfo{
+                  &image_infos.emplace_back(vk::DescriptorImageInfo{
+                     .sampler{ image.sampler },
+                     .imageView{ image.image_view },
+                     .imageLayout{ image.layout }
+                  })
+               }
+            });
+
+         command_buffer.pushDescriptorSet(vk::PipelineBindPoint::eCompute, layout.pipeline_layout(),
+            *layout.push_descriptor_set(), writes);
+      }
+
+      if (not dispatch.push_constants.empty())
+         command_buffer.pushConstants<std::byte>(layout.pipeline_layout(), vk::ShaderStageFlagBits::eCompute, 0,
+            dispatch.push_constants);
+
+      command_buffer.dispatch(dispatch.group_count.x, dispatch.group_count.y, dispatch.group_count.z);
+   }
+
+   auto Dispatcher::record_barrier(vk::raii::CommandBuffer const& command_buffer, LevelWrites& level_writes) -> void
+   {
+      // any one barrier also orders every dispatch of the level before it with every one after it
+      vk::PipelineStageFlags2 constexpr stages{ vk::PipelineStageFlagBits2::eComputeShader };
+      vk::AccessFlags2 constexpr destination_access{ vk::AccessFlagBits2::eShaderRead | vk::AccessFlagBits2::eShaderWrite };
+
+      for (vk::BufferMemoryBarrier2& barrier : level_writes.buffers)
+      {
+         barrier.srcStageMask = stages;
+         barrier.srcAccessMask = vk::AccessFlagBits2::eShaderWrite;
+         barrier.dstStageMask = stages;
+         barrier.dstAccessMask = destination_access;
+      }
+
+      for (vk::ImageMemoryBarrier2& barrier : level_writes.images)
+      {
+         barrier.srcStageMask = stages;
+         barrier.srcAccessMask = vk::AccessFlagBits2::eShaderWrite;
+         barrier.dstStageMask = stages;
+         barrier.dstAccessMask = destination_access;
+      }
+
+      // a level that only read still has to finish before the next one overwrites what it read
+      vk::MemoryBarrier2 constexpr execution_barrier{
+         .srcStageMask{ stages },
+         .dstStageMask{ stages }
+      };
+
+      bool const wrote{ not level_writes.buffers.empty() or not level_writes.images.empty() };
+      command_buffer.pipelineBarrier2({
+         .memoryBarrierCount{ wrote ? 0u : 1u },
+         .pMemoryBarriers{ &execution_barrier },
+         .bufferMemoryBarrierCount{ static_cast<std::uint32_t>(level_writes.buffers.size()) },
+         .pBufferMemoryBarriers{ level_writes.buffers.data() },
+         .imageMemoryBarrierCount{ static_cast<std::uint32_t>(level_writes.images.size()) },
+         .pImageMemoryBarriers{ level_writes.images.data() }
+      });
+
+      level_writes.buffers.clear();
+      level_writes.images.clear();
+   }
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "eruptor/draw_queue.hpp"
+#include "eruptor/exception.hpp"
+
+namespace eru
+{
+   auto DrawQueue::Key::packed() const -> std::uint64_t
+   {
+      // checked in every build, as a field out of range silently corrupts the order rather than failing
+      if (material >= 1u << MATERIAL_BITS or mesh >= 1u << MESH_BITS)
+         throw Exception{
+            std::format("material {} or mesh {} does not fit in a draw queue key of {} and {} bits!", material, mesh,
+               MATERIAL_BITS, MESH_BITS)
+         };
+
+      // non-negative floats order the same as their bit patterns
+      std::uint64_t const depth_bits{ std::bit_cast<std::uint32_t>(std::max(depth, 0.0f)) };
+
+      return
+         static_cast<std::uint64_t>(material) << (MESH_BITS + DEPTH_BITS) |
+         static_cast<std::uint64_t>(mesh) << DEPTH_BITS |
+         depth_bits;
+   }
+
+   auto DrawQueue::reserve(std::size_t const count) -> void
+   {
+      entries_.reserve(count);
+   }
+
+   auto DrawQueue::push(Key const& key, std::uint32_t const index) -> void
+   {
+      entries_.push_back({ .key{ key.packed() }, .index{ index } });
+   }
+
+   auto DrawQueue::sort() -> void
+   {
+      submission_state_changes_ = state_changes(entries_);
+
+      // every histogram is gathered in one sweep, so the keys are only read once more per pass that actually moves them
+      std::array<std::array<std::size_t, RADIX_SIZE>, RADIX_PASSES> histograms{};
+      for (Entry const& entry : entries_)
+         for (std::size_t pass{}; pass < RADIX_PASSES; ++pass)
+            ++histograms[pass][entry.key >> pass * RADIX_BITS & (RADIX_SIZE - 1)];
+
+      scratch_.resize(entries_.size());
+      for (std::size_t pass{}; pass < RADIX_PASSES; ++pass)
+      {
+         std::array<std::size_t, RADIX_SIZE>& histogram{ histograms[pass] };
+
+         // a digit shared by all keys leaves the order untouched
+         if (std::ranges::find(histogram, entries_.size()) not_eq histogram.end())
+            continue;
+
+         std::size_t offset{};
+         for (std::size_t& count : histogram)
+            offset += std::exchange(count, offset);
+
+         for (Entry const& entry : entries_)
+            scratch_[histogram[entry.key >> pass * RADIX_BITS & (RADIX_SIZE - 1)]++] = entry;
+
+         entries_.swap(scratch_);
+      }
+
+      sorted_state_changes_ = state_changes(entries_);
+   }
+
+   auto DrawQueue::clear() -> void
+   {
+      entries_.clear();
+      submission_state_changes_ = {};
+      sorted_state_changes_ = {};
+   }
+
+   auto DrawQueue::entries() const -> std::span<Entry const>
+   {
+      return entries_;
+   }
+
+   auto DrawQueue::submission_state_changes() const -> StateChanges const&
+   {
+      return submission_state_changes_;
+   }
+
+   auto DrawQueue::sorted_state_changes() const -> StateChanges const&
+   {
+      return sorted_state_changes_;
+   }
+
+   auto DrawQueue::state_changes(std::span<Entry const> const entries) -> StateChanges
+   {
+      if (entries.empty())
+         return {};
+
+      // the first entry binds everything
+      StateChanges state_changes{ .materials{ 1 }, .meshes{ 1 } };
+      for (std::size_t index{ 1 }; index < entries.size(); ++index)
+      {
+         std::uint64_t const changed{ entries[index].key ^ entries[index - 1].key };
+         if (changed & Key::MATERIAL_MASK)
+            ++state_changes.materials;
+
+         if (changed & Key::MESH_MASK)
+            ++state_changes.meshes;
+      }
+
+      return state_changes;
+   }
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "eruptor/context.hpp"
+#include "eruptor/frame_pacer.hpp"
+#include "eruptor/runtime_assert.hpp"
+#include "eruptor/swap_chain.hpp"
+
+namespace eru
+{
+   FramePacer::FramePacer(Description const& description)
+   {
+      change_max_queued_frames(description.max_queued_frames);
+      change_target_frame_rate(description.target_frame_rate);
+   }
+
+   auto FramePacer::pace(SwapChain const& swap_chain) -> void
+   {
+      // of the frames presented so far, only the latest ones up to the limit may still be on their way to the screen
+      if (context_.present_wait_support and last_present_id_ > max_queued_frames_)
+      {
+         std::uint64_t const waited_present_id{ last_present_id_ - max_queued_frames_ };
+         if (swap_chain.wait_for_present(waited_present_id, PRESENT_TIMEOUT)
+            and waited_present_id > last_measured_present_id_)
+            measure(waited_present_id, Clock::now(), false);
+      }
+
+      if (target_frame_rate_)
+      {
+         Clock::duration const frame_time{
+            std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>{ 1.0 / *target_frame_rate_ })
+         };
+
+         sleep_until(next_deadline_);
+
+         // a frame that begins late pushes back the ones after it, rather than having them catch up in a burst
+         next_deadline_ = std::max(next_deadline_, Clock::now()) + frame_time;
+      }
+
+      begin_times_[(last_present_id_ + 1) % begin_times_.size()] = Clock::now();
+   }
+
+   auto FramePacer::present_id() const -> std::uint64_t
+   {
+      return context_.present_wait_support ? last_present_id_ + 1 : 0;
+   }
+
+   auto FramePacer::presented() -> void
+   {
+      ++last_present_id_;
+
+      if (not context_.present_wait_support)
+         measure(last_present_id_, Clock::now(), true);
+   }
+
+   auto FramePacer::change_max_queued_frames(std::uint32_t const max_queued_frames) -> void
+   {
+      RUNTIME_ASSERT(max_queued_frames <= MAX_QUEUED_FRAMES,
+         std::format("{} queued frames exceed the maximum of {}!", max_queued_frames, MAX_QUEUED_FRAMES));
+
+      max_queued_frames_ = max_queued_frames;
+   }
+
+   auto FramePacer::max_queued_frames() const -> std::uint32_t
+   {
+      return max_queued_frames_;
+   }
+
+   auto FramePacer::change_target_frame_rate(std::optional<double> const target_frame_rate) -> void
+   {
+      RUNTIME_ASSERT(not target_frame_rate or *target_frame_rate > 0.0,
+         "the target frame rate has to be positive!");
+
+      target_frame_rate_ = target_frame_rate;
+   }
+
+   auto FramePacer::target_frame_rate() const -> std::optional<double>
+   {
+      return target_frame_rate_;
+   }
+
+   auto FramePacer::measurements() const -> Measurements const&
+   {
+      return measurements_;
+   }
+
+   auto FramePacer::sleep_until(Clock::time_point const deadline) -> void
+   {
+      Clock::time_point const sleep_start{ Clock::now() };
+      if (Clock::duration const sleep_time{ deadline - sleep_overshoot_ - sleep_start };
+         sleep_time > Clock::duration::zero())
+      {
+         std::this_thread::sleep_for(sleep_time);
+
+         // follows a longer oversleep right away, but only slowly trusts the system to oversleep less
+         Clock::duration const overshoot{ std::max(Clock::now() - sleep_start - sleep_time, Clock::duration::zero()) };
+         sleep_overshoot_ = overshoot > sleep_overshoot_
+            ? overshoot
+            : (sleep_overshoot_ * 7 + overshoot) / 8;
+      }
+
+      // whatever is left is too short to trust a sleep with
+      while (Clock::now() < deadline)
+         std::this_thread::yield();
+   }
+
+   auto FramePacer::measure(std::uint64_t const present_id, Clock::time_point const present_time, bool const estimated)
+      -> void
+   {
+      // presents waited on can be more than one apart, when fewer frames were queued than allowed
+      Clock::duration const present_interval{
+         last_measured_present_id_
+            ? (present_time - last_present_time_) / static_cast<Clock::rep>(present_id - last_measured_present_id_)
+            : Clock::duration::zero()
+      };
+
+      Clock::duration latency{ present_time - begin_times_[present_id % begin_times_.size()] };
+      if (estimated)
+         latency += present_interval * max_queued_frames_;
+
+      measurements_ = {
+         .present_interval{ present_interval },
+         .latency{ latency },
+         .estimated{ estimated }
+      };
+
+      last_measured_present_id_ = present_id;
+      last_present_time_ = present_time;
+   }
+}
\ No newline at end of file
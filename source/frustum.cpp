@@ -0,0 +1,30 @@
+#include "eruptor/frustum.hpp"
+
+namespace eru
+{
+   Frustum::Frustum(glm::mat4 const& view_projection)
+   {
+      glm::vec4 const row_0{ glm::row(view_projection, 0) };
+      glm::vec4 const row_1{ glm::row(view_projection, 1) };
+      glm::vec4 const row_2{ glm::row(view_projection, 2) };
+      glm::vec4 const row_3{ glm::row(view_projection, 3) };
+
+      // clip space depth runs from 0 to 1, so the near plane is the depth row on its own
+      planes_ = {
+         row_3 + row_0,
+         row_3 - row_0,
+         row_3 + row_1,
+         row_3 - row_1,
+         row_2,
+         row_3 - row_2
+      };
+
+      for (glm::vec4& plane : planes_)
+         plane /= glm::length(glm::vec3{ plane });
+   }
+
+   auto Frustum::planes() const -> std::array<glm::vec4, 6> const&
+   {
+      return planes_;
+   }
+}
\ No newline at end of file
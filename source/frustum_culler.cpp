@@ -0,0 +1,239 @@
+#include "eruptor/frustum_culler.hpp"
+#include "eruptor/runtime_assert.hpp"
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+   #include <immintrin.h>
+#endif
+
+namespace eru
+{
+   auto FrustumCuller::reserve(std::size_t const count) -> void
+   {
+      for (std::vector<float>* const stream : {
+         &center_x_, &center_y_, &center_z_, &radius_,
+         &minimum_x_, &minimum_y_, &minimum_z_, &maximum_x_, &maximum_y_, &maximum_z_ })
+         stream->reserve(count);
+   }
+
+   auto FrustumCuller::push(Sphere const& sphere, Box const& box) -> std::uint32_t
+   {
+      center_x_.push_back(sphere.center.x);
+      center_y_.push_back(sphere.center.y);
+      center_z_.push_back(sphere.center.z);
+      radius_.push_back(sphere.radius);
+      minimum_x_.push_back(box.minimum.x);
+      minimum_y_.push_back(box.minimum.y);
+      minimum_z_.push_back(box.minimum.z);
+      maximum_x_.push_back(box.maximum.x);
+      maximum_y_.push_back(box.maximum.y);
+      maximum_z_.push_back(box.maximum.z);
+
+      return static_cast<std::uint32_t>(size() - 1);
+   }
+
+   auto FrustumCuller::change(std::uint32_t const object, Sphere const& sphere, Box const& box) -> void
+   {
+      RUNTIME_ASSERT(object < size(),
+         std::format("object {} does not exist!", object));
+
+      center_x_[object] = sphere.center.x;
+      center_y_[object] = sphere.center.y;
+      center_z_[object] = sphere.center.z;
+      radius_[object] = sphere.radius;
+      minimum_x_[object] = box.minimum.x;
+      minimum_y_[object] = box.minimum.y;
+      minimum_z_[object] = box.minimum.z;
+      maximum_x_[object] = box.maximum.x;
+      maximum_y_[object] = box.maximum.y;
+      maximum_z_[object] = box.maximum.z;
+   }
+
+   auto FrustumCuller::clear() -> void
+   {
+      for (std::vector<float>* const stream : {
+         &center_x_, &center_y_, &center_z_, &radius_,
+         &minimum_x_, &minimum_y_, &minimum_z_, &maximum_x_, &maximum_y_, &maximum_z_ })
+         stream->clear();
+   }
+
+   auto FrustumCuller::size() const -> std::size_t
+   {
+      return radius_.size();
+   }
+
+   auto FrustumCuller::cull(Frustum const& frustum, Bounds const bounds, std::span<std::uint8_t> const visibility) const -> void
+   {
+      std::size_t const object_count{ size() };
+      RUNTIME_ASSERT(visibility.size() >= object_count,
+         std::format("visibility only covers {} of {} objects!", visibility.size(), object_count));
+
+      std::size_t const chunk_count{
+         std::min(thread_pool_.thread_count(), (object_count + MINIMUM_OBJECTS_PER_CHUNK - 1) / MINIMUM_OBJECTS_PER_CHUNK)
+      };
+
+      thread_pool_.execute(chunk_count,
+         [&](std::size_t const chunk_index, std::size_t) -> void
+         {
+            std::size_t const begin{ chunk_index * object_count / chunk_count / CHUNK_ALIGNMENT * CHUNK_ALIGNMENT };
+            std::size_t const end{
+               chunk_index + 1 == chunk_count
+                  ? object_count
+                  : (chunk_index + 1) * object_count / chunk_count / CHUNK_ALIGNMENT * CHUNK_ALIGNMENT
+            };
+
+            if (bounds == Bounds::SPHERES)
+               cull_spheres(frustum.planes(), begin, end, visibility);
+            else
+               cull_boxes(frustum.planes(), begin, end, visibility);
+         });
+   }
+
+   auto FrustumCuller::cull_spheres(std::array<glm::vec4, 6> const& planes, std::size_t const begin, std::size_t const end,
+      std::span<std::uint8_t> const visibility) const -> void
+   {
+      std::size_t index{ begin };
+
+#if defined(__AVX2__)
+      for (; index + 8 <= end; index += 8)
+      {
+         __m256 const x{ _mm256_loadu_ps(center_x_.data() + index) };
+         __m256 const y{ _mm256_loadu_ps(center_y_.data() + index) };
+         __m256 const z{ _mm256_loadu_ps(center_z_.data() + index) };
+         __m256 const negative_radius{ _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(radius_.data() + index)) };
+
+         __m256 inside{ _mm256_castsi256_ps(_mm256_set1_epi32(-1)) };
+         for (glm::vec4 const& plane : planes)
+         {
+            __m256 const distance{
+               _mm256_add_ps(
+                  _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.x), x), _mm256_mul_ps(_mm256_set1_ps(plane.y), y)),
+                  _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.z), z), _mm256_set1_ps(plane.w)))
+            };
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negative_radius, _CMP_GE_OQ));
+         }
+
+         int const mask{ _mm256_movemask_ps(inside) };
+         for (std::size_t lane{}; lane < 8; ++lane)
+            visibility[index + lane] = static_cast<std::uint8_t>(mask >> lane & 1);
+      }
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+      for (; index + 4 <= end; index += 4)
+      {
+         __m128 const x{ _mm_loadu_ps(center_x_.data() + index) };
+         __m128 const y{ _mm_loadu_ps(center_y_.data() + index) };
+         __m128 const z{ _mm_loadu_ps(center_z_.data() + index) };
+         __m128 const negative_radius{ _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius_.data() + index)) };
+
+         __m128 inside{ _mm_castsi128_ps(_mm_set1_epi32(-1)) };
+         for (glm::vec4 const& plane : planes)
+         {
+            __m128 const distance{
+               _mm_add_ps(
+                  _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), x), _mm_mul_ps(_mm_set1_ps(plane.y), y)),
+                  _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.z), z), _mm_set1_ps(plane.w)))
+            };
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negative_radius));
+         }
+
+         int const mask{ _mm_movemask_ps(inside) };
+         for (std::size_t lane{}; lane < 4; ++lane)
+            visibility[index + lane] = static_cast<std::uint8_t>(mask >> lane & 1);
+      }
+#endif
+
+      for (; index < end; ++index)
+      {
+         bool inside{ true };
+         for (glm::vec4 const& plane : planes)
+            inside = inside and
+               plane.x * center_x_[index] + plane.y * center_y_[index] + plane.z * center_z_[index] + plane.w >= -radius_[index];
+
+         visibility[index] = inside;
+      }
+   }
+
+   auto FrustumCuller::cull_boxes(std::array<glm::vec4, 6> const& planes, std::size_t const begin, std::size_t const end,
+      std::span<std::uint8_t> const visibility) const -> void
+   {
+      // a box is outside a plane when the corner farthest along its normal is, and which corner that is only depends on the
+      // plane, so every plane reads its own choice of streams rather than selecting per object
+      std::array<std::array<float const*, 3>, 6> corners{};
+      for (std::size_t plane_index{}; plane_index < planes.size(); ++plane_index)
+      {
+         glm::vec4 const& plane{ planes[plane_index] };
+         corners[plane_index] = {
+            plane.x >= 0.0f ? maximum_x_.data() : minimum_x_.data(),
+            plane.y >= 0.0f ? maximum_y_.data() : minimum_y_.data(),
+            plane.z >= 0.0f ? maximum_z_.data() : minimum_z_.data()
+         };
+      }
+
+      std::size_t index{ begin };
+
+#if defined(__AVX2__)
+      for (; index + 8 <= end; index += 8)
+      {
+         __m256 inside{ _mm256_castsi256_ps(_mm256_set1_epi32(-1)) };
+         for (std::size_t plane_index{}; plane_index < planes.size(); ++plane_index)
+         {
+            glm::vec4 const& plane{ planes[plane_index] };
+            std::array<float const*, 3> const& corner{ corners[plane_index] };
+
+            __m256 const distance{
+               _mm256_add_ps(
+                  _mm256_add_ps(
+                     _mm256_mul_ps(_mm256_set1_ps(plane.x), _mm256_loadu_ps(corner[0] + index)),
+                     _mm256_mul_ps(_mm256_set1_ps(plane.y), _mm256_loadu_ps(corner[1] + index))),
+                  _mm256_add_ps(
+                     _mm256_mul_ps(_mm256_set1_ps(plane.z), _mm256_loadu_ps(corner[2] + index)),
+                     _mm256_set1_ps(plane.w)))
+            };
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+         }
+
+         int const mask{ _mm256_movemask_ps(inside) };
+         for (std::size_t lane{}; lane < 8; ++lane)
+            visibility[index + lane] = static_cast<std::uint8_t>(mask >> lane & 1);
+      }
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+      for (; index + 4 <= end; index += 4)
+      {
+         __m128 inside{ _mm_castsi128_ps(_mm_set1_epi32(-1)) };
+         for (std::size_t plane_index{}; plane_index < planes.size(); ++plane_index)
+         {
+            glm::vec4 const& plane{ planes[plane_index] };
+            std::array<float const*, 3> const& corner{ corners[plane_index] };
+
+            __m128 const distance{
+               _mm_add_ps(
+                  _mm_add_ps(
+                     _mm_mul_ps(_mm_set1_ps(plane.x), _mm_loadu_ps(corner[0] + index)),
+                     _mm_mul_ps(_mm_set1_ps(plane.y), _mm_loadu_ps(corner[1] + index))),
+                  _mm_add_ps(
+                     _mm_mul_ps(_mm_set1_ps(plane.z), _mm_loadu_ps(corner[2] + index)),
+                     _mm_set1_ps(plane.w)))
+            };
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+         }
+
+         int const mask{ _mm_movemask_ps(inside) };
+         for (std::size_t lane{}; lane < 4; ++lane)
+            visibility[index + lane] = static_cast<std::uint8_t>(mask >> lane & 1);
+      }
+#endif
+
+      for (; index < end; ++index)
+      {
+         bool inside{ true };
+         for (std::size_t plane_index{}; plane_index < planes.size(); ++plane_index)
+         {
+            glm::vec4 const& plane{ planes[plane_index] };
+            std::array<float const*, 3> const& corner{ corners[plane_index] };
+            inside = inside and
+               plane.x * corner[0][index] + plane.y * corner[1][index] + plane.z * corner[2][index] + plane.w >= 0.0f;
+         }
+
+         visibility[index] = inside;
+      }
+   }
+}
\ No newline at end of file
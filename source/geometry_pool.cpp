@@ -0,0 +1,173 @@
+#include "eruptor/context.hpp"
+#include "eruptor/geometry_pool.hpp"
+#include "eruptor/runtime_assert.hpp"
+#include "eruptor/void_deleter.hpp"
+
+namespace eru
+{
+   GeometryPool::GeometryPool() = default;
+
+   auto GeometryPool::allocate_vertices(vk::DeviceSize const size, vk::DeviceSize const alignment) -> Allocation
+   {
+      return allocate(vertices_, size, alignment);
+   }
+
+   auto GeometryPool::allocate_indices(vk::DeviceSize const size) -> Allocation
+   {
+      return allocate(indices_, size, sizeof(std::uint16_t));
+   }
+
+   auto GeometryPool::free_vertices(Range const range) -> void
+   {
+      free(vertices_, range);
+   }
+
+   auto GeometryPool::free_indices(Range const range) -> void
+   {
+      free(indices_, range);
+   }
+
+   auto GeometryPool::vertex_buffer() const -> vk::Buffer
+   {
+      return vertices_.buffer;
+   }
+
+   auto GeometryPool::index_buffer() const -> vk::Buffer
+   {
+      return indices_.buffer;
+   }
+
+   auto GeometryPool::allocate(Arena& arena, vk::DeviceSize const size, vk::DeviceSize const alignment) const -> Allocation
+   {
+      RUNTIME_ASSERT(size,
+         "cannot allocate an empty geometry range!");
+
+      for (auto free_range{ arena.free_ranges.begin() }; free_range not_eq arena.free_ranges.end(); ++free_range)
+      {
+         auto const [free_offset, free_size]{ *free_range };
+         vk::DeviceSize const offset{ (free_offset + alignment - 1) / alignment * alignment };
+         if (offset + size > free_offset + free_size)
+            continue;
+
+         // whatever is left on either side stays free
+         arena.free_ranges.erase(free_range);
+         if (offset > free_offset)
+            arena.free_ranges.emplace(free_offset, offset - free_offset);
+
+         if (offset + size < free_offset + free_size)
+            arena.free_ranges.emplace(offset + size, free_offset + free_size - offset - size);
+
+         return {
+            .range{
+               .offset{ offset },
+               .size{ size }
+            },
+            .outgrown{}
+         };
+      }
+
+      // enough for the range to fit at the end, however it has to be aligned
+      UniquePointer<void> outgrown{ grow(arena, arena.capacity + size + alignment) };
+      Allocation allocation{ allocate(arena, size, alignment) };
+      allocation.outgrown = std::move(outgrown);
+      return allocation;
+   }
+
+   auto GeometryPool::free(Arena& arena, Range range) const -> void
+   {
+      RUNTIME_ASSERT(range.offset + range.size <= arena.capacity,
+         "cannot free a geometry range outside of the pool!");
+
+      auto const next{ arena.free_ranges.lower_bound(range.offset) };
+      RUNTIME_ASSERT(next == arena.free_ranges.end() or range.offset + range.size <= next->first,
+         "cannot free a geometry range that is already free!");
+
+      if (next not_eq arena.free_ranges.end() and range.offset + range.size == next->first)
+      {
+         range.size += next->second;
+         arena.free_ranges.erase(next);
+      }
+
+      auto const previous{ arena.free_ranges.lower_bound(range.offset) };
+      if (previous not_eq arena.free_ranges.begin())
+      {
+         auto const neighbour{ std::prev(previous) };
+         RUNTIME_ASSERT(neighbour->first + neighbour->second <= range.offset,
+            "cannot free a geometry range that is already free!");
+
+         if (neighbour->first + neighbour->second == range.offset)
+         {
+            neighbour->second += range.size;
+            return;
+         }
+      }
+
+      arena.free_ranges.emplace(range.offset, range.size);
+   }
+
+   auto GeometryPool::grow(Arena& arena, vk::DeviceSize const minimum_capacity) const -> UniquePointer<void>
+   {
+      vk::DeviceSize const capacity{ std::bit_ceil(std::max({ minimum_capacity, arena.capacity * 2, MINIMUM_CAPACITY })) };
+
+      Context::Buffer buffer{ context_.create_bound_buffer(capacity, arena.usage, false) };
+
+      // frames in flight may still be drawing from the old buffer, so it is handed back along with the copy out of it,
+      // which the queue only runs after them
+      UniquePointer<void> outgrown{};
+      if (arena.capacity)
+      {
+         // in member order, so that the copy is destroyed first
+         struct Outgrown final
+         {
+            vk::raii::Buffer buffer;
+            vk::raii::DeviceMemory memory;
+            vk::raii::CommandBuffer copy_command_buffer;
+         };
+
+         vk::raii::CommandBuffer copy_command_buffer{ copy(arena.buffer, buffer.buffer, arena.capacity) };
+         outgrown = {
+            new Outgrown{ std::move(arena.buffer), std::move(arena.memory), std::move(copy_command_buffer) },
+            void_deleter<Outgrown>
+         };
+      }
+
+      Range const added_range{
+         .offset{ arena.capacity },
+         .size{ capacity - arena.capacity }
+      };
+
+      arena.buffer = std::move(buffer.buffer);
+      arena.memory = std::move(buffer.memory);
+      arena.capacity = capacity;
+      free(arena, added_range);
+      return outgrown;
+   }
+
+   auto GeometryPool::copy(vk::Buffer const source, vk::Buffer const destination, vk::DeviceSize const size) const
+      -> vk::raii::CommandBuffer
+   {
+      // not waited on, the command buffer being handed back to be kept alongside the old buffer until it completes
+      return context_.submit(
+         [&](vk::raii::CommandBuffer const& command_buffer) -> void
+         {
+            command_buffer.copyBuffer(source, destination, {
+               {
+                  .size{ size }
+               }
+            });
+
+            // whatever is submitted after, be it uploads into the new buffer or frames drawing from it, waits for the copy
+            vk::MemoryBarrier2 constexpr copy_barrier{
+               .srcStageMask{ vk::PipelineStageFlagBits2::eCopy },
+               .srcAccessMask{ vk::AccessFlagBits2::eTransferWrite },
+               .dstStageMask{ vk::PipelineStageFlagBits2::eAllCommands },
+               .dstAccessMask{ vk::AccessFlagBits2::eMemoryRead | vk::AccessFlagBits2::eMemoryWrite }
+            };
+
+            command_buffer.pipelineBarrier2({
+               .memoryBarrierCount{ 1 },
+               .pMemoryBarriers{ &copy_barrier }
+            });
+         });
+   }
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+﻿#include "eruptor/instance.hpp"
+
+namespace eru
+{
+   decltype(Instance::INPUT_BINDING_DESCRIPTIONS) Instance::INPUT_BINDING_DESCRIPTIONS{
+      {
+         {
+            .binding{ 1 },
+            .stride{ static_cast<std::uint32_t>(sizeof(Instance)) },
+            .inputRate{ vk::VertexInputRate::eInstance }
+         }
+      }
+   };
+
+   // a matrix attribute takes up one location per column
+   decltype(Instance::INPUT_ATTRIBUTE_DESCRIPTIONS) Instance::INPUT_ATTRIBUTE_DESCRIPTIONS{
+      {
+         {
+            .location{ 3 },
+            .binding{ 1 },
+            .format{ vk::Format::eR32G32B32A32Sfloat },
+            .offset{ offsetof(Instance, transform) }
+         },
+         {
+            .location{ 4 },
+            .binding{ 1 },
+            .format{ vk::Format::eR32G32B32A32Sfloat },
+            .offset{ offsetof(Instance, transform) + sizeof(glm::vec4) }
+         },
+         {
+            .location{ 5 },
+            .binding{ 1 },
+            .format{ vk::Format::eR32G32B32A32Sfloat },
+            .offset{ offsetof(Instance, transform) + 2 * sizeof(glm::vec4) }
+         },
+         {
+            .location{ 6 },
+            .binding{ 1 },
+            .format{ vk::Format::eR32G32B32A32Sfloat },
+            .offset{ offsetof(Instance, transform) + 3 * sizeof(glm::vec4) }
+         },
+         {
+            .location{ 7 },
+            .binding{ 1 },
+            .format{ vk::Format::eR32Uint },
+            .offset{ offsetof(Instance, id) }
+         }
+      }
+   };
+}
\ No newline at end of file
@@ -5,6 +5,7 @@
 namespace eru
 {
    Layout::Layout(Description const& description)
+      : push_descriptor_set_{ description.push_descriptor_set }
    {
       static Context const& CONTEXT{ Locator::get<Context>() };
 
@@ -14,9 +15,11 @@ namespace eru
       descriptor_set_layouts_.reserve(std::ranges::size(description.sets));
       for (std::span const set : description.sets)
       {
+         bool const pushed{ push_descriptor_set_ == std::ranges::size(descriptor_set_layouts_) };
+
          vk::ResultValue descriptor_set_layout{
             CONTEXT.device.createDescriptorSetLayout({
-               .flags{  },
+               .flags{ pushed ? vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptor : vk::DescriptorSetLayoutCreateFlags{} },
                .bindingCount{ static_cast<std::uint32_t>(std::ranges::size(set)) },
                .pBindings{ std::ranges::data(set) }
             })
@@ -42,4 +45,19 @@ namespace eru
 
       pipeline_layout_ = std::move(*pipeline_layout);
    }
+
+   auto Layout::descriptor_set_layout(std::uint32_t const set) const -> vk::DescriptorSetLayout
+   {
+      return descriptor_set_layouts_[set];
+   }
+
+   auto Layout::pipeline_layout() const -> vk::PipelineLayout
+   {
+      return pipeline_layout_;
+   }
+
+   auto Layout::push_descriptor_set() const -> std::optional<std::uint32_t>
+   {
+      return push_descriptor_set_;
+   }
 }
@@ -0,0 +1,258 @@
+#include "eruptor/constants.hpp"
+#include "eruptor/context.hpp"
+#include "eruptor/light_clusters.hpp"
+#include "eruptor/runtime_assert.hpp"
+
+#include "core/shader.hpp"
+
+namespace eru
+{
+   LightClusters::LightClusters() = default;
+
+   auto LightClusters::update(std::uint8_t const frame_index, std::span<Light const> const lights, glm::mat4 const& view,
+      glm::mat4 const& projection, float const near_plane, float const far_plane, vk::Extent2D const extent) -> void
+   {
+      RUNTIME_ASSERT(lights.size() <= MAX_LIGHTS,
+         std::format("cannot cluster more than {} lights!", MAX_LIGHTS));
+
+      FrameBuffers const& buffers{ frame_buffers_[frame_index] };
+
+      // both written, never read back; the mapped memory may well be uncached
+      *static_cast<ClusterFrame*>(buffers.frame.mapped) = {
+         .inverse_projection{ inverse(projection) },
+         .grid_size{ GRID_SIZE[0], GRID_SIZE[1], GRID_SIZE[2] },
+         .light_count{ static_cast<std::uint32_t>(lights.size()) },
+         .screen_size{ extent.width, extent.height },
+         .near_plane{ near_plane },
+         .far_plane{ far_plane }
+      };
+
+      // moved into view space once here, rather than by every cluster and fragment that looks at them
+      auto* const view_lights{ static_cast<ViewLight*>(buffers.lights.mapped) };
+      for (std::size_t index{}; index < lights.size(); ++index)
+         view_lights[index] = {
+            .position{ view * glm::vec4{ lights[index].position, 1.0f } },
+            .radius{ lights[index].radius },
+            .color{ lights[index].color }
+         };
+   }
+
+   auto LightClusters::build(vk::raii::CommandBuffer const& command_buffer, std::uint8_t const frame_index) const -> void
+   {
+      FrameBuffers const& buffers{ frame_buffers_[frame_index] };
+
+      command_buffer.fillBuffer(buffers.light_index_count.buffer, 0, vk::WholeSize, 0);
+
+      vk::MemoryBarrier2 const begin_barrier{
+         .srcStageMask{ vk::PipelineStageFlagBits2::eClear },
+         .srcAccessMask{ vk::AccessFlagBits2::eTransferWrite },
+         .dstStageMask{ vk::PipelineStageFlagBits2::eComputeShader },
+         .dstAccessMask{ vk::AccessFlagBits2::eShaderStorageRead | vk::AccessFlagBits2::eShaderStorageWrite }
+      };
+
+      command_buffer.pipelineBarrier2({
+         .memoryBarrierCount{ 1 },
+         .pMemoryBarriers{ &begin_barrier }
+      });
+
+      command_buffer.bindPipeline(vk::PipelineBindPoint::eCompute, pipeline_);
+
+      vk::DescriptorBufferInfo const frame_info{ .buffer{ buffers.frame.buffer }, .range{ vk::WholeSize } };
+      vk::DescriptorBufferInfo const lights_info{ .buffer{ buffers.lights.buffer }, .range{ vk::WholeSize } };
+      vk::DescriptorBufferInfo const clusters_info{ .buffer{ buffers.clusters.buffer }, .range{ vk::WholeSize } };
+      vk::DescriptorBufferInfo const light_indices_info{ .buffer{ buffers.light_indices.buffer }, .range{ vk::WholeSize } };
+      vk::DescriptorBufferInfo const light_index_count_info{ .buffer{ buffers.light_index_count.buffer }, .range{ vk::WholeSize } };
+
+      std::array const writes{
+         std::to_array<vk::WriteDescriptorSet>({
+            {
+               .dstBinding{ 0 },
+               .descriptorCount{ 1 },
+               .descriptorType{ vk::DescriptorType::eUniformBuffer },
+               .pBufferInfo{ &frame_info }
+            },
+            {
+               .dstBinding{ 1 },
+               .descriptorCount{ 1 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .pBufferInfo{ &lights_info }
+            },
+            {
+               .dstBinding{ 2 },
+               .descriptorCount{ 1 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .pBufferInfo{ &clusters_info }
+            },
+            {
+               .dstBinding{ 3 },
+               .descriptorCount{ 1 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .pBufferInfo{ &light_indices_info }
+            },
+            {
+               .dstBinding{ 4 },
+               .descriptorCount{ 1 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .pBufferInfo{ &light_index_count_info }
+            }
+         })
+      };
+
+      command_buffer.pushDescriptorSet(vk::PipelineBindPoint::eCompute, pipeline_layout_, 0, writes);
+      command_buffer.dispatch((CLUSTER_COUNT + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+
+      vk::MemoryBarrier2 const end_barrier{
+         .srcStageMask{ vk::PipelineStageFlagBits2::eComputeShader },
+         .srcAccessMask{ vk::AccessFlagBits2::eShaderStorageWrite },
+         .dstStageMask{ vk::PipelineStageFlagBits2::eFragmentShader },
+         .dstAccessMask{ vk::AccessFlagBits2::eShaderStorageRead }
+      };
+
+      command_buffer.pipelineBarrier2({
+         .memoryBarrierCount{ 1 },
+         .pMemoryBarriers{ &end_barrier }
+      });
+   }
+
+   auto LightClusters::frame_buffer(std::uint8_t const frame_index) const -> vk::Buffer
+   {
+      return frame_buffers_[frame_index].frame.buffer;
+   }
+
+   auto LightClusters::light_buffer(std::uint8_t const frame_index) const -> vk::Buffer
+   {
+      return frame_buffers_[frame_index].lights.buffer;
+   }
+
+   auto LightClusters::cluster_buffer(std::uint8_t const frame_index) const -> vk::Buffer
+   {
+      return frame_buffers_[frame_index].clusters.buffer;
+   }
+
+   auto LightClusters::light_index_buffer(std::uint8_t const frame_index) const -> vk::Buffer
+   {
+      return frame_buffers_[frame_index].light_indices.buffer;
+   }
+
+   auto LightClusters::descriptor_set_layout() const -> vk::raii::DescriptorSetLayout
+   {
+      std::array constexpr bindings{
+         std::to_array<vk::DescriptorSetLayoutBinding>({
+            {
+               .binding{ 0 },
+               .descriptorType{ vk::DescriptorType::eUniformBuffer },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            },
+            {
+               .binding{ 1 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            },
+            {
+               .binding{ 2 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            },
+            {
+               .binding{ 3 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            },
+            {
+               .binding{ 4 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            }
+         })
+      };
+
+      // pushed per frame, as every frame in flight clusters into its own buffers
+      vk::ResultValue descriptor_set_layout{
+         context_.device.createDescriptorSetLayout({
+            .flags{ vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptor },
+            .bindingCount{ static_cast<std::uint32_t>(std::ranges::size(bindings)) },
+            .pBindings{ std::ranges::data(bindings) }
+         })
+      };
+      RUNTIME_ASSERT(descriptor_set_layout.has_value(),
+         std::format("failed to create light cluster descriptor set layout! ({})", to_string(descriptor_set_layout.result)));
+
+      return std::move(*descriptor_set_layout);
+   }
+
+   auto LightClusters::pipeline_layout() const -> vk::raii::PipelineLayout
+   {
+      std::array const layouts{
+         std::to_array<vk::DescriptorSetLayout>({
+            *descriptor_set_layout_
+         })
+      };
+
+      vk::ResultValue pipeline_layout{
+         context_.device.createPipelineLayout({
+            .setLayoutCount{ static_cast<std::uint32_t>(std::ranges::size(layouts)) },
+            .pSetLayouts{ std::ranges::data(layouts) }
+         })
+      };
+      RUNTIME_ASSERT(pipeline_layout.has_value(),
+         std::format("failed to create a light cluster pipeline layout! ({})", to_string(pipeline_layout.result)));
+
+      return std::move(*pipeline_layout);
+   }
+
+   auto LightClusters::pipeline() const -> vk::raii::Pipeline
+   {
+      std::vector<std::uint32_t> const code{ compile_framework_shader("light_clusters.slang") };
+
+      vk::ShaderModuleCreateInfo const shader_module_create_info{
+         .codeSize{ code.size() * sizeof(decltype(code)::value_type) },
+         .pCode{ code.data() }
+      };
+
+      vk::ResultValue pipeline{
+         context_.device.createComputePipeline(nullptr, {
+            .stage{
+               .pNext{ &shader_module_create_info },
+               .stage{ vk::ShaderStageFlagBits::eCompute },
+               .pName{ "clusterMain" }
+            },
+            .layout{ pipeline_layout_ }
+         })
+      };
+      RUNTIME_ASSERT(pipeline.has_value(),
+         std::format("failed create a light cluster pipeline! ({})", to_string(pipeline.result)));
+
+      return std::move(*pipeline);
+   }
+
+   auto LightClusters::frame_buffers() const -> std::vector<FrameBuffers>
+   {
+      std::vector<FrameBuffers> frame_buffers{};
+      frame_buffers.reserve(MAX_FRAMES_IN_FLIGHT);
+      for (std::size_t index{}; index < MAX_FRAMES_IN_FLIGHT; ++index)
+         frame_buffers.push_back({
+            .frame{ context_.create_bound_buffer(sizeof(ClusterFrame), vk::BufferUsageFlagBits::eUniformBuffer, true) },
+            .lights{
+               context_.create_bound_buffer(MAX_LIGHTS * sizeof(ViewLight), vk::BufferUsageFlagBits::eStorageBuffer, true)
+            },
+            .clusters{
+               context_.create_bound_buffer(CLUSTER_COUNT * sizeof(Cluster), vk::BufferUsageFlagBits::eStorageBuffer, false)
+            },
+            .light_indices{
+               context_.create_bound_buffer(CLUSTER_COUNT * AVERAGE_LIGHTS_PER_CLUSTER * sizeof(std::uint32_t),
+                  vk::BufferUsageFlagBits::eStorageBuffer, false)
+            },
+            .light_index_count{
+               context_.create_bound_buffer(sizeof(std::uint32_t),
+                  vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst, false)
+            }
+         });
+
+      return frame_buffers;
+   }
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include "eruptor/meshlets.hpp"
+
+namespace eru
+{
+   Meshlets::Meshlets(std::span<Vertex const> const vertices, std::span<std::uint16_t const> const strip_indices)
+   {
+      auto constexpr NO_LOCAL_VERTEX{ std::numeric_limits<std::uint32_t>::max() };
+
+      // of the meshlet being built, by mesh vertex
+      std::vector<std::uint32_t> local_vertices(vertices.size(), NO_LOCAL_VERTEX);
+
+      Meshlet meshlet{};
+      for (std::size_t index{ 2 }; index < strip_indices.size(); ++index)
+      {
+         // every other triangle of a strip winds the other way around
+         bool const odd{ index % 2 not_eq 0 };
+         std::array const triangle{
+            strip_indices[odd ? index - 1 : index - 2],
+            strip_indices[odd ? index - 2 : index - 1],
+            strip_indices[index]
+         };
+
+         // strips are stitched together with degenerate triangles, which cover nothing
+         if (triangle[0] == triangle[1] or triangle[1] == triangle[2] or triangle[2] == triangle[0])
+            continue;
+
+         auto const new_vertex_count{
+            static_cast<std::uint32_t>(std::ranges::count(triangle, NO_LOCAL_VERTEX,
+               [&local_vertices](std::uint16_t const vertex) -> std::uint32_t
+               {
+                  return local_vertices[vertex];
+               }))
+         };
+
+         if (meshlet.vertex_count + new_vertex_count > MAX_VERTICES or meshlet.triangle_count == MAX_TRIANGLES)
+         {
+            close(meshlet, vertices, local_vertices);
+            meshlet = {
+               .first_vertex{ static_cast<std::uint32_t>(vertices_.size()) },
+               .first_triangle{ static_cast<std::uint32_t>(triangles_.size()) }
+            };
+         }
+
+         std::uint32_t packed_triangle{};
+         for (std::size_t corner{}; corner < triangle.size(); ++corner)
+         {
+            std::uint32_t& local_vertex{ local_vertices[triangle[corner]] };
+            if (local_vertex == NO_LOCAL_VERTEX)
+            {
+               local_vertex = meshlet.vertex_count++;
+               vertices_.push_back(triangle[corner]);
+            }
+
+            packed_triangle |= local_vertex << 8 * corner;
+         }
+
+         triangles_.push_back(packed_triangle);
+         indices_.append_range(triangle);
+         ++meshlet.triangle_count;
+      }
+
+      if (meshlet.triangle_count)
+         close(meshlet, vertices, local_vertices);
+   }
+
+   auto Meshlets::meshlets() const -> std::span<Meshlet const>
+   {
+      return meshlets_;
+   }
+
+   auto Meshlets::vertices() const -> std::span<std::uint32_t const>
+   {
+      return vertices_;
+   }
+
+   auto Meshlets::triangles() const -> std::span<std::uint32_t const>
+   {
+      return triangles_;
+   }
+
+   auto Meshlets::indices() const -> std::span<std::uint16_t const>
+   {
+      return indices_;
+   }
+
+   auto Meshlets::close(Meshlet meshlet, std::span<Vertex const> const vertices,
+      std::vector<std::uint32_t>& local_vertices) -> void
+   {
+      std::span const meshlet_vertices{ std::span{ vertices_ }.subspan(meshlet.first_vertex, meshlet.vertex_count) };
+
+      // centered on the bounding box, like the bounding spheres of whole meshes
+      glm::vec3 minimum{ vertices[meshlet_vertices.front()].position };
+      glm::vec3 maximum{ minimum };
+      for (std::uint32_t const vertex : meshlet_vertices)
+      {
+         minimum = min(minimum, vertices[vertex].position);
+         maximum = max(maximum, vertices[vertex].position);
+      }
+
+      glm::vec3 const center{ (minimum + maximum) * 0.5f };
+      float radius{};
+      for (std::uint32_t const vertex : meshlet_vertices)
+      {
+         radius = std::max(radius, distance(center, vertices[vertex].position));
+         local_vertices[vertex] = std::numeric_limits<std::uint32_t>::max();
+      }
+
+      meshlet.bounding_sphere = { center, radius };
+
+      // the cone around the average triangle normal that holds every triangle normal
+      std::vector<glm::vec3> normals{};
+      normals.reserve(meshlet.triangle_count);
+      for (std::uint32_t const triangle : std::span{ triangles_ }.subspan(meshlet.first_triangle, meshlet.triangle_count))
+      {
+         glm::vec3 const& first{ vertices[meshlet_vertices[triangle & 0xFF]].position };
+         glm::vec3 const& second{ vertices[meshlet_vertices[triangle >> 8 & 0xFF]].position };
+         glm::vec3 const& third{ vertices[meshlet_vertices[triangle >> 16 & 0xFF]].position };
+
+         glm::vec3 const normal{ cross(second - first, third - first) };
+         float const length{ glm::length(normal) };
+         if (length > 0.0f)
+            normals.push_back(normal / length);
+      }
+
+      glm::vec3 normal_sum{};
+      for (glm::vec3 const& normal : normals)
+         normal_sum += normal;
+
+      float const normal_sum_length{ length(normal_sum) };
+      meshlet.cone_axis = normal_sum_length > 0.0f ? normal_sum / normal_sum_length : glm::vec3{ 0.0f, 0.0f, 1.0f };
+
+      float minimum_dot{ 1.0f };
+      for (glm::vec3 const& normal : normals)
+         minimum_dot = std::min(minimum_dot, dot(meshlet.cone_axis, normal));
+
+      // beyond a quarter turn either way, there is no viewpoint from which every triangle faces away
+      meshlet.cone_cutoff = normals.empty() or minimum_dot <= 0.0f ? 1.0f : std::sqrt(1.0f - minimum_dot * minimum_dot);
+
+      meshlets_.push_back(meshlet);
+   }
+}
\ No newline at end of file
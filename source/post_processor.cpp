@@ -0,0 +1,504 @@
+#include "eruptor/context.hpp"
+#include "eruptor/post_processor.hpp"
+#include "eruptor/runtime_assert.hpp"
+#include "eruptor/void_deleter.hpp"
+
+#include "core/shader.hpp"
+
+namespace eru
+{
+   PostProcessor::PostProcessor(Settings const& settings)
+      : settings_{ settings }
+   {
+   }
+
+   auto PostProcessor::resize(vk::Extent2D const extent) -> UniquePointer<void>
+   {
+      if (extent == extent_)
+         return {};
+
+      // in member order, so that the views are destroyed first
+      struct Retired final
+      {
+         vk::raii::Image image;
+         vk::raii::DeviceMemory image_memory;
+         vk::raii::ImageView image_view;
+         vk::raii::ImageView storage_image_view;
+         vk::raii::Image bloom_image;
+         vk::raii::DeviceMemory bloom_image_memory;
+         std::vector<vk::raii::ImageView> bloom_level_image_views;
+      };
+
+      UniquePointer<void> retired{
+         new Retired{
+            std::move(image_),
+            std::move(image_memory_),
+            std::move(image_view_),
+            std::move(storage_image_view_),
+            std::move(bloom_image_),
+            std::move(bloom_image_memory_),
+            std::exchange(bloom_level_image_views_, {})
+         },
+         void_deleter<Retired>
+      };
+
+      // mutable, so that it can be stored to through a linear view and read through an sRGB one
+      image_ = image(OUTPUT_FORMAT, extent, 1, vk::ImageCreateFlagBits::eMutableFormat | vk::ImageCreateFlagBits::eExtendedUsage);
+      image_memory_ = image_memory(image_);
+
+      vk::Result result{ image_.bindMemory(image_memory_, 0) };
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to bind post processing image's memory! ({})", to_string(result)));
+
+      image_view_ = image_view(image_, OUTPUT_FORMAT, 0);
+      storage_image_view_ = image_view(image_, STORAGE_FORMAT, 0);
+      extent_ = extent;
+
+      // down to where a level is a handful of texels across, as long as the source allows for at least one
+      auto const level_count{ static_cast<std::uint32_t>(std::bit_width(std::min(extent.width, extent.height))) };
+      bloom_level_count_ = std::min(std::max(level_count, 2u) - 1, MAX_BLOOM_LEVELS);
+      bloom_image_ = image(BLOOM_FORMAT, bloom_extent(0), bloom_level_count_, {});
+      bloom_image_memory_ = image_memory(bloom_image_);
+
+      result = bloom_image_.bindMemory(bloom_image_memory_, 0);
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to bind bloom image's memory! ({})", to_string(result)));
+
+      bloom_level_image_views_.reserve(bloom_level_count_);
+      for (std::uint32_t level{}; level < bloom_level_count_; ++level)
+         bloom_level_image_views_.push_back(image_view(bloom_image_, BLOOM_FORMAT, level));
+
+      return retired;
+   }
+
+   auto PostProcessor::record(vk::raii::CommandBuffer const& command_buffer, vk::ImageView const source) const -> void
+   {
+      RUNTIME_ASSERT(bloom_level_count_,
+         "the post processor has not been sized yet!");
+
+      // everything is overwritten, so whatever the previous frame left behind can be discarded
+      std::array const begin_barriers{
+         std::to_array<vk::ImageMemoryBarrier2>({
+            {
+               .srcStageMask{ vk::PipelineStageFlagBits2::eFragmentShader },
+               .srcAccessMask{ vk::AccessFlagBits2::eNone },
+               .dstStageMask{ vk::PipelineStageFlagBits2::eComputeShader },
+               .dstAccessMask{ vk::AccessFlagBits2::eShaderStorageWrite },
+               .oldLayout{ vk::ImageLayout::eUndefined },
+               .newLayout{ vk::ImageLayout::eGeneral },
+               .image{ image_ },
+               .subresourceRange{
+                  .aspectMask{ vk::ImageAspectFlagBits::eColor },
+                  .levelCount{ 1 },
+                  .layerCount{ 1 }
+               }
+            },
+            {
+               .srcStageMask{ vk::PipelineStageFlagBits2::eComputeShader },
+               .srcAccessMask{ vk::AccessFlagBits2::eNone },
+               .dstStageMask{ vk::PipelineStageFlagBits2::eComputeShader },
+               .dstAccessMask{ vk::AccessFlagBits2::eShaderStorageWrite },
+               .oldLayout{ vk::ImageLayout::eUndefined },
+               .newLayout{ vk::ImageLayout::eGeneral },
+               .image{ bloom_image_ },
+               .subresourceRange{
+                  .aspectMask{ vk::ImageAspectFlagBits::eColor },
+                  .levelCount{ bloom_level_count_ },
+                  .layerCount{ 1 }
+               }
+            }
+         })
+      };
+
+      command_buffer.pipelineBarrier2({
+         .imageMemoryBarrierCount{ static_cast<std::uint32_t>(std::ranges::size(begin_barriers)) },
+         .pImageMemoryBarriers{ std::ranges::data(begin_barriers) }
+      });
+
+      // covers both the next stage and the level it reads, which was written by the one before it
+      vk::MemoryBarrier2 constexpr stage_barrier{
+         .srcStageMask{ vk::PipelineStageFlagBits2::eComputeShader },
+         .srcAccessMask{ vk::AccessFlagBits2::eShaderStorageWrite },
+         .dstStageMask{ vk::PipelineStageFlagBits2::eComputeShader },
+         .dstAccessMask{ vk::AccessFlagBits2::eShaderSampledRead | vk::AccessFlagBits2::eShaderStorageRead }
+      };
+
+      vk::DescriptorImageInfo const source_info{
+         .imageView{ source },
+         .imageLayout{ vk::ImageLayout::eShaderReadOnlyOptimal }
+      };
+
+      auto const bloom_level_info{
+         [this](std::uint32_t const level) -> vk::DescriptorImageInfo
+         {
+            return {
+               .imageView{ bloom_level_image_views_[level] },
+               .imageLayout{ vk::ImageLayout::eGeneral }
+            };
+         }
+      };
+
+      if (settings_.bloom)
+      {
+         // the first level filters out what is not bright enough to bloom, every next one blurs the one before it
+         for (std::uint32_t level{}; level < bloom_level_count_; ++level)
+         {
+            if (level < 2)
+               command_buffer.bindPipeline(vk::PipelineBindPoint::eCompute,
+                  level ? bloom_downsample_pipeline_ : bloom_prefilter_pipeline_);
+
+            record_stage(command_buffer, level ? Stage::BLOOM_DOWNSAMPLE : Stage::BLOOM_PREFILTER,
+               level ? bloom_level_info(level - 1) : source_info, level ? bloom_extent(level - 1) : extent_,
+               bloom_level_image_views_[level], bloom_extent(level), {});
+
+            command_buffer.pipelineBarrier2({
+               .memoryBarrierCount{ 1 },
+               .pMemoryBarriers{ &stage_barrier }
+            });
+         }
+
+         // then every level is blurred back up into the one above it, which gathers all of them in the first
+         command_buffer.bindPipeline(vk::PipelineBindPoint::eCompute, bloom_upsample_pipeline_);
+         for (std::uint32_t level{ bloom_level_count_ - 1 }; level; --level)
+         {
+            record_stage(command_buffer, Stage::BLOOM_UPSAMPLE, bloom_level_info(level), bloom_extent(level),
+               bloom_level_image_views_[level - 1], bloom_extent(level - 1), {});
+
+            command_buffer.pipelineBarrier2({
+               .memoryBarrierCount{ 1 },
+               .pMemoryBarriers{ &stage_barrier }
+            });
+         }
+      }
+
+      // without bloom, the bloom image is left unread, and the source stands in for it
+      command_buffer.bindPipeline(vk::PipelineBindPoint::eCompute, fuse_pipeline_);
+      record_stage(command_buffer, Stage::FUSE, source_info, extent_, storage_image_view_, extent_,
+         settings_.bloom ? bloom_level_info(0) : source_info);
+
+      vk::ImageMemoryBarrier2 const end_barrier{
+         .srcStageMask{ vk::PipelineStageFlagBits2::eComputeShader },
+         .srcAccessMask{ vk::AccessFlagBits2::eShaderStorageWrite },
+         .dstStageMask{ vk::PipelineStageFlagBits2::eFragmentShader },
+         .dstAccessMask{ vk::AccessFlagBits2::eShaderSampledRead },
+         .oldLayout{ vk::ImageLayout::eGeneral },
+         .newLayout{ vk::ImageLayout::eShaderReadOnlyOptimal },
+         .image{ image_ },
+         .subresourceRange{
+            .aspectMask{ vk::ImageAspectFlagBits::eColor },
+            .levelCount{ 1 },
+            .layerCount{ 1 }
+         }
+      };
+
+      command_buffer.pipelineBarrier2({
+         .imageMemoryBarrierCount{ 1 },
+         .pImageMemoryBarriers{ &end_barrier }
+      });
+   }
+
+   auto PostProcessor::change_settings(Settings const& settings) -> void
+   {
+      settings_ = settings;
+   }
+
+   auto PostProcessor::settings() const -> Settings const&
+   {
+      return settings_;
+   }
+
+   auto PostProcessor::image() const -> vk::Image
+   {
+      return image_;
+   }
+
+   auto PostProcessor::image_view() const -> vk::ImageView
+   {
+      return image_view_;
+   }
+
+   auto PostProcessor::extent() const -> vk::Extent2D
+   {
+      return extent_;
+   }
+
+   auto PostProcessor::record_stage(vk::raii::CommandBuffer const& command_buffer, Stage const stage,
+      vk::DescriptorImageInfo const& source, vk::Extent2D const source_extent, vk::ImageView const destination,
+      vk::Extent2D const destination_extent, vk::DescriptorImageInfo const& bloom) const -> void
+   {
+      vk::DescriptorImageInfo const sampler_info{
+         .sampler{ sampler_ }
+      };
+
+      vk::DescriptorImageInfo const destination_info{
+         .imageView{ destination },
+         .imageLayout{ vk::ImageLayout::eGeneral }
+      };
+
+      std::array const writes{
+         std::to_array<vk::WriteDescriptorSet>({
+            {
+               .dstBinding{ 0 },
+               .descriptorCount{ 1 },
+               .descriptorType{ vk::DescriptorType::eSampler },
+               .pImageInfo{ &sampler_info }
+            },
+            {
+               .dstBinding{ 1 },
+               .descriptorCount{ 1 },
+               .descriptorType{ vk::DescriptorType::eSampledImage },
+               .pImageInfo{ &source }
+            },
+            {
+               .dstBinding{ 2 },
+               .descriptorCount{ 1 },
+               .descriptorType{ vk::DescriptorType::eStorageImage },
+               .pImageInfo{ &destination_info }
+            },
+            {
+               .dstBinding{ 3 },
+               .descriptorCount{ 1 },
+               .descriptorType{ vk::DescriptorType::eSampledImage },
+               .pImageInfo{ &bloom }
+            }
+         })
+      };
+
+      command_buffer.pushDescriptorSet(vk::PipelineBindPoint::eCompute, pipeline_layout_, 0,
+         std::span{ writes }.first(stage == Stage::FUSE ? writes.size() : writes.size() - 1));
+
+      PostConstants const post_constants{
+         .source_size{ source_extent.width, source_extent.height },
+         .destination_size{ destination_extent.width, destination_extent.height },
+         .exposure{ settings_.exposure },
+         .saturation{ settings_.saturation },
+         .contrast{ settings_.contrast },
+         .vignette_intensity{ settings_.vignette_intensity },
+         .tint{ settings_.tint },
+         .vignette_falloff{ settings_.vignette_falloff },
+         .bloom_threshold{ settings_.bloom ? settings_.bloom->threshold : 0.0f },
+         .bloom_knee{ settings_.bloom ? settings_.bloom->knee : 0.0f },
+         .bloom_intensity{ settings_.bloom ? settings_.bloom->intensity : 0.0f },
+         .dithering{ settings_.dithering }
+      };
+      command_buffer.pushConstants<PostConstants>(pipeline_layout_, vk::ShaderStageFlagBits::eCompute, 0, post_constants);
+
+      command_buffer.dispatch(
+         (destination_extent.width + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE,
+         (destination_extent.height + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE,
+         1);
+   }
+
+   auto PostProcessor::bloom_extent(std::uint32_t const level) const -> vk::Extent2D
+   {
+      return { std::max(extent_.width >> (level + 1), 1u), std::max(extent_.height >> (level + 1), 1u) };
+   }
+
+   auto PostProcessor::sampler() const -> vk::raii::Sampler
+   {
+      // bloom is filtered with bilinear fetches placed between texels, each blending four of them at once
+      vk::ResultValue sampler{
+         context_.device.createSampler({
+            .magFilter{ vk::Filter::eLinear },
+            .minFilter{ vk::Filter::eLinear },
+            .mipmapMode{ vk::SamplerMipmapMode::eNearest },
+            .addressModeU{ vk::SamplerAddressMode::eClampToEdge },
+            .addressModeV{ vk::SamplerAddressMode::eClampToEdge },
+            .addressModeW{ vk::SamplerAddressMode::eClampToEdge },
+            .mipLodBias{},
+            .anisotropyEnable{ vk::False },
+            .compareEnable{ vk::False },
+            .compareOp{ vk::CompareOp::eAlways },
+            .minLod{ 0.0f },
+            .maxLod{ 0.0f },
+            .borderColor{ vk::BorderColor::eFloatTransparentBlack },
+            .unnormalizedCoordinates{ vk::False }
+         })
+      };
+      RUNTIME_ASSERT(sampler.has_value(),
+         std::format("failed to create post processing sampler! ({})", to_string(sampler.result)));
+
+      return std::move(*sampler);
+   }
+
+   auto PostProcessor::descriptor_set_layout() const -> vk::raii::DescriptorSetLayout
+   {
+      std::array constexpr bindings{
+         std::to_array<vk::DescriptorSetLayoutBinding>({
+            {
+               .binding{ 0 },
+               .descriptorType{ vk::DescriptorType::eSampler },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            },
+            {
+               .binding{ 1 },
+               .descriptorType{ vk::DescriptorType::eSampledImage },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            },
+            {
+               .binding{ 2 },
+               .descriptorType{ vk::DescriptorType::eStorageImage },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            },
+            {
+               .binding{ 3 },
+               .descriptorType{ vk::DescriptorType::eSampledImage },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            }
+         })
+      };
+
+      // pushed per stage, as every bloom level is read as the source of the next one
+      vk::ResultValue descriptor_set_layout{
+         context_.device.createDescriptorSetLayout({
+            .flags{ vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptor },
+            .bindingCount{ static_cast<std::uint32_t>(std::ranges::size(bindings)) },
+            .pBindings{ std::ranges::data(bindings) }
+         })
+      };
+      RUNTIME_ASSERT(descriptor_set_layout.has_value(),
+         std::format("failed to create post processing descriptor set layout! ({})", to_string(descriptor_set_layout.result)));
+
+      return std::move(*descriptor_set_layout);
+   }
+
+   auto PostProcessor::pipeline_layout() const -> vk::raii::PipelineLayout
+   {
+      std::array const layouts{
+         std::to_array<vk::DescriptorSetLayout>({
+            *descriptor_set_layout_
+         })
+      };
+
+      std::array constexpr push_constant_ranges{
+         std::to_array<vk::PushConstantRange>({
+            {
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute },
+               .offset{ 0 },
+               .size{ sizeof(PostConstants) }
+            }
+         })
+      };
+
+      vk::ResultValue pipeline_layout{
+         context_.device.createPipelineLayout({
+            .setLayoutCount{ static_cast<std::uint32_t>(std::ranges::size(layouts)) },
+            .pSetLayouts{ std::ranges::data(layouts) },
+            .pushConstantRangeCount{ static_cast<std::uint32_t>(std::ranges::size(push_constant_ranges)) },
+            .pPushConstantRanges{ std::ranges::data(push_constant_ranges) }
+         })
+      };
+      RUNTIME_ASSERT(pipeline_layout.has_value(),
+         std::format("failed to create a post processing pipeline layout! ({})", to_string(pipeline_layout.result)));
+
+      return std::move(*pipeline_layout);
+   }
+
+   auto PostProcessor::shader_code() const -> std::vector<std::uint32_t>
+   {
+      return compile_framework_shader("post_processing.slang");
+   }
+
+   auto PostProcessor::pipeline(Stage const stage) const -> vk::raii::Pipeline
+   {
+      vk::ShaderModuleCreateInfo const shader_module_create_info{
+         .codeSize{ shader_code_.size() * sizeof(decltype(shader_code_)::value_type) },
+         .pCode{ shader_code_.data() }
+      };
+
+      char const* entry_point{};
+      switch (stage)
+      {
+         case Stage::BLOOM_PREFILTER:
+            entry_point = "bloomPrefilterMain";
+            break;
+
+         case Stage::BLOOM_DOWNSAMPLE:
+            entry_point = "bloomDownsampleMain";
+            break;
+
+         case Stage::BLOOM_UPSAMPLE:
+            entry_point = "bloomUpsampleMain";
+            break;
+
+         case Stage::FUSE:
+            entry_point = "fuseMain";
+            break;
+      }
+
+      vk::ResultValue pipeline{
+         context_.device.createComputePipeline(nullptr, {
+            .stage{
+               .pNext{ &shader_module_create_info },
+               .stage{ vk::ShaderStageFlagBits::eCompute },
+               .pName{ entry_point }
+            },
+            .layout{ pipeline_layout_ }
+         })
+      };
+      RUNTIME_ASSERT(pipeline.has_value(),
+         std::format("failed create a post processing pipeline! ({})", to_string(pipeline.result)));
+
+      return std::move(*pipeline);
+   }
+
+   auto PostProcessor::image(vk::Format const format, vk::Extent2D const extent, std::uint32_t const level_count,
+      vk::ImageCreateFlags const flags) const -> vk::raii::Image
+   {
+      vk::ResultValue image{
+         context_.device.createImage({
+            .flags{ flags },
+            .imageType{ vk::ImageType::e2D },
+            .format{ format },
+            .extent{
+               .width{ extent.width },
+               .height{ extent.height },
+               .depth{ 1 }
+            },
+            .mipLevels{ level_count },
+            .arrayLayers{ 1 },
+            .samples{ vk::SampleCountFlagBits::e1 },
+            .tiling{ vk::ImageTiling::eOptimal },
+            .usage{ vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eSampled },
+            .sharingMode{ vk::SharingMode::eExclusive },
+            .initialLayout{ vk::ImageLayout::eUndefined },
+         })
+      };
+      RUNTIME_ASSERT(image.result == vk::Result::eSuccess,
+         std::format("failed to create post processing image! ({})", to_string(image.result)));
+
+      return std::move(*image);
+   }
+
+   auto PostProcessor::image_memory(vk::raii::Image const& image) const -> vk::raii::DeviceMemory
+   {
+      return context_.allocate_memory(image.getMemoryRequirements(), vk::MemoryPropertyFlagBits::eDeviceLocal);
+   }
+
+   auto PostProcessor::image_view(vk::raii::Image const& image, vk::Format const format,
+      std::uint32_t const level) const -> vk::raii::ImageView
+   {
+      vk::ResultValue image_view{
+         context_.device.createImageView({
+            .image{ image },
+            .viewType{ vk::ImageViewType::e2D },
+            .format{ format },
+            .subresourceRange{
+               .aspectMask{ vk::ImageAspectFlagBits::eColor },
+               .baseMipLevel{ level },
+               .levelCount{ 1 },
+               .baseArrayLayer{ 0 },
+               .layerCount{ 1 }
+            }
+         })
+      };
+      RUNTIME_ASSERT(image_view.result == vk::Result::eSuccess,
+         std::format("failed to create post processing image view! ({})", to_string(image_view.result)));
+
+      return std::move(*image_view);
+   }
+}
\ No newline at end of file
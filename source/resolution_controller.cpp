@@ -0,0 +1,62 @@
+#include "eruptor/resolution_controller.hpp"
+#include "eruptor/runtime_assert.hpp"
+
+namespace eru
+{
+   ResolutionController::ResolutionController(Settings const& settings)
+      : settings_{ settings }
+   {
+      change_settings(settings);
+   }
+
+   auto ResolutionController::update(std::chrono::duration<double, std::milli> const frame_time) -> void
+   {
+      accumulated_frame_time_ += frame_time;
+      if (++accumulated_frames_ < FRAMES_PER_ADJUSTMENT)
+         return;
+
+      std::chrono::duration<double, std::milli> const average_frame_time{ accumulated_frame_time_ / accumulated_frames_ };
+      accumulated_frame_time_ = {};
+      accumulated_frames_ = 0;
+
+      if (average_frame_time.count() <= 0.0)
+         return;
+
+      float const ideal_scale{
+         scale_ * static_cast<float>(std::sqrt(settings_.target_frame_time * HEADROOM / average_frame_time))
+      };
+
+      // drops straight to where the frame time is met, but only recovers one step at a time, and only once there is
+      // room for a whole step more, so that the scale does not flip back and forth around the target
+      float scale{ scale_ };
+      if (ideal_scale < scale_)
+         scale = std::floor(ideal_scale / SCALE_STEP) * SCALE_STEP;
+      else if (ideal_scale >= scale_ + SCALE_STEP)
+         scale = scale_ + SCALE_STEP;
+
+      scale_ = std::clamp(scale, settings_.minimum_scale, settings_.maximum_scale);
+   }
+
+   auto ResolutionController::change_settings(Settings const& settings) -> void
+   {
+      RUNTIME_ASSERT(settings.minimum_scale > 0.0f and settings.minimum_scale <= settings.maximum_scale,
+         "the minimum scale must be positive and no larger than the maximum scale!");
+      RUNTIME_ASSERT(settings.target_frame_time.count() > 0.0,
+         "the target frame time must be positive!");
+
+      settings_ = settings;
+      scale_ = std::clamp(scale_, settings_.minimum_scale, settings_.maximum_scale);
+      accumulated_frame_time_ = {};
+      accumulated_frames_ = 0;
+   }
+
+   auto ResolutionController::settings() const -> Settings const&
+   {
+      return settings_;
+   }
+
+   auto ResolutionController::scale() const -> float
+   {
+      return scale_;
+   }
+}
\ No newline at end of file
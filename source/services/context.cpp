@@ -77,6 +77,96 @@ namespace eru
       return std::move(*device_memory);
    }
 
+   auto Context::create_bound_buffer(vk::DeviceSize const size, vk::BufferUsageFlags const usage, bool const host_visible) const -> Buffer
+   {
+      vk::raii::Buffer buffer{
+         create_buffer({
+            .size{ size },
+            .usage{ usage },
+            .sharingMode{ vk::SharingMode::eExclusive }
+         })
+      };
+
+      vk::raii::DeviceMemory memory{
+         allocate_memory(buffer.getMemoryRequirements(),
+            host_visible
+               ? vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+               : vk::MemoryPropertyFlagBits::eDeviceLocal)
+      };
+
+      vk::Result const result{ buffer.bindMemory(memory, 0) };
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to bind buffer's memory! ({})", to_string(result)));
+
+      void* mapped{};
+      if (host_visible)
+      {
+         vk::ResultValue const mapped_memory{ memory.mapMemory(0, vk::WholeSize) };
+         RUNTIME_ASSERT(mapped_memory.has_value(),
+            std::format("failed to map buffer's memory! ({})", to_string(mapped_memory.result)));
+
+         mapped = *mapped_memory;
+      }
+
+      return {
+         .buffer{ std::move(buffer) },
+         .memory{ std::move(memory) },
+         .mapped{ mapped }
+      };
+   }
+
+   auto Context::submit(std::function<void(vk::raii::CommandBuffer const&)> const& record_commands) const
+      -> vk::raii::CommandBuffer
+   {
+      vk::ResultValue command_buffers{
+         device.allocateCommandBuffers({
+            .commandPool{ command_pool },
+            .level{ vk::CommandBufferLevel::ePrimary },
+            .commandBufferCount{ 1 }
+         })
+      };
+      RUNTIME_ASSERT(command_buffers.has_value(),
+         std::format("failed to allocate a command buffer! ({})", to_string(command_buffers.result)));
+
+      vk::raii::CommandBuffer command_buffer{ std::move(command_buffers->front()) };
+
+      vk::Result result{
+         command_buffer.begin({
+            .flags{ vk::CommandBufferUsageFlagBits::eOneTimeSubmit }
+         })
+      };
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to begin command buffer! ({})", to_string(result)));
+
+      record_commands(command_buffer);
+
+      result = command_buffer.end();
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to end command buffer! ({})", to_string(result)));
+
+      result = queue.submit({
+         {
+            {
+               .commandBufferCount{ 1 },
+               .pCommandBuffers{ &*command_buffer },
+            }
+         }
+      });
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to submit command buffer! ({})", to_string(result)));
+
+      return command_buffer;
+   }
+
+   auto Context::submit_immediately(std::function<void(vk::raii::CommandBuffer const&)> const& record_commands) const -> void
+   {
+      vk::raii::CommandBuffer const command_buffer{ submit(record_commands) };
+
+      vk::Result const result{ queue.waitIdle() };
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to wait for queue! ({})", to_string(result)));
+   }
+
    auto Context::create_semaphores(std::uint32_t const count) const -> std::vector<vk::raii::Semaphore>
    {
       std::vector<vk::raii::Semaphore> semaphores{};
@@ -128,6 +218,9 @@ namespace eru
          extension_names.emplace_back(required_extension_names.data());
 
       extension_names.push_back(vk::EXTDebugUtilsExtensionName);
+      // required by swap chain maintenance, for present fences
+      extension_names.push_back(vk::KHRGetSurfaceCapabilities2ExtensionName);
+      extension_names.push_back(vk::EXTSurfaceMaintenance1ExtensionName);
 
       vk::ResultValue result{
          vulkan_context.createInstance({
@@ -187,7 +280,8 @@ namespace eru
 
                return properties.get().properties.deviceType == vk::PhysicalDeviceType::eDiscreteGpu
                   and features.get().features.wideLines
-                  and features.get<vk::PhysicalDeviceVulkan12Features>().scalarBlockLayout;
+                  and features.get<vk::PhysicalDeviceVulkan12Features>().scalarBlockLayout
+                  and features.get<vk::PhysicalDeviceVulkan12Features>().drawIndirectCount;
             })
       };
 
@@ -218,6 +312,51 @@ namespace eru
       return static_cast<std::uint32_t>(queue_family.index());
    }
 
+   auto Context::query_mesh_shader_support() const -> bool
+   {
+      vk::ResultValue const extension_properties{ physical_device.enumerateDeviceExtensionProperties() };
+      if (not extension_properties.has_value() or std::ranges::none_of(*extension_properties,
+         [](vk::ExtensionProperties const& properties) -> bool
+         {
+            return std::string_view{ properties.extensionName } == vk::EXTMeshShaderExtensionName;
+         }))
+         return false;
+
+      auto const features{
+         physical_device.getFeatures2<
+            vk::PhysicalDeviceFeatures2,
+            vk::PhysicalDeviceMeshShaderFeaturesEXT>()
+      };
+
+      return features.get<vk::PhysicalDeviceMeshShaderFeaturesEXT>().taskShader
+         and features.get<vk::PhysicalDeviceMeshShaderFeaturesEXT>().meshShader;
+   }
+
+   auto Context::query_present_wait_support() const -> bool
+   {
+      vk::ResultValue const extension_properties{ physical_device.enumerateDeviceExtensionProperties() };
+      if (not extension_properties.has_value())
+         return false;
+
+      for (std::string_view const extension_name : { vk::KHRPresentIdExtensionName, vk::KHRPresentWaitExtensionName })
+         if (std::ranges::none_of(*extension_properties,
+            [extension_name](vk::ExtensionProperties const& properties) -> bool
+            {
+               return std::string_view{ properties.extensionName } == extension_name;
+            }))
+            return false;
+
+      auto const features{
+         physical_device.getFeatures2<
+            vk::PhysicalDeviceFeatures2,
+            vk::PhysicalDevicePresentIdFeaturesKHR,
+            vk::PhysicalDevicePresentWaitFeaturesKHR>()
+      };
+
+      return features.get<vk::PhysicalDevicePresentIdFeaturesKHR>().presentId
+         and features.get<vk::PhysicalDevicePresentWaitFeaturesKHR>().presentWait;
+   }
+
    auto Context::create_device() const -> vk::raii::Device
    {
       vk::StructureChain<
@@ -227,10 +366,14 @@ namespace eru
          vk::PhysicalDeviceVulkan13Features,
          vk::PhysicalDeviceVulkan14Features,
          vk::PhysicalDeviceSwapchainMaintenance1FeaturesEXT,
-         vk::PhysicalDevicePageableDeviceLocalMemoryFeaturesEXT> const device_feature_chain{
+         vk::PhysicalDevicePageableDeviceLocalMemoryFeaturesEXT,
+         vk::PhysicalDeviceMeshShaderFeaturesEXT,
+         vk::PhysicalDevicePresentIdFeaturesKHR,
+         vk::PhysicalDevicePresentWaitFeaturesKHR> device_feature_chain{
          {
             .features
             {
+               .wideLines{ vk::True },
                .samplerAnisotropy{ vk::True }
             }
          },
@@ -238,23 +381,45 @@ namespace eru
             .shaderDrawParameters{ vk::True },
          },
          {
-            .scalarBlockLayout{ vk::True }
+            .drawIndirectCount{ vk::True },
+            .scalarBlockLayout{ vk::True },
+            .timelineSemaphore{ vk::True }
          },
          {
             .synchronization2{ vk::True },
             .dynamicRendering{ vk::True },
          },
          {
-            .maintenance5{ vk::True }
+            .maintenance5{ vk::True },
+            .pushDescriptor{ vk::True }
          },
          {
             .swapchainMaintenance1{ vk::True }
          },
          {
             .pageableDeviceLocalMemory{ vk::True }
+         },
+         {
+            .taskShader{ vk::True },
+            .meshShader{ vk::True }
+         },
+         {
+            .presentId{ vk::True }
+         },
+         {
+            .presentWait{ vk::True }
          }
       };
 
+      if (not mesh_shader_support)
+         device_feature_chain.unlink<vk::PhysicalDeviceMeshShaderFeaturesEXT>();
+
+      if (not present_wait_support)
+      {
+         device_feature_chain.unlink<vk::PhysicalDevicePresentIdFeaturesKHR>();
+         device_feature_chain.unlink<vk::PhysicalDevicePresentWaitFeaturesKHR>();
+      }
+
       auto constexpr queue_priority{ 0.5f };
 
       std::array const device_queue_create_info{
@@ -268,14 +433,19 @@ namespace eru
          })
       };
 
-      std::array constexpr device_extension_names{
-         std::to_array<char const* const>({
-            vk::EXTMemoryPriorityExtensionName,
-            vk::EXTPageableDeviceLocalMemoryExtensionName,
-            vk::KHRSwapchainExtensionName
-         })
+      std::vector<char const*> device_extension_names{
+         vk::EXTMemoryPriorityExtensionName,
+         vk::EXTPageableDeviceLocalMemoryExtensionName,
+         vk::KHRSwapchainExtensionName,
+         vk::EXTSwapchainMaintenance1ExtensionName
       };
 
+      if (mesh_shader_support)
+         device_extension_names.push_back(vk::EXTMeshShaderExtensionName);
+
+      if (present_wait_support)
+         device_extension_names.append_range(std::array{ vk::KHRPresentIdExtensionName, vk::KHRPresentWaitExtensionName });
+
       // TODO: for backwards compatibility, the validation layers here should be the same as the ones enabled on the instance
       vk::ResultValue result{
          physical_device.createDevice({
@@ -0,0 +1,263 @@
+#include "eruptor/context.hpp"
+#include "eruptor/frame_scheduler.hpp"
+#include "eruptor/runtime_assert.hpp"
+#include "eruptor/swap_chain.hpp"
+#include "eruptor/window.hpp"
+
+namespace eru
+{
+   FrameScheduler::FrameScheduler(PassKey<Locator>, Window& window, FramePacer::Description const& pacing)
+      : window_{ window }
+      , swap_chain_{ window.swap_chain() }
+      , frames_in_flight_{
+         static_cast<std::uint8_t>(std::min<std::uint32_t>(MAX_FRAMES_IN_FLIGHT, swap_chain_.frames_in_flight()))
+      }
+      , frame_pacer_{ pacing }
+   {
+   }
+
+   FrameScheduler::~FrameScheduler()
+   {
+      vk::Result const result{
+         context_.device.waitSemaphores({
+               .semaphoreCount{ 1 },
+               .pSemaphores{ &*timeline_semaphore_ },
+               .pValues{ &timeline_value_ }
+            },
+            std::numeric_limits<std::uint64_t>::max())
+      };
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to wait for the frames in flight! ({})", to_string(result)));
+   }
+
+   auto FrameScheduler::begin() -> std::optional<Frame>
+   {
+      RUNTIME_ASSERT(not image_index_,
+         "the frame in progress has to end before the next one begins!");
+
+      auto const pacing_start{ std::chrono::high_resolution_clock::now() };
+      frame_pacer_.pace(swap_chain_);
+
+      auto const frame_wait_start{ std::chrono::high_resolution_clock::now() };
+
+      // the frame in flight this one reuses has to be done either way; without present waits, the frame pacer's queue
+      // limit is held by waiting for frames to complete instead, which the pacer already did otherwise
+      std::uint64_t const queued_frames{ frame_pacer_.max_queued_frames() };
+      std::uint64_t const wait_value{
+         context_.present_wait_support or timeline_value_ <= queued_frames
+            ? submitted_values_[frame_index_]
+            : std::max(submitted_values_[frame_index_], timeline_value_ - queued_frames)
+      };
+
+      vk::Result result{
+         context_.device.waitSemaphores({
+               .semaphoreCount{ 1 },
+               .pSemaphores{ &*timeline_semaphore_ },
+               .pValues{ &wait_value }
+            },
+            std::numeric_limits<std::uint64_t>::max())
+      };
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to wait for a frame in flight! ({})", to_string(result)));
+
+      auto const image_wait_start{ std::chrono::high_resolution_clock::now() };
+
+      // a minimized window has nothing to present to
+      glm::uvec2 const window_extent{ window_.framebuffer_extent() };
+      if (not window_extent.x or not window_extent.y)
+      {
+         wait_times_ = {
+            .pacing{ frame_wait_start - pacing_start },
+            .frame{ image_wait_start - frame_wait_start }
+         };
+
+         return std::nullopt;
+      }
+
+      vk::Extent2D const extent{ window_extent.x, window_extent.y };
+      if (out_of_date_ or extent != swap_chain_window_extent_)
+         recreate_swap_chain(extent);
+
+      image_index_ = swap_chain_.acquire(frame_index_);
+      if (not image_index_)
+      {
+         recreate_swap_chain(extent);
+         image_index_ = swap_chain_.acquire(frame_index_);
+      }
+
+      wait_times_ = {
+         .pacing{ frame_wait_start - pacing_start },
+         .frame{ image_wait_start - frame_wait_start },
+         .image{ std::chrono::high_resolution_clock::now() - image_wait_start }
+      };
+
+      if (not image_index_)
+         return std::nullopt;
+
+      // the frame's command buffer is done with, as is everything else recorded for the frame index
+      result = command_pools_[frame_index_].reset();
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to reset a frame command pool! ({})", to_string(result)));
+
+      return Frame{
+         .frame_data{
+            .command_buffer{ command_buffers_[frame_index_] },
+            .frame_index{ frame_index_ },
+            .frames_in_flight{ frames_in_flight_ }
+         },
+         .target{
+            .image{ swap_chain_.image(*image_index_) },
+            .image_view{ swap_chain_.image_view(*image_index_) },
+            .extent{ swap_chain_.extent() },
+            .format{ swap_chain_.format() }
+         },
+         .image_index{ *image_index_ }
+      };
+   }
+
+   auto FrameScheduler::end() -> void
+   {
+      RUNTIME_ASSERT(image_index_,
+         "there is no frame in progress to end!");
+
+      std::uint64_t const signal_value{ ++timeline_value_ };
+
+      // the image is first written to as a color attachment, so everything before, culling included, runs while the
+      // presentation engine may still be reading it
+      vk::SemaphoreSubmitInfo const wait_info{
+         .semaphore{ swap_chain_.image_available_semaphore(frame_index_) },
+         .stageMask{ vk::PipelineStageFlagBits2::eColorAttachmentOutput }
+      };
+
+      std::array const signal_infos{
+         std::to_array<vk::SemaphoreSubmitInfo>({
+            {
+               .semaphore{ *timeline_semaphore_ },
+               .value{ signal_value },
+               .stageMask{ vk::PipelineStageFlagBits2::eAllCommands }
+            },
+            {
+               .semaphore{ swap_chain_.present_semaphore(*image_index_) },
+               .stageMask{ vk::PipelineStageFlagBits2::eAllCommands }
+            }
+         })
+      };
+
+      vk::CommandBufferSubmitInfo const command_buffer_info{
+         .commandBuffer{ command_buffers_[frame_index_] }
+      };
+
+      vk::Result const result{
+         context_.queue.submit2({
+            {
+               .waitSemaphoreInfoCount{ 1 },
+               .pWaitSemaphoreInfos{ &wait_info },
+               .commandBufferInfoCount{ 1 },
+               .pCommandBufferInfos{ &command_buffer_info },
+               .signalSemaphoreInfoCount{ static_cast<std::uint32_t>(std::ranges::size(signal_infos)) },
+               .pSignalSemaphoreInfos{ std::ranges::data(signal_infos) }
+            }
+         })
+      };
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to submit a frame! ({})", to_string(result)));
+
+      submitted_values_[frame_index_] = signal_value;
+
+      // recreated as the next frame begins, before another image is acquired from it
+      out_of_date_ = not swap_chain_.present(*image_index_, frame_pacer_.present_id());
+      frame_pacer_.presented();
+
+      image_index_.reset();
+      frame_index_ = static_cast<std::uint8_t>((frame_index_ + 1) % frames_in_flight_);
+   }
+
+   auto FrameScheduler::wait_times() const -> WaitTimes const&
+   {
+      return wait_times_;
+   }
+
+   auto FrameScheduler::frame_pacer() -> FramePacer&
+   {
+      return frame_pacer_;
+   }
+
+   auto FrameScheduler::frame_pacer() const -> FramePacer const&
+   {
+      return frame_pacer_;
+   }
+
+   auto FrameScheduler::frames_in_flight() const -> std::uint8_t
+   {
+      return frames_in_flight_;
+   }
+
+   auto FrameScheduler::recreate_swap_chain(vk::Extent2D const extent) -> void
+   {
+      swap_chain_.recreate(extent);
+      swap_chain_window_extent_ = extent;
+      out_of_date_ = false;
+   }
+
+   auto FrameScheduler::timeline_semaphore() const -> vk::raii::Semaphore
+   {
+      vk::SemaphoreTypeCreateInfo constexpr type_create_info{
+         .semaphoreType{ vk::SemaphoreType::eTimeline },
+         .initialValue{ 0 }
+      };
+
+      vk::ResultValue semaphore{
+         context_.device.createSemaphore({
+            .pNext{ &type_create_info }
+         })
+      };
+      RUNTIME_ASSERT(semaphore.has_value(),
+         std::format("failed to create a timeline semaphore! ({})", to_string(semaphore.result)));
+
+      return std::move(*semaphore);
+   }
+
+   auto FrameScheduler::command_pools() const -> std::vector<vk::raii::CommandPool>
+   {
+      std::vector<vk::raii::CommandPool> command_pools{};
+      command_pools.reserve(frames_in_flight_);
+      for (std::uint8_t frame_index{}; frame_index < frames_in_flight_; ++frame_index)
+      {
+         // reset as a whole once per frame
+         vk::ResultValue command_pool{
+            context_.device.createCommandPool({
+               .flags{ vk::CommandPoolCreateFlagBits::eTransient },
+               .queueFamilyIndex{ context_.queue_family_index }
+            })
+         };
+         RUNTIME_ASSERT(command_pool.has_value(),
+            std::format("failed to create a frame command pool! ({})", to_string(command_pool.result)));
+
+         command_pools.push_back(std::move(*command_pool));
+      }
+
+      return command_pools;
+   }
+
+   auto FrameScheduler::command_buffers() const -> std::vector<vk::raii::CommandBuffer>
+   {
+      std::vector<vk::raii::CommandBuffer> command_buffers{};
+      command_buffers.reserve(frames_in_flight_);
+      for (vk::raii::CommandPool const& command_pool : command_pools_)
+      {
+         vk::ResultValue allocated_command_buffers{
+            context_.device.allocateCommandBuffers({
+               .commandPool{ command_pool },
+               .level{ vk::CommandBufferLevel::ePrimary },
+               .commandBufferCount{ 1 }
+            })
+         };
+         RUNTIME_ASSERT(allocated_command_buffers.has_value(),
+            std::format("failed to allocate a frame command buffer! ({})", to_string(allocated_command_buffers.result)));
+
+         command_buffers.push_back(std::move(allocated_command_buffers->front()));
+      }
+
+      return command_buffers;
+   }
+}
\ No newline at end of file
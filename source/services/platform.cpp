@@ -27,4 +27,44 @@ namespace eru
    {
       glfwPollEvents();
    }
+
+   auto Platform::wait() -> void
+   {
+      while (true)
+      {
+         std::optional<std::chrono::steady_clock::time_point> redraw_time;
+         {
+            std::lock_guard const lock{ mutex_ };
+            if (redraw_time_ and *redraw_time_ <= std::chrono::steady_clock::now())
+            {
+               redraw_time_.reset();
+               return;
+            }
+
+            redraw_time = redraw_time_;
+         }
+
+         // events handled here may request a redraw in turn
+         if (redraw_time)
+            glfwWaitEventsTimeout(std::max(
+               std::chrono::duration<double>{ *redraw_time - std::chrono::steady_clock::now() }.count(), 0.0));
+         else
+            glfwWaitEvents();
+      }
+   }
+
+   auto Platform::request_redraw(std::chrono::steady_clock::duration const delay) -> void
+   {
+      std::chrono::steady_clock::time_point const redraw_time{ std::chrono::steady_clock::now() + delay };
+      {
+         std::lock_guard const lock{ mutex_ };
+         if (redraw_time_ and *redraw_time_ <= redraw_time)
+            return;
+
+         redraw_time_ = redraw_time;
+      }
+
+      // a wait already under way has to pick up the new time
+      glfwPostEmptyEvent();
+   }
 }
\ No newline at end of file
@@ -1,465 +1,1859 @@
 ﻿#include "eruptor/context.hpp"
+#include "eruptor/draw_queue.hpp"
 #include "eruptor/exception.hpp"
 #include "eruptor/locator.hpp"
 #include "eruptor/logger.hpp"
 #include "eruptor/renderer.hpp"
 #include "eruptor/runtime_assert.hpp"
+#include "eruptor/void_deleter.hpp"
 
 #include "core/dependencies.hpp"
+#include "core/shader.hpp"
 
 namespace eru
 {
-   Renderer::Renderer()
+   Renderer::Renderer(Description const& description)
+      : description_{ description }
    {
-      vk::Result result{ vertex_buffer_.bindMemory(vertex_buffer_memory_, 0) };
+      // the light clusters' buffers never change, so neither do the per-frame sets that point at them
+      std::size_t constexpr BUFFERS_PER_FRAME{ 5 };
+
+      uniform_buffer_mapped_.reserve(MAX_FRAMES_IN_FLIGHT);
+      std::vector<vk::DescriptorBufferInfo> buffer_infos{};
+      buffer_infos.reserve(BUFFERS_PER_FRAME * MAX_FRAMES_IN_FLIGHT);
+      std::vector<vk::WriteDescriptorSet> writes{};
+      writes.reserve(BUFFERS_PER_FRAME * MAX_FRAMES_IN_FLIGHT);
+      for (std::uint8_t index{}; index < MAX_FRAMES_IN_FLIGHT; ++index)
+      {
+         uniform_buffers_[index].bindMemory(uniform_buffer_memories_[index], 0);
+
+         vk::ResultValue const mapped_memory{ uniform_buffer_memories_[index].mapMemory(0, sizeof(UniformBufferObject)) };
+         RUNTIME_ASSERT(mapped_memory.has_value(),
+            std::format("failed to map a uniform buffer's memory! ({})", to_string(mapped_memory.result)));
+
+         uniform_buffer_mapped_.push_back(static_cast<UniformBufferObject*>(*mapped_memory));
+
+         std::array const buffers{
+            std::to_array<std::pair<vk::Buffer, vk::DescriptorType>>({
+               { uniform_buffers_[index], vk::DescriptorType::eUniformBuffer },
+               { light_clusters_.frame_buffer(index), vk::DescriptorType::eUniformBuffer },
+               { light_clusters_.light_buffer(index), vk::DescriptorType::eStorageBuffer },
+               { light_clusters_.cluster_buffer(index), vk::DescriptorType::eStorageBuffer },
+               { light_clusters_.light_index_buffer(index), vk::DescriptorType::eStorageBuffer }
+            })
+         };
+
+         for (std::uint32_t binding{}; binding < BUFFERS_PER_FRAME; ++binding)
+         {
+            buffer_infos.push_back({
+               .buffer{ buffers[binding].first },
+               .offset{},
+               .range{ vk::WholeSize }
+            });
+
+            writes.push_back({
+               .dstSet{ uniform_buffer_descriptor_sets_[index] },
+               .dstBinding{ binding },
+               .dstArrayElement{ 0 },
+               .descriptorCount{ 1 },
+               .descriptorType{ buffers[binding].second },
+               .pImageInfo{ nullptr },
+               .pBufferInfo{ &buffer_infos.back() },
+               .pTexelBufferView{ nullptr }
+            });
+         }
+      }
+
+      context_.device.updateDescriptorSets(writes, {});
+   }
+
+   Renderer::~Renderer()
+   {
+      vk::Result const result{ context_.device.waitIdle() };
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to wait idle on the device! ({})", to_string(result)));
+   }
+
+   auto Renderer::create_mesh(std::span<Vertex const> const vertices, std::span<std::uint16_t const> const indices,
+      Vertex::StreamLayout const stream_layout) -> std::uint32_t
+   {
+      // mesh shaders and pulling vertex shaders fetch interleaved vertices from storage buffers themselves, everything
+      // else goes through the input assembler
+      return add_mesh(vertices, indices,
+         context_.mesh_shader_support or vertex_pulling() ? Vertex::StreamLayout::INTERLEAVED : stream_layout, std::nullopt);
+   }
+
+   auto Renderer::create_skinned_mesh(std::uint32_t const skinned_instance, std::span<Vertex const> const vertices,
+      std::span<std::uint16_t const> const indices) -> std::uint32_t
+   {
+      RUNTIME_ASSERT(vertices.size() == skinner_.vertex_count(skinned_instance),
+         std::format("skinned instance {} has {} vertices, not {}!",
+            skinned_instance, skinner_.vertex_count(skinned_instance), vertices.size()));
+
+      // split whichever way vertices are fetched, as only the attributes come from the pool
+      return add_mesh(vertices, indices, Vertex::StreamLayout::SPLIT, skinned_instance);
+   }
+
+   auto Renderer::add_mesh(std::span<Vertex const> const vertices, std::span<std::uint16_t const> const indices,
+      Vertex::StreamLayout const stream_layout, std::optional<std::uint32_t> const skinned_instance) -> std::uint32_t
+   {
+      RUNTIME_ASSERT(not vertices.empty() and not indices.empty(),
+         "a mesh needs at least one vertex and one index!");
+      RUNTIME_ASSERT(meshes_.size() < 1uz << DrawQueue::Key::MESH_BITS,
+         std::format("cannot create more than {} meshes!", 1uz << DrawQueue::Key::MESH_BITS));
+
+      Meshlets const meshlets{ vertices, indices };
+      RUNTIME_ASSERT(not meshlets.meshlets().empty(),
+         "a mesh needs at least one triangle that is not degenerate!");
+
+      // kept alive until the uploads are done
+      bool const split{ stream_layout == Vertex::StreamLayout::SPLIT };
+      std::vector<Vertex::Packed> packed_vertices{};
+      std::vector<Half4> positions{};
+      std::vector<Vertex::Attributes> attributes{};
+      if (split)
+      {
+         positions.reserve(vertices.size());
+         attributes.reserve(vertices.size());
+         for (Vertex const& vertex : vertices)
+         {
+            auto const [position, vertex_attributes]{ vertex.packed() };
+            if (not skinned_instance)
+               positions.push_back(position);
+
+            attributes.push_back(vertex_attributes);
+         }
+      }
+      else
+      {
+         packed_vertices.reserve(vertices.size());
+         for (Vertex const& vertex : vertices)
+            packed_vertices.push_back(vertex.packed());
+      }
+
+      std::span<std::byte const> const vertex_data{
+         split ? std::as_bytes(std::span{ positions }) : std::as_bytes(std::span{ packed_vertices })
+      };
+
+      // the pool's buffers may be replaced by any of these, so they are only looked up once all of them are made; the
+      // buffers outgrown are kept until frames in flight are done drawing from them
+      GeometryPool::Allocation vertex_allocation{
+         skinned_instance
+            ? GeometryPool::Allocation{}
+            : geometry_pool_.allocate_vertices(vertex_data.size_bytes(), split ? sizeof(Half4) : sizeof(Vertex::Packed))
+      };
+      GeometryPool::Allocation attribute_allocation{
+         split
+            ? geometry_pool_.allocate_vertices(std::span{ attributes }.size_bytes(), sizeof(Vertex::Attributes))
+            : GeometryPool::Allocation{}
+      };
+      GeometryPool::Allocation index_allocation{ geometry_pool_.allocate_indices(meshlets.indices().size_bytes()) };
+      retire(std::move(vertex_allocation.outgrown));
+      retire(std::move(attribute_allocation.outgrown));
+      retire(std::move(index_allocation.outgrown));
+
+      GeometryPool::Range const vertex_range{ vertex_allocation.range };
+      GeometryPool::Range const attribute_range{ attribute_allocation.range };
+      GeometryPool::Range const index_range{ index_allocation.range };
+      std::int32_t const base_vertex{ split ? 0 : static_cast<std::int32_t>(vertex_range.offset / sizeof(Vertex::Packed)) };
+
+      std::vector<Upload> uploads{
+         {
+            .buffer{ geometry_pool_.index_buffer() },
+            .offset{ index_range.offset },
+            .data{ std::as_bytes(meshlets.indices()) }
+         }
+      };
+
+      if (not skinned_instance)
+         uploads.push_back({
+            .buffer{ geometry_pool_.vertex_buffer() },
+            .offset{ vertex_range.offset },
+            .data{ vertex_data }
+         });
+
+      if (split)
+         uploads.push_back({
+            .buffer{ geometry_pool_.vertex_buffer() },
+            .offset{ attribute_range.offset },
+            .data{ std::as_bytes(std::span{ attributes }) }
+         });
+
+      // meshlet vertices index the mesh's vertex streams, which start at the pool's first vertex for interleaved meshes
+      std::vector<std::uint32_t> meshlet_vertices{};
+      MeshBuffer meshlet_vertex_buffer{};
+      MeshBuffer meshlet_triangle_buffer{};
+      if (context_.mesh_shader_support)
+      {
+         meshlet_vertices.reserve(meshlets.vertices().size());
+         for (std::uint32_t const vertex : meshlets.vertices())
+            meshlet_vertices.push_back(static_cast<std::uint32_t>(base_vertex) + vertex);
+
+         meshlet_vertex_buffer = mesh_buffer(meshlets.vertices().size_bytes(), vk::BufferUsageFlagBits::eStorageBuffer);
+         meshlet_triangle_buffer = mesh_buffer(meshlets.triangles().size_bytes(), vk::BufferUsageFlagBits::eStorageBuffer);
+
+         uploads.push_back({
+            .buffer{ meshlet_vertex_buffer.buffer },
+            .data{ std::as_bytes(std::span{ meshlet_vertices }) }
+         });
+         uploads.push_back({
+            .buffer{ meshlet_triangle_buffer.buffer },
+            .data{ std::as_bytes(meshlets.triangles()) }
+         });
+      }
+
+      std::size_t const first_meshlet{ meshlets_.size() };
+      meshlets_.append_range(meshlets.meshlets());
+
+      // frames in flight may still be culling with the meshlet buffer; once it is replaced, it is uploaded as a whole
+      bool const meshlet_buffer_replaced{ meshlets_.size() > meshlet_buffer_.capacity };
+      if (meshlet_buffer_replaced)
+      {
+         // the old one is kept around until they are done
+         if (meshlet_buffer_.capacity)
+            retire({
+               new DeviceBuffer<Meshlets::Meshlet>{ std::exchange(meshlet_buffer_, {}) },
+               void_deleter<DeviceBuffer<Meshlets::Meshlet>>
+            });
+
+         reserve(meshlet_buffer_, meshlets_.size(), vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst);
+      }
+
+      std::size_t const first_uploaded_meshlet{ meshlet_buffer_replaced ? 0uz : first_meshlet };
+      uploads.push_back({
+         .buffer{ meshlet_buffer_.buffer },
+         .offset{ first_uploaded_meshlet * sizeof(Meshlets::Meshlet) },
+         .data{ std::as_bytes(std::span{ meshlets_ }.subspan(first_uploaded_meshlet)) }
+      });
+
+      std::vector<StagingBuffer> staging_buffers{};
+      staging_buffers.reserve(uploads.size());
+      for (Upload const& upload : uploads)
+         staging_buffers.push_back(staging_buffer(upload.data));
+
+      context_.submit_immediately(
+         [&](vk::raii::CommandBuffer const& command_buffer) -> void
+         {
+            for (std::size_t index{}; index < uploads.size(); ++index)
+            {
+               std::array const copy_regions{
+                  std::to_array<vk::BufferCopy2>({
+                     {
+                        .dstOffset{ uploads[index].offset },
+                        .size{ uploads[index].data.size_bytes() }
+                     }
+                  })
+               };
+               command_buffer.copyBuffer2({
+                  .srcBuffer{ staging_buffers[index].buffer },
+                  .dstBuffer{ uploads[index].buffer },
+                  .regionCount{ static_cast<std::uint32_t>(std::ranges::size(copy_regions)) },
+                  .pRegions{ std::ranges::data(copy_regions) }
+               });
+            }
+         });
+
+      // centered on the bounding box; not the tightest sphere, but a cheap and stable one
+      glm::vec3 minimum{ vertices.front().position };
+      glm::vec3 maximum{ vertices.front().position };
+      for (Vertex const& vertex : vertices)
+      {
+         minimum = glm::min(minimum, vertex.position);
+         maximum = glm::max(maximum, vertex.position);
+      }
+
+      glm::vec3 const center{ (minimum + maximum) * 0.5f };
+      float radius{};
+      for (Vertex const& vertex : vertices)
+         radius = std::max(radius, glm::distance(center, vertex.position));
+
+      meshes_.push_back({
+         .vertices{ vertex_range },
+         .attributes{ attribute_range },
+         .stream_layout{ stream_layout },
+         .indices{ index_range },
+         .base_vertex{ base_vertex },
+         .first_index{ static_cast<std::uint32_t>(index_range.offset / sizeof(std::uint16_t)) },
+         .meshlet_vertices{ std::move(meshlet_vertex_buffer) },
+         .meshlet_triangles{ std::move(meshlet_triangle_buffer) },
+         .first_meshlet{ static_cast<std::uint32_t>(first_meshlet) },
+         .meshlet_count{ static_cast<std::uint32_t>(meshlets.meshlets().size()) },
+         .bounding_sphere{ center, radius },
+         .skinned_instance{ skinned_instance }
+      });
+
+      return static_cast<std::uint32_t>(meshes_.size() - 1);
+   }
+
+   auto Renderer::create_material(std::string_view const texture_path) -> std::uint32_t
+   {
+      RUNTIME_ASSERT(materials_.size() < MAX_MATERIALS,
+         std::format("cannot create more than {} materials!", MAX_MATERIALS));
+
+      UniquePointer<ktxTexture2> const material_texture{ texture(texture_path) };
+      vk::Format const format{ static_cast<vk::Format>(material_texture->vkFormat) };
+
+      vk::raii::Image material_image{ image(*material_texture) };
+      vk::raii::DeviceMemory material_image_memory{ image_memory(material_image) };
+
+      vk::Result const result{ material_image.bindMemory(material_image_memory, 0) };
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to bind image buffer's memory! ({})", to_string(result)));
+
+      vk::raii::ImageView material_image_view{ image_view(material_image, format) };
+
+      StagingBuffer const image_staging_buffer{
+         staging_buffer({ reinterpret_cast<std::byte const*>(material_texture->pData), material_texture->dataSize })
+      };
+
+      context_.submit_immediately(
+         [&](vk::raii::CommandBuffer const& command_buffer) -> void
+         {
+            std::array const image_memory_barriers{
+               std::to_array<vk::ImageMemoryBarrier2>({
+                  {
+                     .srcStageMask{ vk::PipelineStageFlagBits2::eNone },
+                     .srcAccessMask{ vk::AccessFlagBits2::eNone },
+                     .dstStageMask{ vk::PipelineStageFlagBits2::eTransfer },
+                     .dstAccessMask{ vk::AccessFlagBits2::eTransferWrite },
+                     .oldLayout{ vk::ImageLayout::eUndefined },
+                     .newLayout{ vk::ImageLayout::eTransferDstOptimal },
+                     .image{ material_image },
+                     .subresourceRange{
+                        .aspectMask{ vk::ImageAspectFlagBits::eColor },
+                        .baseMipLevel{ 0 },
+                        .levelCount{ 1 },
+                        .baseArrayLayer{ 0 },
+                        .layerCount{ 1 }
+                     },
+                  }
+               })
+            };
+            command_buffer.pipelineBarrier2({
+               .imageMemoryBarrierCount{ static_cast<std::uint32_t>(std::ranges::size(image_memory_barriers)) },
+               .pImageMemoryBarriers{ std::ranges::data(image_memory_barriers) }
+            });
+
+            std::array const image_buffer_copy_regions{
+               std::to_array<vk::BufferImageCopy2>({
+                  {
+                     .imageSubresource{
+                        .aspectMask{ vk::ImageAspectFlagBits::eColor },
+                        .mipLevel{ 0 },
+                        .baseArrayLayer{ 0 },
+                        .layerCount{ 1 }
+                     },
+                     .imageExtent{
+                        .width{ material_texture->baseWidth },
+                        .height{ material_texture->baseHeight },
+                        .depth{ material_texture->baseDepth }
+                     }
+                  }
+               })
+            };
+            command_buffer.copyBufferToImage2({
+               .srcBuffer{ image_staging_buffer.buffer },
+               .dstImage{ material_image },
+               .dstImageLayout{ vk::ImageLayout::eTransferDstOptimal },
+               .regionCount{ static_cast<std::uint32_t>(std::ranges::size(image_buffer_copy_regions)) },
+               .pRegions{ std::ranges::data(image_buffer_copy_regions) }
+            });
+
+            std::array const end_image_memory_barriers{
+               std::to_array<vk::ImageMemoryBarrier2>({
+                  {
+                     .srcStageMask{ vk::PipelineStageFlagBits2::eTransfer },
+                     .srcAccessMask{ vk::AccessFlagBits2::eTransferWrite },
+                     .dstStageMask{ vk::PipelineStageFlagBits2::eNone },
+                     .dstAccessMask{ vk::AccessFlagBits2::eNone },
+                     .oldLayout{ vk::ImageLayout::eTransferDstOptimal },
+                     .newLayout{ vk::ImageLayout::eShaderReadOnlyOptimal },
+                     .image{ material_image },
+                     .subresourceRange{
+                        .aspectMask{ vk::ImageAspectFlagBits::eColor },
+                        .baseMipLevel{ 0 },
+                        .levelCount{ 1 },
+                        .baseArrayLayer{ 0 },
+                        .layerCount{ 1 }
+                     }
+                  }
+               })
+            };
+            command_buffer.pipelineBarrier2({
+               .imageMemoryBarrierCount{ static_cast<std::uint32_t>(std::ranges::size(end_image_memory_barriers)) },
+               .pImageMemoryBarriers{ std::ranges::data(end_image_memory_barriers) }
+            });
+         });
+
+      vk::raii::DescriptorSet descriptor_set{ material_descriptor_set() };
+
+      vk::DescriptorImageInfo const sampler_info{
+         .sampler{ sampler_ }
+      };
+
+      vk::DescriptorImageInfo const image_info{
+         .imageView{ material_image_view },
+         .imageLayout{ vk::ImageLayout::eShaderReadOnlyOptimal },
+      };
+
+      std::array const writes{
+         std::to_array<vk::WriteDescriptorSet>({
+            {
+               .dstSet{ descriptor_set },
+               .dstBinding{ 0 },
+               .dstArrayElement{ 0 },
+               .descriptorCount{ 1 },
+               .descriptorType{ vk::DescriptorType::eSampler },
+               .pImageInfo{ &sampler_info }
+            },
+            {
+               .dstSet{ descriptor_set },
+               .dstBinding{ 1 },
+               .dstArrayElement{ 0 },
+               .descriptorCount{ 1 },
+               .descriptorType{ vk::DescriptorType::eSampledImage },
+               .pImageInfo{ &image_info }
+            }
+         })
+      };
+
+      context_.device.updateDescriptorSets(writes, {});
+
+      materials_.push_back({
+         .image{ std::move(material_image) },
+         .image_memory{ std::move(material_image_memory) },
+         .image_view{ std::move(material_image_view) },
+         .descriptor_set{ std::move(descriptor_set) }
+      });
+
+      return static_cast<std::uint32_t>(materials_.size() - 1);
+   }
+
+   auto Renderer::draw(Draw const& draw) -> void
+   {
+      draws_.push_back(draw);
+   }
+
+   auto Renderer::light(LightClusters::Light const& light) -> void
+   {
+      RUNTIME_ASSERT(lights_.size() < LightClusters::MAX_LIGHTS,
+         std::format("cannot queue more than {} lights!", LightClusters::MAX_LIGHTS));
+
+      lights_.push_back(light);
+   }
+
+   auto Renderer::create_static_segment(std::vector<Draw> draws) -> std::uint32_t
+   {
+      StaticSegment new_static_segment{ static_segment(std::move(draws)) };
+      reserve_visibility(new_static_segment.visibility, new_static_segment.draws);
+
+      static_segments_.emplace(next_static_segment_, std::move(new_static_segment));
+      return next_static_segment_++;
+   }
+
+   auto Renderer::change_static_segment(std::uint32_t const segment, std::vector<Draw> draws) -> void
+   {
+      auto const static_segment{ static_segments_.find(segment) };
+      RUNTIME_ASSERT(static_segment not_eq static_segments_.end(),
+         std::format("static segment {} does not exist!", segment));
+
+      reserve_visibility(static_segment->second.visibility, draws);
+
+      // frames still in flight keep replaying their own copy until their frame index comes around again
+      static_segment->second.draws = std::move(draws);
+      std::ranges::fill(static_segment->second.recorded_inputs, std::nullopt);
+   }
+
+   auto Renderer::destroy_static_segment(std::uint32_t const segment) -> void
+   {
+      auto const static_segment{ static_segments_.find(segment) };
+      RUNTIME_ASSERT(static_segment not_eq static_segments_.end(),
+         std::format("static segment {} does not exist!", segment));
+
+      // its command buffers and buffers may still be in use by frames in flight
+      retire({ new StaticSegment{ std::move(static_segment->second) }, void_deleter<StaticSegment> });
+      static_segments_.erase(static_segment);
+   }
+
+   auto Renderer::record(FrameData const frame_data, Target const& target) -> void
+   {
+      RUNTIME_ASSERT(target.format == description_.color_format,
+         std::format("target format {} does not match the renderer's color format {}!",
+            to_string(target.format), to_string(description_.color_format)));
+
+      auto const recording_start{ std::chrono::high_resolution_clock::now() };
+
+      read_timings(frame_data.frame_index);
+      read_visibility_counters(frame_data.frame_index);
+      release_retired_resources();
+
+      // the scene is rendered at the scale picked from the timings just read back, if not straight into the target
+      Target const scene{ scene_target(target) };
+      prepare_depth_image(scene.extent);
+      reset_recording_pools(frame_data.frame_index);
+
+      glm::mat4 const view{ lookAt(glm::vec3(2.0f, 2.0f, 2.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f)) };
+      glm::mat4 projection{ glm::perspective(glm::radians(45.0f), static_cast<float>(scene.extent.width) / scene.extent.height, NEAR_PLANE, FAR_PLANE) };
+      projection[1][1] *= -1;
+
+      glm::mat4 const view_projection{ projection * view };
+      std::array const frustum_planes{ Frustum{ view_projection }.planes() };
+      glm::vec4 const camera_position{ inverse(view)[3] };
+
+      // written, never read back; the mapped memory may well be uncached
+      *uniform_buffer_mapped_[frame_data.frame_index] = {
+         .view{ view },
+         .projection{ projection },
+         .frustum_planes{ frustum_planes },
+         .camera_position{ camera_position }
+      };
+
+      *cull_frame_buffers_[frame_data.frame_index].frame.elements = {
+         .view_projection{ view_projection },
+         .frustum_planes{ frustum_planes },
+         .camera_position{ camera_position },
+         .pyramid_size{ depth_pyramid_.extent().width, depth_pyramid_.extent().height },
+         .pyramid_level_count{ depth_pyramid_.level_count() }
+      };
+
+      light_clusters_.update(frame_data.frame_index, lights_, view, projection, NEAR_PLANE, FAR_PLANE, scene.extent);
+      lights_.clear();
+
+      debug_draw_.update(frame_data.frame_index);
+
+      //======================================//
+
+      reserve_visibility(visibility_, draws_);
+
+      DrawListBuffers& buffers{ draw_list_buffers_[frame_data.frame_index] };
+      std::vector<Batch> const batches{ batch(draws_, view, buffers, statistics_) };
+      draws_.clear();
+
+      std::size_t const chunk_count{
+         std::min(thread_pool_.thread_count(), (batches.size() + MINIMUM_BATCHES_PER_CHUNK - 1) / MINIMUM_BATCHES_PER_CHUNK)
+      };
+
+      bool const depth_pre_pass{ depth_mode_ == DepthMode::PRE_PASS };
+
+      // per phase
+      std::array<std::vector<vk::CommandBuffer>, PHASE_COUNT> depth_pre_pass_command_buffers{};
+      std::array<std::vector<vk::CommandBuffer>, PHASE_COUNT> main_command_buffers{};
+      for (std::size_t phase_index{}; phase_index < PHASE_COUNT; ++phase_index)
+      {
+         depth_pre_pass_command_buffers[phase_index].resize(depth_pre_pass ? chunk_count : 0);
+         main_command_buffers[phase_index].resize(chunk_count);
+      }
+
+      thread_pool_.execute(chunk_count,
+         [&](std::size_t const chunk_index, std::size_t const thread_index) -> void
+         {
+            std::size_t const begin{ chunk_index * batches.size() / chunk_count };
+            std::size_t const end{ (chunk_index + 1) * batches.size() / chunk_count };
+            std::span const chunk{ std::span{ batches }.subspan(begin, end - begin) };
+
+            for (Phase const phase : { Phase::EARLY, Phase::LATE })
+            {
+               std::size_t const phase_index{ std::to_underlying(phase) };
+
+               if (depth_pre_pass)
+               {
+                  vk::raii::CommandBuffer const& command_buffer{ secondary_command_buffer(frame_data.frame_index, thread_index) };
+                  record_chunk(command_buffer, vk::CommandBufferUsageFlagBits::eOneTimeSubmit, Pass::DEPTH_PRE_PASS, phase,
+                     frame_data.frame_index, chunk, begin, buffers, scene.extent);
+                  depth_pre_pass_command_buffers[phase_index][chunk_index] = *command_buffer;
+               }
+
+               vk::raii::CommandBuffer const& command_buffer{ secondary_command_buffer(frame_data.frame_index, thread_index) };
+               record_chunk(command_buffer, vk::CommandBufferUsageFlagBits::eOneTimeSubmit, Pass::MAIN, phase,
+                  frame_data.frame_index, chunk, begin, buffers, scene.extent);
+               main_command_buffers[phase_index][chunk_index] = *command_buffer;
+            }
+         });
+
+      update_static_segments(frame_data.frame_index, recording_inputs(scene), view);
+
+      // static segments are culled every frame, even when their commands are replayed as they are
+      std::vector<CullList> cull_lists{
+         {
+            .buffers{ buffers },
+            .visibility{ visibility_ }
+         }
+      };
+      for (StaticSegment& static_segment : static_segments_ | std::views::values)
+      {
+         cull_lists.push_back({
+            .buffers{ static_segment.buffers[frame_data.frame_index] },
+            .visibility{ static_segment.visibility }
+         });
+
+         statistics_.draws += static_segment.statistics.draws;
+         statistics_.instanced_draws += static_segment.statistics.instanced_draws;
+         statistics_.material_binds += static_segment.statistics.material_binds;
+         statistics_.mesh_binds += static_segment.statistics.mesh_binds;
+         statistics_.avoided_material_binds += static_segment.statistics.avoided_material_binds;
+         statistics_.avoided_mesh_binds += static_segment.statistics.avoided_mesh_binds;
+
+         for (std::size_t phase_index{}; phase_index < PHASE_COUNT; ++phase_index)
+         {
+            std::size_t const command_buffer_index{ frame_data.frame_index * PHASE_COUNT + phase_index };
+            if (depth_pre_pass)
+               depth_pre_pass_command_buffers[phase_index].push_back(
+                  *static_segment.depth_pre_pass_command_buffers[command_buffer_index]);
+
+            main_command_buffers[phase_index].push_back(*static_segment.main_command_buffers[command_buffer_index]);
+         }
+      }
+
+      // last in the last main pass, with or without a pre-pass, so that the lines are tested against final depth
+      main_command_buffers[std::to_underlying(Phase::LATE)].push_back(
+         record_debug_draw(frame_data.frame_index, view_projection, scene.extent));
+
+      std::vector<vk::CommandBuffer> const& early_depth_pre_pass_command_buffers{
+         depth_pre_pass_command_buffers[std::to_underlying(Phase::EARLY)]
+      };
+      std::vector<vk::CommandBuffer> const& late_depth_pre_pass_command_buffers{
+         depth_pre_pass_command_buffers[std::to_underlying(Phase::LATE)]
+      };
+      std::vector<vk::CommandBuffer> const& early_main_command_buffers{ main_command_buffers[std::to_underlying(Phase::EARLY)] };
+      std::vector<vk::CommandBuffer> const& late_main_command_buffers{ main_command_buffers[std::to_underlying(Phase::LATE)] };
+
+      //======================================//
+
+      vk::Result result = frame_data.command_buffer.begin({
+         .flags{ vk::CommandBufferUsageFlagBits::eOneTimeSubmit }
+      });
       RUNTIME_ASSERT(result == vk::Result::eSuccess,
-         std::format("failed to bind vertex buffer's memory! ({})", to_string(result)));
+         std::format("failed to begin command buffer! ({})", to_string(result)));
+
+      std::uint32_t const first_timestamp{ frame_data.frame_index * TIMESTAMPS_PER_FRAME };
+      frame_data.command_buffer.resetQueryPool(timestamp_query_pool_, first_timestamp, TIMESTAMPS_PER_FRAME);
+
+      // ahead of everything that draws, so that both phases and every pass read the same skinned vertices; the skinner
+      // ends with a barrier from its compute writes to vertex input and storage reads in any graphics or compute stage
+      skinner_.record(frame_data.command_buffer, frame_data.frame_index);
+
+      frame_data.command_buffer.writeTimestamp2(vk::PipelineStageFlagBits2::eTopOfPipe, timestamp_query_pool_, first_timestamp);
+      light_clusters_.build(frame_data.command_buffer, frame_data.frame_index);
+      frame_data.command_buffer.writeTimestamp2(vk::PipelineStageFlagBits2::eAllCommands, timestamp_query_pool_, first_timestamp + 1);
+
+      frame_data.command_buffer.writeTimestamp2(vk::PipelineStageFlagBits2::eTopOfPipe, timestamp_query_pool_, first_timestamp + 2);
+      record_culling(frame_data.command_buffer, Phase::EARLY, cull_lists, frame_data.frame_index);
+      frame_data.command_buffer.writeTimestamp2(vk::PipelineStageFlagBits2::eAllCommands, timestamp_query_pool_, first_timestamp + 3);
+
+      std::array const begin_barriers{
+         std::to_array<vk::ImageMemoryBarrier2>({
+            {
+               // an offscreen scene was last read by the post-processing or the upscaling of the frame before
+               .srcStageMask{
+                  vk::PipelineStageFlagBits2::eColorAttachmentOutput |
+                  vk::PipelineStageFlagBits2::eComputeShader |
+                  vk::PipelineStageFlagBits2::eFragmentShader
+               },
+               .srcAccessMask{ vk::AccessFlagBits2::eNone },
+               .dstStageMask{ vk::PipelineStageFlagBits2::eColorAttachmentOutput },
+               .dstAccessMask{ vk::AccessFlagBits2::eColorAttachmentWrite },
+               .oldLayout{ vk::ImageLayout::eUndefined },
+               .newLayout{ vk::ImageLayout::eColorAttachmentOptimal },
+               .image{ scene.image },
+               .subresourceRange{
+                  .aspectMask{ vk::ImageAspectFlagBits::eColor },
+                  .levelCount{ 1 },
+                  .layerCount{ 1 }
+               }
+            },
+            {
+               .srcStageMask{ vk::PipelineStageFlagBits2::eEarlyFragmentTests | vk::PipelineStageFlagBits2::eLateFragmentTests },
+               .srcAccessMask{ vk::AccessFlagBits2::eDepthStencilAttachmentWrite },
+               .dstStageMask{ vk::PipelineStageFlagBits2::eEarlyFragmentTests | vk::PipelineStageFlagBits2::eLateFragmentTests },
+               .dstAccessMask{ vk::AccessFlagBits2::eDepthStencilAttachmentRead | vk::AccessFlagBits2::eDepthStencilAttachmentWrite },
+               .oldLayout{ vk::ImageLayout::eUndefined },
+               .newLayout{ vk::ImageLayout::eDepthAttachmentOptimal },
+               .image{ depth_image_ },
+               .subresourceRange{
+                  .aspectMask{ vk::ImageAspectFlagBits::eDepth },
+                  .levelCount{ 1 },
+                  .layerCount{ 1 }
+               }
+            }
+         })
+      };
+
+      frame_data.command_buffer.pipelineBarrier2({
+         .imageMemoryBarrierCount{ static_cast<std::uint32_t>(std::ranges::size(begin_barriers)) },
+         .pImageMemoryBarriers{ std::ranges::data(begin_barriers) }
+      });
+
+      // without a pre-pass, the main pass is split over both phases itself
+      frame_data.command_buffer.writeTimestamp2(vk::PipelineStageFlagBits2::eTopOfPipe, timestamp_query_pool_, first_timestamp + 4);
+      if (depth_pre_pass)
+         record_rendering(frame_data.command_buffer, Pass::DEPTH_PRE_PASS, scene, vk::AttachmentLoadOp::eDontCare,
+            vk::AttachmentLoadOp::eClear, vk::AttachmentStoreOp::eStore, early_depth_pre_pass_command_buffers);
+      else
+         record_rendering(frame_data.command_buffer, Pass::MAIN, scene, vk::AttachmentLoadOp::eClear,
+            vk::AttachmentLoadOp::eClear, vk::AttachmentStoreOp::eStore, early_main_command_buffers);
+      frame_data.command_buffer.writeTimestamp2(vk::PipelineStageFlagBits2::eAllCommands, timestamp_query_pool_, first_timestamp + 5);
+
+      frame_data.command_buffer.writeTimestamp2(vk::PipelineStageFlagBits2::eTopOfPipe, timestamp_query_pool_, first_timestamp + 6);
+      record_depth_pyramid(frame_data.command_buffer);
+      frame_data.command_buffer.writeTimestamp2(vk::PipelineStageFlagBits2::eAllCommands, timestamp_query_pool_, first_timestamp + 7);
+
+      frame_data.command_buffer.writeTimestamp2(vk::PipelineStageFlagBits2::eTopOfPipe, timestamp_query_pool_, first_timestamp + 8);
+      record_culling(frame_data.command_buffer, Phase::LATE, cull_lists, frame_data.frame_index);
+      frame_data.command_buffer.writeTimestamp2(vk::PipelineStageFlagBits2::eAllCommands, timestamp_query_pool_, first_timestamp + 9);
+
+      frame_data.command_buffer.writeTimestamp2(vk::PipelineStageFlagBits2::eTopOfPipe, timestamp_query_pool_, first_timestamp + 10);
+      if (depth_pre_pass)
+         record_rendering(frame_data.command_buffer, Pass::DEPTH_PRE_PASS, scene, vk::AttachmentLoadOp::eDontCare,
+            vk::AttachmentLoadOp::eLoad, vk::AttachmentStoreOp::eStore, late_depth_pre_pass_command_buffers);
+      else
+         record_rendering(frame_data.command_buffer, Pass::MAIN, scene, vk::AttachmentLoadOp::eLoad,
+            vk::AttachmentLoadOp::eLoad, vk::AttachmentStoreOp::eDontCare, late_main_command_buffers);
+      frame_data.command_buffer.writeTimestamp2(vk::PipelineStageFlagBits2::eAllCommands, timestamp_query_pool_, first_timestamp + 11);
+
+      frame_data.command_buffer.writeTimestamp2(vk::PipelineStageFlagBits2::eTopOfPipe, timestamp_query_pool_, first_timestamp + 12);
+      if (depth_pre_pass)
+      {
+         vk::ImageMemoryBarrier2 const depth_barrier{
+            .srcStageMask{ vk::PipelineStageFlagBits2::eLateFragmentTests },
+            .srcAccessMask{ vk::AccessFlagBits2::eDepthStencilAttachmentWrite },
+            .dstStageMask{ vk::PipelineStageFlagBits2::eEarlyFragmentTests | vk::PipelineStageFlagBits2::eLateFragmentTests },
+            .dstAccessMask{ vk::AccessFlagBits2::eDepthStencilAttachmentRead },
+            .oldLayout{ vk::ImageLayout::eDepthAttachmentOptimal },
+            .newLayout{ vk::ImageLayout::eDepthAttachmentOptimal },
+            .image{ depth_image_ },
+            .subresourceRange{
+               .aspectMask{ vk::ImageAspectFlagBits::eDepth },
+               .levelCount{ 1 },
+               .layerCount{ 1 }
+            }
+         };
+
+         frame_data.command_buffer.pipelineBarrier2({
+            .imageMemoryBarrierCount{ 1 },
+            .pImageMemoryBarriers{ &depth_barrier }
+         });
+
+         // depth is final once both phases have been through the pre-pass, so everything drawn in either gets shaded
+         std::vector<vk::CommandBuffer> shading_command_buffers{ early_main_command_buffers };
+         shading_command_buffers.append_range(late_main_command_buffers);
+         record_rendering(frame_data.command_buffer, Pass::MAIN, scene, vk::AttachmentLoadOp::eClear,
+            vk::AttachmentLoadOp::eLoad, vk::AttachmentStoreOp::eDontCare, shading_command_buffers);
+      }
+      frame_data.command_buffer.writeTimestamp2(vk::PipelineStageFlagBits2::eAllCommands, timestamp_query_pool_, first_timestamp + 13);
+
+      frame_data.command_buffer.writeTimestamp2(vk::PipelineStageFlagBits2::eTopOfPipe, timestamp_query_pool_, first_timestamp + 14);
+      if (post_processor_)
+         record_post_processing(frame_data.command_buffer, scene);
+      frame_data.command_buffer.writeTimestamp2(vk::PipelineStageFlagBits2::eAllCommands, timestamp_query_pool_, first_timestamp + 15);
+
+      frame_data.command_buffer.writeTimestamp2(vk::PipelineStageFlagBits2::eTopOfPipe, timestamp_query_pool_, first_timestamp + 16);
+      if (post_processor_)
+         record_upscaling(frame_data.command_buffer,
+            { post_processor_->image(), post_processor_->image_view(), post_processor_->extent(), PostProcessor::OUTPUT_FORMAT },
+            target);
+      else if (resolution_controller_)
+         record_upscaling(frame_data.command_buffer, scene, target);
+      frame_data.command_buffer.writeTimestamp2(vk::PipelineStageFlagBits2::eAllCommands, timestamp_query_pool_, first_timestamp + 17);
+
+      vk::ImageMemoryBarrier2 const end_barrier{
+         .srcStageMask{ vk::PipelineStageFlagBits2::eColorAttachmentOutput },
+         .srcAccessMask{ vk::AccessFlagBits2::eColorAttachmentWrite },
+         .dstStageMask{ vk::PipelineStageFlagBits2::eColorAttachmentOutput },
+         .dstAccessMask{ vk::AccessFlagBits2::eNone },
+         .oldLayout{ vk::ImageLayout::eColorAttachmentOptimal },
+         .newLayout{ vk::ImageLayout::ePresentSrcKHR },
+         .image{ target.image },
+         .subresourceRange{
+            .aspectMask{ vk::ImageAspectFlagBits::eColor },
+            .levelCount{ 1 },
+            .layerCount{ 1 }
+         }
+      };
+
+      frame_data.command_buffer.pipelineBarrier2(
+         {
+            .imageMemoryBarrierCount{ 1 },
+            .pImageMemoryBarriers{ &end_barrier }
+         });
+
+      result = frame_data.command_buffer.end();
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to end command buffer! ({})", to_string(result)));
+
+      recorded_depth_modes_[frame_data.frame_index] = depth_mode_;
+      timings_.recording = std::chrono::high_resolution_clock::now() - recording_start;
+   }
+
+   auto Renderer::change_depth_mode(DepthMode const depth_mode) -> void
+   {
+      depth_mode_ = depth_mode;
+   }
+
+   auto Renderer::depth_mode() const -> DepthMode
+   {
+      return depth_mode_;
+   }
+
+   auto Renderer::change_dynamic_resolution(std::optional<ResolutionController::Settings> const& settings) -> void
+   {
+      if (not settings)
+         resolution_controller_.reset();
+      else if (resolution_controller_)
+         resolution_controller_->change_settings(*settings);
+      else
+         resolution_controller_.emplace(*settings);
+   }
+
+   auto Renderer::dynamic_resolution() const -> std::optional<ResolutionController::Settings>
+   {
+      if (not resolution_controller_)
+         return std::nullopt;
+
+      return resolution_controller_->settings();
+   }
+
+   auto Renderer::change_post_processing(PostProcessor::Settings const& settings) -> void
+   {
+      RUNTIME_ASSERT(post_processor_,
+         "post-processing was not enabled in the renderer's description!");
+
+      post_processor_->change_settings(settings);
+   }
+
+   auto Renderer::post_processing() const -> std::optional<PostProcessor::Settings>
+   {
+      if (not post_processor_)
+         return std::nullopt;
+
+      return post_processor_->settings();
+   }
+
+   auto Renderer::debug_draw() -> DebugDraw&
+   {
+      return debug_draw_;
+   }
+
+   auto Renderer::skinner() -> Skinner&
+   {
+      return skinner_;
+   }
+
+   auto Renderer::resolution_scale() const -> float
+   {
+      return resolution_controller_ ? resolution_controller_->scale() : 1.0f;
+   }
+
+   auto Renderer::timings() const -> Timings const&
+   {
+      return timings_;
+   }
+
+   auto Renderer::statistics() const -> Statistics const&
+   {
+      return statistics_;
+   }
+
+   auto Renderer::visibility_counters() const -> VisibilityCounters const&
+   {
+      return visibility_counters_;
+   }
+
+   auto Renderer::read_timings(std::uint8_t const frame_index) -> void
+   {
+      std::optional<DepthMode> const recorded_depth_mode{ recorded_depth_modes_[frame_index] };
+      if (not recorded_depth_mode)
+         return;
+
+      // the frame that last used this index has been waited on before it is recorded again, so no need to wait here
+      vk::ResultValue const timestamps{
+         timestamp_query_pool_.getResults<std::uint64_t>(frame_index * TIMESTAMPS_PER_FRAME, TIMESTAMPS_PER_FRAME,
+            TIMESTAMPS_PER_FRAME * sizeof(std::uint64_t), sizeof(std::uint64_t), vk::QueryResultFlagBits::e64)
+      };
+      if (timestamps.result not_eq vk::Result::eSuccess)
+         return;
+
+      auto const duration{
+         [this](std::uint64_t const begin, std::uint64_t const end) -> std::chrono::duration<double, std::milli>
+         {
+            return std::chrono::duration<double, std::nano>{ static_cast<double>(end - begin) * timestamp_period_ };
+         }
+      };
+
+      auto const rendering{ duration(timestamps.value[4], timestamps.value[5]) + duration(timestamps.value[10], timestamps.value[11]) };
+
+      timings_.light_clustering = duration(timestamps.value[0], timestamps.value[1]);
+      timings_.culling = duration(timestamps.value[2], timestamps.value[3]) + duration(timestamps.value[8], timestamps.value[9]);
+      timings_.depth_pyramid = duration(timestamps.value[6], timestamps.value[7]);
+      if (*recorded_depth_mode == DepthMode::PRE_PASS)
+      {
+         timings_.depth_pre_pass = rendering;
+         timings_.main_pass = duration(timestamps.value[12], timestamps.value[13]);
+      }
+      else
+      {
+         timings_.depth_pre_pass = {};
+         timings_.main_pass = rendering;
+      }
+
+      timings_.post_processing = duration(timestamps.value[14], timestamps.value[15]);
+      timings_.upscaling = duration(timestamps.value[16], timestamps.value[17]);
+      timings_.frame = duration(timestamps.value[0], timestamps.value[17]);
+
+      if (resolution_controller_)
+         resolution_controller_->update(timings_.frame);
+   }
+
+   auto Renderer::read_visibility_counters(std::uint8_t const frame_index) -> void
+   {
+      if (not recorded_depth_modes_[frame_index])
+         return;
+
+      // made available to the host by the late culling pass, and that frame has been waited on by now
+      visibility_counters_ = *cull_frame_buffers_[frame_index].counters.elements;
+   }
+
+   auto Renderer::prepare_depth_image(vk::Extent2D const extent) -> void
+   {
+      if (extent == depth_image_extent_)
+         return;
+
+      // the depth image and its pyramid are shared by all frames in flight, so rather than waiting for all of them, the
+      // old ones are kept around until they are done
+      retire(depth_pyramid_.resize(extent));
+
+      struct RetiredDepthImage final
+      {
+         vk::raii::Image image;
+         vk::raii::DeviceMemory memory;
+         vk::raii::ImageView view;
+      };
+
+      retire({
+         new RetiredDepthImage{ std::move(depth_image_), std::move(depth_image_memory_), std::move(depth_image_view_) },
+         void_deleter<RetiredDepthImage>
+      });
+
+      depth_image_ = depth_image(extent);
+      depth_image_memory_ = depth_image_memory();
+
+      vk::Result const bind_result{ depth_image_.bindMemory(depth_image_memory_, 0) };
+      RUNTIME_ASSERT(bind_result == vk::Result::eSuccess,
+         std::format("failed to bind depth image's memory! ({})", to_string(bind_result)));
+
+      depth_image_view_ = depth_image_view();
+      depth_image_extent_ = extent;
+   }
+
+   auto Renderer::prepare_color_image(vk::Extent2D const extent) -> void
+   {
+      if (extent == color_image_extent_)
+         return;
+
+      // like the depth image, shared by all frames in flight
+      struct RetiredColorImage final
+      {
+         vk::raii::Image image;
+         vk::raii::DeviceMemory memory;
+         vk::raii::ImageView view;
+      };
+
+      retire({
+         new RetiredColorImage{ std::move(color_image_), std::move(color_image_memory_), std::move(color_image_view_) },
+         void_deleter<RetiredColorImage>
+      });
+
+      color_image_ = color_image(extent);
+      color_image_memory_ = color_image_memory();
+
+      vk::Result const bind_result{ color_image_.bindMemory(color_image_memory_, 0) };
+      RUNTIME_ASSERT(bind_result == vk::Result::eSuccess,
+         std::format("failed to bind color image's memory! ({})", to_string(bind_result)));
+
+      color_image_view_ = color_image_view();
+      color_image_extent_ = extent;
+
+      if (post_processor_)
+         retire(post_processor_->resize(extent));
+   }
+
+   auto Renderer::retire(UniquePointer<void> resources) -> void
+   {
+      if (resources)
+         retired_resources_.push_back({
+            .resources{ std::move(resources) },
+            .remaining_frames{ MAX_FRAMES_IN_FLIGHT }
+         });
+   }
+
+   auto Renderer::release_retired_resources() -> void
+   {
+      for (RetiredResources& retired_resources : retired_resources_)
+         --retired_resources.remaining_frames;
+
+      std::erase_if(retired_resources_,
+         [](RetiredResources const& retired_resources) -> bool
+         {
+            return not retired_resources.remaining_frames;
+         });
+   }
+
+   auto Renderer::scene_format() const -> vk::Format
+   {
+      return post_processor_ ? PostProcessor::SOURCE_FORMAT : description_.color_format;
+   }
+
+   auto Renderer::scene_target(Target const& target) -> Target
+   {
+      if (not resolution_controller_ and not post_processor_)
+         return target;
+
+      float const scale{ resolution_controller_ ? resolution_controller_->scale() : 1.0f };
+      vk::Extent2D const extent{
+         std::max(static_cast<std::uint32_t>(std::lround(target.extent.width * scale)), 1u),
+         std::max(static_cast<std::uint32_t>(std::lround(target.extent.height * scale)), 1u)
+      };
+      prepare_color_image(extent);
+
+      return {
+         .image{ color_image_ },
+         .image_view{ color_image_view_ },
+         .extent{ extent },
+         .format{ scene_format() }
+      };
+   }
+
+   auto Renderer::reset_recording_pools(std::uint8_t const frame_index) -> void
+   {
+      std::size_t const thread_count{ thread_pool_.thread_count() };
+      for (std::size_t thread_index{}; thread_index < thread_count; ++thread_index)
+      {
+         RecordingPool& recording_pool{ recording_pools_[frame_index * thread_count + thread_index] };
+
+         vk::Result const result{ recording_pool.command_pool.reset() };
+         RUNTIME_ASSERT(result == vk::Result::eSuccess,
+            std::format("failed to reset a recording command pool! ({})", to_string(result)));
+
+         recording_pool.used_command_buffers = 0;
+      }
+   }
+
+   auto Renderer::secondary_command_buffer(std::uint8_t const frame_index, std::size_t const thread_index) -> vk::raii::CommandBuffer const&
+   {
+      RecordingPool& recording_pool{ recording_pools_[frame_index * thread_pool_.thread_count() + thread_index] };
+      if (recording_pool.used_command_buffers == recording_pool.command_buffers.size())
+      {
+         vk::ResultValue command_buffers{
+            context_.device.allocateCommandBuffers({
+               .commandPool{ recording_pool.command_pool },
+               .level{ vk::CommandBufferLevel::eSecondary },
+               .commandBufferCount{ 1 }
+            })
+         };
+         RUNTIME_ASSERT(command_buffers.has_value(),
+            std::format("failed to allocate a secondary command buffer! ({})", to_string(command_buffers.result)));
+
+         recording_pool.command_buffers.push_back(std::move(command_buffers->front()));
+      }
 
-      vk::DeviceSize const vertex_buffer_size{ sizeof(decltype(vertices_)::value_type) * vertices_.size() };
-      vk::raii::Buffer const vertex_staging_buffer{
-         context_.create_buffer({
-            .size{ vertex_buffer_size },
-            .usage{ vk::BufferUsageFlagBits::eTransferSrc },
-            .sharingMode{ vk::SharingMode::eExclusive }
-         })
-      };
+      return recording_pool.command_buffers[recording_pool.used_command_buffers++];
+   }
 
-      vk::raii::DeviceMemory const vertex_staging_buffer_memory{
-         context_.allocate_memory(vertex_staging_buffer.getMemoryRequirements(),
-            vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)
+   auto Renderer::batch(std::span<Draw const> const draws, glm::mat4 const& view, DrawListBuffers& buffers,
+      Statistics& statistics) const -> std::vector<Batch>
+   {
+      DrawQueue draw_queue{};
+      draw_queue.reserve(draws.size());
+      for (std::size_t index{}; index < draws.size(); ++index)
+      {
+         Draw const& draw{ draws[index] };
+         RUNTIME_ASSERT(draw.mesh < meshes_.size(),
+            std::format("mesh {} does not exist!", draw.mesh));
+         RUNTIME_ASSERT(draw.material < materials_.size(),
+            std::format("material {} does not exist!", draw.material));
+
+         draw_queue.push({
+               .material{ draw.material },
+               .mesh{ draw.mesh },
+               .depth{ -(view * draw.transform[3]).z }
+            },
+            static_cast<std::uint32_t>(index));
+      }
+
+      draw_queue.sort();
+
+      // sorted entries sharing a state are contiguous, so every run of them becomes one instanced draw
+      reserve(buffers.instances, draws.size(), vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eStorageBuffer);
+      std::vector<Batch> batches{};
+      std::uint64_t batch_state{};
+      std::uint32_t instance_index{};
+      for (DrawQueue::Entry const& entry : draw_queue.entries())
+      {
+         Draw const& draw{ draws[entry.index] };
+         std::uint64_t const state{ entry.key & DrawQueue::Key::STATE_MASK };
+         if (batches.empty() or state not_eq batch_state)
+         {
+            batches.push_back({
+               .mesh{ draw.mesh },
+               .material{ draw.material },
+               .first_instance{ instance_index }
+            });
+            batch_state = state;
+         }
+
+         ++batches.back().instance_count;
+         buffers.instances.elements[instance_index++] = {
+            .transform{ draw.transform },
+            .id{ draw.id }
+         };
+      }
+
+      // without mesh shaders, every meshlet of every instance may end up with a command of its own
+      reserve(buffers.batches, batches.size(), vk::BufferUsageFlagBits::eStorageBuffer);
+      std::uint32_t command_count{};
+      for (std::size_t index{}; index < batches.size(); ++index)
+      {
+         Batch& batch{ batches[index] };
+         Mesh const& mesh{ meshes_[batch.mesh] };
+         batch.first_command = command_count;
+         batch.command_count = context_.mesh_shader_support ? batch.instance_count : batch.instance_count * mesh.meshlet_count;
+         command_count += batch.command_count;
+
+         buffers.batches.elements[index] = {
+            .bounding_sphere{ mesh.bounding_sphere },
+            .first_instance{ batch.first_instance },
+            .instance_count{ batch.instance_count },
+            .first_meshlet{ mesh.first_meshlet },
+            .meshlet_count{ mesh.meshlet_count },
+            .first_command{ batch.first_command },
+            .first_index{ mesh.first_index },
+            .base_vertex{ mesh.base_vertex }
+         };
+      }
+
+      reserve(buffers.commands, PHASE_COUNT * command_count,
+         vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer);
+      reserve(buffers.draw_counts, PHASE_COUNT * batches.size(),
+         vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer | vk::BufferUsageFlagBits::eTransferDst);
+
+      buffers.batch_count = static_cast<std::uint32_t>(batches.size());
+      buffers.instance_count = static_cast<std::uint32_t>(draws.size());
+      buffers.command_count = command_count;
+
+      DrawQueue::StateChanges const& submission_state_changes{ draw_queue.submission_state_changes() };
+      DrawQueue::StateChanges const& sorted_state_changes{ draw_queue.sorted_state_changes() };
+      statistics = {
+         .draws{ draws.size() },
+         .instanced_draws{ batches.size() },
+         .material_binds{ sorted_state_changes.materials },
+         .mesh_binds{ sorted_state_changes.meshes },
+         .avoided_material_binds{ submission_state_changes.materials - sorted_state_changes.materials },
+         // sorting by material first may split up meshes that were drawn together
+         .avoided_mesh_binds{
+            submission_state_changes.meshes - std::min(submission_state_changes.meshes, sorted_state_changes.meshes)
+         }
       };
 
-      result = vertex_staging_buffer.bindMemory(vertex_staging_buffer_memory, 0);
-      RUNTIME_ASSERT(result == vk::Result::eSuccess,
-         std::format("failed to bind vertex staging buffer's memory! ({})", to_string(result)));
+      return batches;
+   }
 
-      vk::ResultValue mapped_memory{ vertex_staging_buffer_memory.mapMemory(0, vertex_buffer_size) };
-      RUNTIME_ASSERT(mapped_memory.has_value(),
-         std::format("failed to map vertex staging buffer's memory! ({})", to_string(mapped_memory.result)));
+   template<typename Element>
+   auto Renderer::reserve(MappedBuffer<Element>& buffer, std::size_t const count, vk::BufferUsageFlags const usage) const -> void
+   {
+      if (count <= buffer.capacity)
+         return;
 
-      std::memcpy(*mapped_memory, vertices_.data(), vertex_buffer_size);
-      vertex_staging_buffer_memory.unmapMemory();
+      buffer = mapped_buffer<Element>(std::bit_ceil(std::max(count, MINIMUM_BUFFER_CAPACITY)), usage);
+   }
 
-      //
+   template<typename Element>
+   auto Renderer::reserve(DeviceBuffer<Element>& buffer, std::size_t const count, vk::BufferUsageFlags const usage) const -> void
+   {
+      if (count <= buffer.capacity)
+         return;
 
-      result = index_buffer_.bindMemory(index_buffer_memory_, 0);
-      RUNTIME_ASSERT(result == vk::Result::eSuccess,
-         std::format("failed to bind index buffer's memory! ({})", to_string(result)));
+      buffer = device_buffer<Element>(std::bit_ceil(std::max(count, MINIMUM_BUFFER_CAPACITY)), usage);
+   }
 
-      vk::DeviceSize const index_buffer_size{ sizeof(decltype(indices_)::value_type) * indices_.size() };
-      vk::raii::Buffer const index_staging_buffer{
-         context_.create_buffer({
-            .size{ index_buffer_size },
-            .usage{ vk::BufferUsageFlagBits::eTransferSrc },
-            .sharingMode{ vk::SharingMode::eExclusive }
-         })
-      };
+   auto Renderer::reserve_visibility(Visibility& visibility, std::span<Draw const> const draws) -> void
+   {
+      if (draws.empty())
+         return;
+
+      std::size_t const count{ std::ranges::max(draws, {}, &Draw::id).id + 1uz };
+      if (count <= visibility.flags.capacity)
+         return;
+
+      // the flags are shared by all frames in flight, so the old ones are kept around until they are done
+      if (visibility.flags.capacity)
+         retire({
+            new DeviceBuffer<std::uint32_t>{ std::exchange(visibility.flags, {}) },
+            void_deleter<DeviceBuffer<std::uint32_t>>
+         });
 
-      vk::raii::DeviceMemory const index_staging_buffer_memory{
-         context_.allocate_memory(index_staging_buffer.getMemoryRequirements(),
-            vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)
-      };
+      // nothing is known about what was visible before, so everything starts out drawn in the early phase
+      reserve(visibility.flags, count, vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst);
+      visibility.initialized = false;
+   }
 
-      result = index_staging_buffer.bindMemory(index_staging_buffer_memory, 0);
-      RUNTIME_ASSERT(result == vk::Result::eSuccess,
-         std::format("failed to bind index staging buffer's memory! ({})", to_string(result)));
+   auto Renderer::record_culling(vk::raii::CommandBuffer const& command_buffer, Phase const phase,
+      std::span<CullList const> const cull_lists, std::uint8_t const frame_index) const -> void
+   {
+      CullFrameBuffers const& frame_buffers{ cull_frame_buffers_[frame_index] };
 
-      mapped_memory = index_staging_buffer_memory.mapMemory(0, index_buffer_size);
-      RUNTIME_ASSERT(mapped_memory.has_value(),
-         std::format("failed to map index staging buffer's memory! ({})", to_string(mapped_memory.result)));
+      // the draw counts of both phases are cleared up front, along with the counters and any new visibility
+      if (phase == Phase::EARLY)
+      {
+         for (CullList const& cull_list : cull_lists)
+         {
+            if (cull_list.buffers.batch_count)
+               command_buffer.fillBuffer(cull_list.buffers.draw_counts.buffer, 0,
+                  PHASE_COUNT * cull_list.buffers.batch_count * sizeof(DrawCount), 0);
+
+            if (cull_list.visibility.flags.capacity and not cull_list.visibility.initialized)
+            {
+               command_buffer.fillBuffer(cull_list.visibility.flags.buffer, 0, vk::WholeSize, 1);
+               cull_list.visibility.initialized = true;
+            }
+         }
 
-      std::memcpy(*mapped_memory, indices_.data(), index_buffer_size);
-      index_staging_buffer_memory.unmapMemory();
+         command_buffer.fillBuffer(frame_buffers.counters.buffer, 0, vk::WholeSize, 0);
+      }
 
-      //
+      // also orders this phase's visibility accesses after those of the phase, or the frame, before it
+      vk::MemoryBarrier2 const begin_barrier{
+         .srcStageMask{ vk::PipelineStageFlagBits2::eClear | vk::PipelineStageFlagBits2::eComputeShader },
+         .srcAccessMask{ vk::AccessFlagBits2::eTransferWrite | vk::AccessFlagBits2::eShaderStorageWrite },
+         .dstStageMask{ vk::PipelineStageFlagBits2::eComputeShader },
+         .dstAccessMask{ vk::AccessFlagBits2::eShaderStorageRead | vk::AccessFlagBits2::eShaderStorageWrite }
+      };
 
-      result = image_.bindMemory(image_memory_, 0);
-      RUNTIME_ASSERT(result == vk::Result::eSuccess,
-         std::format("failed to bind image buffer's memory! ({})", to_string(result)));
+      command_buffer.pipelineBarrier2({
+         .memoryBarrierCount{ 1 },
+         .pMemoryBarriers{ &begin_barrier }
+      });
 
-      image_view_ = image_view();
+      command_buffer.bindPipeline(vk::PipelineBindPoint::eCompute,
+         phase == Phase::EARLY ? early_cull_pipeline_ : late_cull_pipeline_);
 
-      vk::DeviceSize const image_buffer_size{ texture_->dataSize };
-      vk::raii::Buffer const image_staging_buffer{
-         context_.create_buffer({
-            .size{ image_buffer_size },
-            .usage{ vk::BufferUsageFlagBits::eTransferSrc },
-            .sharingMode{ vk::SharingMode::eExclusive }
-         })
+      CullConstants cull_constants{
+         .instance_stride{ sizeof(Instance) },
+         .mesh_shading{ context_.mesh_shader_support }
       };
 
-      vk::raii::DeviceMemory const image_staging_buffer_memory{
-         context_.allocate_memory(image_staging_buffer.getMemoryRequirements(),
-            vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)
+      vk::DescriptorBufferInfo const counters_info{ .buffer{ frame_buffers.counters.buffer }, .range{ vk::WholeSize } };
+      vk::DescriptorBufferInfo const frame_info{ .buffer{ frame_buffers.frame.buffer }, .range{ vk::WholeSize } };
+      vk::DescriptorBufferInfo const meshlets_info{ .buffer{ meshlet_buffer_.buffer }, .range{ vk::WholeSize } };
+      vk::DescriptorImageInfo const depth_pyramid_info{
+         .imageView{ depth_pyramid_.image_view() },
+         .imageLayout{ vk::ImageLayout::eGeneral }
       };
 
-      result = image_staging_buffer.bindMemory(image_staging_buffer_memory, 0);
-      RUNTIME_ASSERT(result == vk::Result::eSuccess,
-         std::format("failed to bind image staging buffer's memory! ({})", to_string(result)));
+      for (CullList const& cull_list : cull_lists)
+      {
+         DrawListBuffers const& buffers{ cull_list.buffers };
+         if (not buffers.instance_count)
+            continue;
+
+         vk::DescriptorBufferInfo const instances_info{ .buffer{ buffers.instances.buffer }, .range{ vk::WholeSize } };
+         vk::DescriptorBufferInfo const batches_info{ .buffer{ buffers.batches.buffer }, .range{ vk::WholeSize } };
+         vk::DescriptorBufferInfo const commands_info{ .buffer{ buffers.commands.buffer }, .range{ vk::WholeSize } };
+         vk::DescriptorBufferInfo const draw_counts_info{ .buffer{ buffers.draw_counts.buffer }, .range{ vk::WholeSize } };
+         vk::DescriptorBufferInfo const visibility_info{ .buffer{ cull_list.visibility.flags.buffer }, .range{ vk::WholeSize } };
+
+         std::array const writes{
+            std::to_array<vk::WriteDescriptorSet>({
+               {
+                  .dstBinding{ 0 },
+                  .descriptorCount{ 1 },
+                  .descriptorType{ vk::DescriptorType::eStorageBuffer },
+                  .pBufferInfo{ &instances_info }
+               },
+               {
+                  .dstBinding{ 1 },
+                  .descriptorCount{ 1 },
+                  .descriptorType{ vk::DescriptorType::eStorageBuffer },
+                  .pBufferInfo{ &batches_info }
+               },
+               {
+                  .dstBinding{ 2 },
+                  .descriptorCount{ 1 },
+                  .descriptorType{ vk::DescriptorType::eStorageBuffer },
+                  .pBufferInfo{ &commands_info }
+               },
+               {
+                  .dstBinding{ 3 },
+                  .descriptorCount{ 1 },
+                  .descriptorType{ vk::DescriptorType::eStorageBuffer },
+                  .pBufferInfo{ &draw_counts_info }
+               },
+               {
+                  .dstBinding{ 4 },
+                  .descriptorCount{ 1 },
+                  .descriptorType{ vk::DescriptorType::eStorageBuffer },
+                  .pBufferInfo{ &visibility_info }
+               },
+               {
+                  .dstBinding{ 5 },
+                  .descriptorCount{ 1 },
+                  .descriptorType{ vk::DescriptorType::eStorageBuffer },
+                  .pBufferInfo{ &counters_info }
+               },
+               {
+                  .dstBinding{ 6 },
+                  .descriptorCount{ 1 },
+                  .descriptorType{ vk::DescriptorType::eUniformBuffer },
+                  .pBufferInfo{ &frame_info }
+               },
+               {
+                  .dstBinding{ 7 },
+                  .descriptorCount{ 1 },
+                  .descriptorType{ vk::DescriptorType::eStorageBuffer },
+                  .pBufferInfo{ &meshlets_info }
+               },
+               {
+                  .dstBinding{ 8 },
+                  .descriptorCount{ 1 },
+                  .descriptorType{ vk::DescriptorType::eSampledImage },
+                  .pImageInfo{ &depth_pyramid_info }
+               }
+            })
+         };
 
-      mapped_memory = image_staging_buffer_memory.mapMemory(0, image_buffer_size);
-      RUNTIME_ASSERT(mapped_memory.has_value(),
-         std::format("failed to map image staging buffer's memory! ({})", to_string(mapped_memory.result)));
+         // the early phase does not read the pyramid, which has not been built yet at that point
+         command_buffer.pushDescriptorSet(vk::PipelineBindPoint::eCompute, cull_pipeline_layout_, 0,
+            std::span{ writes }.first(phase == Phase::EARLY ? writes.size() - 1 : writes.size()));
 
-      std::memcpy(*mapped_memory, texture_->pData, image_buffer_size);
-      image_staging_buffer_memory.unmapMemory();
+         cull_constants.batch_count = buffers.batch_count;
+         cull_constants.instance_count = buffers.instance_count;
+         cull_constants.command_count = buffers.command_count;
+         command_buffer.pushConstants<CullConstants>(cull_pipeline_layout_, vk::ShaderStageFlagBits::eCompute, 0, cull_constants);
 
-      //
+         command_buffer.dispatch((buffers.instance_count + CULLING_WORKGROUP_SIZE - 1) / CULLING_WORKGROUP_SIZE, 1, 1);
+      }
 
-      // result = depth_image_.bindMemory(depth_image_memory_, 0);
-      // RUNTIME_ASSERT(result == vk::Result::eSuccess,
-      //    std::format("failed to bind depth image's memory! ({})", to_string(result)));
-      //
-      // depth_image_view_ = depth_image_view();
+      // the counters are read back by the host once the frame has completed; task shaders read the commands themselves
+      vk::MemoryBarrier2 const cull_barrier{
+         .srcStageMask{ vk::PipelineStageFlagBits2::eComputeShader },
+         .srcAccessMask{ vk::AccessFlagBits2::eShaderStorageWrite },
+         .dstStageMask{
+            vk::PipelineStageFlagBits2::eDrawIndirect | vk::PipelineStageFlagBits2::eHost |
+            (context_.mesh_shader_support ? vk::PipelineStageFlagBits2::eTaskShaderEXT : vk::PipelineStageFlagBits2::eNone)
+         },
+         .dstAccessMask{
+            vk::AccessFlagBits2::eIndirectCommandRead | vk::AccessFlagBits2::eHostRead |
+            (context_.mesh_shader_support ? vk::AccessFlagBits2::eShaderStorageRead : vk::AccessFlagBits2::eNone)
+         }
+      };
 
-      //
+      command_buffer.pipelineBarrier2({
+         .memoryBarrierCount{ 1 },
+         .pMemoryBarriers{ &cull_barrier }
+      });
+   }
 
-      vk::ResultValue const command_buffers{
-         context_.device.allocateCommandBuffers({
-            .commandPool{ context_.command_pool },
-            .level{ vk::CommandBufferLevel::ePrimary },
-            .commandBufferCount{ 1 }
-         })
+   auto Renderer::record_depth_pyramid(vk::raii::CommandBuffer const& command_buffer) const -> void
+   {
+      vk::ImageMemoryBarrier2 const read_barrier{
+         .srcStageMask{ vk::PipelineStageFlagBits2::eLateFragmentTests },
+         .srcAccessMask{ vk::AccessFlagBits2::eDepthStencilAttachmentWrite },
+         .dstStageMask{ vk::PipelineStageFlagBits2::eComputeShader },
+         .dstAccessMask{ vk::AccessFlagBits2::eShaderSampledRead },
+         .oldLayout{ vk::ImageLayout::eDepthAttachmentOptimal },
+         .newLayout{ vk::ImageLayout::eShaderReadOnlyOptimal },
+         .image{ depth_image_ },
+         .subresourceRange{
+            .aspectMask{ vk::ImageAspectFlagBits::eDepth },
+            .levelCount{ 1 },
+            .layerCount{ 1 }
+         }
       };
-      RUNTIME_ASSERT(command_buffers.has_value(),
-         std::format("failed to allocate a command buffer! ({})", to_string(command_buffers.result)));
 
-      result = command_buffers->front().begin({
-         .flags{ vk::CommandBufferUsageFlagBits::eOneTimeSubmit }
+      command_buffer.pipelineBarrier2({
+         .imageMemoryBarrierCount{ 1 },
+         .pImageMemoryBarriers{ &read_barrier }
       });
-      RUNTIME_ASSERT(result == vk::Result::eSuccess,
-         std::format("failed to begin command buffer! ({})", to_string(result)));
 
-      std::array const vertex_buffer_copy_regions{
-         std::to_array<vk::BufferCopy2>({
-            {
-               .size{ vertex_buffer_size }
-            }
-         })
+      depth_pyramid_.build(command_buffer, depth_image_, depth_image_view_);
+
+      vk::ImageMemoryBarrier2 const write_barrier{
+         .srcStageMask{ vk::PipelineStageFlagBits2::eComputeShader },
+         .srcAccessMask{ vk::AccessFlagBits2::eNone },
+         .dstStageMask{ vk::PipelineStageFlagBits2::eEarlyFragmentTests | vk::PipelineStageFlagBits2::eLateFragmentTests },
+         .dstAccessMask{ vk::AccessFlagBits2::eDepthStencilAttachmentRead | vk::AccessFlagBits2::eDepthStencilAttachmentWrite },
+         .oldLayout{ vk::ImageLayout::eShaderReadOnlyOptimal },
+         .newLayout{ vk::ImageLayout::eDepthAttachmentOptimal },
+         .image{ depth_image_ },
+         .subresourceRange{
+            .aspectMask{ vk::ImageAspectFlagBits::eDepth },
+            .levelCount{ 1 },
+            .layerCount{ 1 }
+         }
+      };
+
+      // the late phase renders on top of whatever the early phase left in the color attachment
+      vk::MemoryBarrier2 const color_barrier{
+         .srcStageMask{ vk::PipelineStageFlagBits2::eColorAttachmentOutput },
+         .srcAccessMask{ vk::AccessFlagBits2::eColorAttachmentWrite },
+         .dstStageMask{ vk::PipelineStageFlagBits2::eColorAttachmentOutput },
+         .dstAccessMask{ vk::AccessFlagBits2::eColorAttachmentRead | vk::AccessFlagBits2::eColorAttachmentWrite }
       };
-      command_buffers->front().copyBuffer2({
-         .srcBuffer{ vertex_staging_buffer },
-         .dstBuffer{ vertex_buffer_ },
-         .regionCount{ static_cast<std::uint32_t>(std::ranges::size(vertex_buffer_copy_regions)) },
-         .pRegions{ std::ranges::data(vertex_buffer_copy_regions) }
+
+      command_buffer.pipelineBarrier2({
+         .memoryBarrierCount{ 1 },
+         .pMemoryBarriers{ &color_barrier },
+         .imageMemoryBarrierCount{ 1 },
+         .pImageMemoryBarriers{ &write_barrier }
       });
+   }
 
-      std::array const index_buffer_copy_regions{
-         std::to_array<vk::BufferCopy2>({
-            {
-               .size{ index_buffer_size }
-            }
+   auto Renderer::record_debug_draw(std::uint8_t const frame_index, glm::mat4 const& view_projection,
+      vk::Extent2D const extent) -> vk::CommandBuffer
+   {
+      vk::raii::CommandBuffer const& command_buffer{ secondary_command_buffer(frame_index, 0) };
+
+      std::array const color_attachment_formats{
+         scene_format()
+      };
+
+      vk::CommandBufferInheritanceRenderingInfo const inheritance_rendering_info{
+         .colorAttachmentCount{ static_cast<std::uint32_t>(std::ranges::size(color_attachment_formats)) },
+         .pColorAttachmentFormats{ std::ranges::data(color_attachment_formats) },
+         .depthAttachmentFormat{ description_.depth_format },
+         .rasterizationSamples{ vk::SampleCountFlagBits::e1 }
+      };
+
+      vk::CommandBufferInheritanceInfo const inheritance_info{
+         .pNext{ &inheritance_rendering_info }
+      };
+
+      vk::Result result{
+         command_buffer.begin({
+            .flags{ vk::CommandBufferUsageFlagBits::eOneTimeSubmit | vk::CommandBufferUsageFlagBits::eRenderPassContinue },
+            .pInheritanceInfo{ &inheritance_info }
          })
       };
-      command_buffers->front().copyBuffer2({
-         .srcBuffer{ index_staging_buffer },
-         .dstBuffer{ index_buffer_ },
-         .regionCount{ static_cast<std::uint32_t>(std::ranges::size(index_buffer_copy_regions)) },
-         .pRegions{ std::ranges::data(index_buffer_copy_regions) }
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to begin secondary command buffer! ({})", to_string(result)));
+
+      debug_draw_.record(command_buffer, frame_index, view_projection, extent);
+
+      result = command_buffer.end();
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to end secondary command buffer! ({})", to_string(result)));
+
+      return *command_buffer;
+   }
+
+   auto Renderer::record_post_processing(vk::raii::CommandBuffer const& command_buffer, Target const& scene_target) const -> void
+   {
+      vk::ImageMemoryBarrier2 const scene_barrier{
+         .srcStageMask{ vk::PipelineStageFlagBits2::eColorAttachmentOutput },
+         .srcAccessMask{ vk::AccessFlagBits2::eColorAttachmentWrite },
+         .dstStageMask{ vk::PipelineStageFlagBits2::eComputeShader },
+         .dstAccessMask{ vk::AccessFlagBits2::eShaderSampledRead },
+         .oldLayout{ vk::ImageLayout::eColorAttachmentOptimal },
+         .newLayout{ vk::ImageLayout::eShaderReadOnlyOptimal },
+         .image{ scene_target.image },
+         .subresourceRange{
+            .aspectMask{ vk::ImageAspectFlagBits::eColor },
+            .levelCount{ 1 },
+            .layerCount{ 1 }
+         }
+      };
+
+      command_buffer.pipelineBarrier2({
+         .imageMemoryBarrierCount{ 1 },
+         .pImageMemoryBarriers{ &scene_barrier }
       });
 
-      std::array image_memory_barriers{
+      post_processor_->record(command_buffer, scene_target.image_view);
+   }
+
+   auto Renderer::record_upscaling(vk::raii::CommandBuffer const& command_buffer, Target const& source,
+      Target const& target) const -> void
+   {
+      // the post-processed image is left readable by the post processor itself, only the scene still has to be made so
+      std::array const begin_barriers{
          std::to_array<vk::ImageMemoryBarrier2>({
             {
-               .srcStageMask{ vk::PipelineStageFlagBits2::eNone },
-               .srcAccessMask{ vk::AccessFlagBits2::eNone },
-               .dstStageMask{ vk::PipelineStageFlagBits2::eTransfer },
-               .dstAccessMask{ vk::AccessFlagBits2::eTransferWrite },
-               .oldLayout{ vk::ImageLayout::eUndefined },
-               .newLayout{ vk::ImageLayout::eTransferDstOptimal },
-               .image{ image_ },
+               .srcStageMask{ vk::PipelineStageFlagBits2::eColorAttachmentOutput },
+               .srcAccessMask{ vk::AccessFlagBits2::eColorAttachmentWrite },
+               .dstStageMask{ vk::PipelineStageFlagBits2::eFragmentShader },
+               .dstAccessMask{ vk::AccessFlagBits2::eShaderSampledRead },
+               .oldLayout{ vk::ImageLayout::eColorAttachmentOptimal },
+               .newLayout{ vk::ImageLayout::eShaderReadOnlyOptimal },
+               .image{ source.image },
                .subresourceRange{
                   .aspectMask{ vk::ImageAspectFlagBits::eColor },
-                  .baseMipLevel{ 0 },
                   .levelCount{ 1 },
-                  .baseArrayLayer{ 0 },
                   .layerCount{ 1 }
-               },
-            } /*,
+               }
+            },
             {
-               .srcStageMask{ vk::PipelineStageFlagBits2::eNone },
+               .srcStageMask{ vk::PipelineStageFlagBits2::eColorAttachmentOutput },
                .srcAccessMask{ vk::AccessFlagBits2::eNone },
-               .dstStageMask{ vk::PipelineStageFlagBits2::eNone },
-               .dstAccessMask{ vk::AccessFlagBits2::eNone },
+               .dstStageMask{ vk::PipelineStageFlagBits2::eColorAttachmentOutput },
+               .dstAccessMask{ vk::AccessFlagBits2::eColorAttachmentWrite },
                .oldLayout{ vk::ImageLayout::eUndefined },
-               .newLayout{ vk::ImageLayout::eDepthAttachmentOptimal },
-               .image{ depth_image_ },
+               .newLayout{ vk::ImageLayout::eColorAttachmentOptimal },
+               .image{ target.image },
                .subresourceRange{
-                  .aspectMask{ vk::ImageAspectFlagBits::eDepth },
-                  .baseMipLevel{ 0 },
-                  .levelCount{ 1 },
-                  .baseArrayLayer{ 0 },
-                  .layerCount{ 1 }
-               },
-            }*/
-         })
-      };
-      command_buffers->front().pipelineBarrier2({
-         .imageMemoryBarrierCount{ static_cast<std::uint32_t>(std::ranges::size(image_memory_barriers)) },
-         .pImageMemoryBarriers{ std::ranges::data(image_memory_barriers) }
-      });
-
-      std::array const image_buffer_copy_regions{
-         std::to_array<vk::BufferImageCopy2>({
-            {
-               .imageSubresource{
                   .aspectMask{ vk::ImageAspectFlagBits::eColor },
-                  .mipLevel{ 0 },
-                  .baseArrayLayer{ 0 },
+                  .levelCount{ 1 },
                   .layerCount{ 1 }
-               },
-               .imageExtent{
-                  .width{ texture_->baseWidth },
-                  .height{ texture_->baseHeight },
-                  .depth{ texture_->baseDepth }
                }
             }
          })
       };
-      command_buffers->front().copyBufferToImage2({
-         .srcBuffer{ image_staging_buffer },
-         .dstImage{ image_ },
-         .dstImageLayout{ vk::ImageLayout::eTransferDstOptimal },
-         .regionCount{ static_cast<std::uint32_t>(std::ranges::size(image_buffer_copy_regions)) },
-         .pRegions{ std::ranges::data(image_buffer_copy_regions) }
-      });
 
-      std::array end_image_memory_barriers =
-         std::to_array<vk::ImageMemoryBarrier2>({
-            {
-               .srcStageMask{ vk::PipelineStageFlagBits2::eTransfer },
-               .srcAccessMask{ vk::AccessFlagBits2::eTransferWrite },
-               .dstStageMask{ vk::PipelineStageFlagBits2::eNone },
-               .dstAccessMask{ vk::AccessFlagBits2::eNone },
-               .oldLayout{ vk::ImageLayout::eTransferDstOptimal },
-               .newLayout{ vk::ImageLayout::eShaderReadOnlyOptimal },
-               .image{ image_ },
-               .subresourceRange{
-                  .aspectMask{ vk::ImageAspectFlagBits::eColor },
-                  .baseMipLevel{ 0 },
-                  .levelCount{ 1 },
-                  .baseArrayLayer{ 0 },
-                  .layerCount{ 1 }
-               }
-            }
-         });
-      command_buffers->front().pipelineBarrier2({
-         .imageMemoryBarrierCount{ static_cast<std::uint32_t>(std::ranges::size(end_image_memory_barriers)) },
-         .pImageMemoryBarriers{ std::ranges::data(end_image_memory_barriers) }
+      std::span const barriers{ std::span{ begin_barriers }.subspan(post_processor_ ? 1 : 0) };
+      command_buffer.pipelineBarrier2({
+         .imageMemoryBarrierCount{ static_cast<std::uint32_t>(std::ranges::size(barriers)) },
+         .pImageMemoryBarriers{ std::ranges::data(barriers) }
       });
 
-      result = command_buffers->front().end();
-      RUNTIME_ASSERT(result == vk::Result::eSuccess,
-         std::format("failed to end command buffer! ({})", to_string(result)));
+      upscaler_.record(command_buffer, source.image_view, source.extent, target.image_view, target.extent);
+   }
 
-      context_.queue.submit({
-         {
-            {
-               .commandBufferCount{ 1 },
-               .pCommandBuffers{ &*command_buffers->front() },
-            }
-         }
+   auto Renderer::record_rendering(vk::raii::CommandBuffer const& command_buffer, Pass const pass, Target const& target,
+      vk::AttachmentLoadOp const color_load_op, vk::AttachmentLoadOp const depth_load_op,
+      vk::AttachmentStoreOp const depth_store_op, std::span<vk::CommandBuffer const> const command_buffers) const -> void
+   {
+      vk::RenderingAttachmentInfo const attachment_info{
+         .imageView{ target.image_view },
+         .imageLayout{ vk::ImageLayout::eColorAttachmentOptimal },
+         .loadOp{ color_load_op },
+         .storeOp{ vk::AttachmentStoreOp::eStore },
+         .clearValue{ vk::ClearColorValue{ 0.0f, 0.0f, 0.0f, 0.0f } }
+      };
+
+      vk::RenderingAttachmentInfo const depth_attachment_info{
+         .imageView{ depth_image_view_ },
+         .imageLayout{ vk::ImageLayout::eDepthAttachmentOptimal },
+         .loadOp{ depth_load_op },
+         .storeOp{ depth_store_op },
+         .clearValue{ vk::ClearDepthStencilValue{ .depth{ 1.0f } } }
+      };
+
+      // the depth pre-pass has no color attachment
+      command_buffer.beginRendering({
+         .flags{ vk::RenderingFlagBits::eContentsSecondaryCommandBuffers },
+         .renderArea{
+            .extent{ target.extent }
+         },
+         .layerCount{ 1 },
+         .colorAttachmentCount{ pass == Pass::MAIN ? 1u : 0u },
+         .pColorAttachments{ &attachment_info },
+         .pDepthAttachment{ &depth_attachment_info }
       });
-      result = context_.queue.waitIdle();
-      RUNTIME_ASSERT(result == vk::Result::eSuccess,
-         std::format("failed to wait for queue! ({})", to_string(result)));
 
-      //
+      if (not command_buffers.empty())
+         command_buffer.executeCommands(command_buffers);
 
-      uniform_buffer_mapped_.reserve(MAX_FRAMES_IN_FLIGHT);
-      std::vector<vk::DescriptorBufferInfo> buffer_infos{};
-      buffer_infos.reserve(MAX_FRAMES_IN_FLIGHT);
-      std::vector<vk::WriteDescriptorSet> writes{};
-      writes.reserve(MAX_FRAMES_IN_FLIGHT + 2);
-      for (std::size_t index{}; index < MAX_FRAMES_IN_FLIGHT; ++index)
-      {
-         uniform_buffers_[index].bindMemory(uniform_buffer_memories_[index], 0);
+      command_buffer.endRendering();
+   }
 
-         mapped_memory = uniform_buffer_memories_[index].mapMemory(0, sizeof(UniformBufferObject));
-         RUNTIME_ASSERT(mapped_memory.has_value(),
-            std::format("failed to map a uniform buffer's memory! ({})", to_string(mapped_memory.result)));
+   auto Renderer::record_chunk(vk::raii::CommandBuffer const& command_buffer, vk::CommandBufferUsageFlags const usage,
+      Pass const pass, Phase const phase, std::uint8_t const frame_index, std::span<Batch const> const batches,
+      std::size_t const first_batch, DrawListBuffers const& buffers, vk::Extent2D const extent) const -> void
+   {
+      std::array const color_attachment_formats{
+         scene_format()
+      };
 
-         uniform_buffer_mapped_.push_back(static_cast<UniformBufferObject*>(*mapped_memory));
+      vk::CommandBufferInheritanceRenderingInfo const inheritance_rendering_info{
+         .colorAttachmentCount{
+            pass == Pass::MAIN ? static_cast<std::uint32_t>(std::ranges::size(color_attachment_formats)) : 0
+         },
+         .pColorAttachmentFormats{ std::ranges::data(color_attachment_formats) },
+         .depthAttachmentFormat{ description_.depth_format },
+         .rasterizationSamples{ vk::SampleCountFlagBits::e1 }
+      };
 
-         buffer_infos.push_back({
-            .buffer{ uniform_buffers_[index] },
-            .offset{},
-            .range{ vk::WholeSize }
-         });
+      vk::CommandBufferInheritanceInfo const inheritance_info{
+         .pNext{ &inheritance_rendering_info }
+      };
 
-         writes.push_back({
-            .dstSet{ uniform_buffer_descriptor_sets_[index] },
-            .dstBinding{ 0 },
-            .dstArrayElement{ 0 },
-            .descriptorCount{ 1 },
-            .descriptorType{ vk::DescriptorType::eUniformBuffer },
-            .pImageInfo{ nullptr },
-            .pBufferInfo{ &buffer_infos[index] },
-            .pTexelBufferView{ nullptr }
-         });
+      vk::Result result{
+         command_buffer.begin({
+            .flags{ usage | vk::CommandBufferUsageFlagBits::eRenderPassContinue },
+            .pInheritanceInfo{ &inheritance_info }
+         })
+      };
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to begin secondary command buffer! ({})", to_string(result)));
+
+      if (pass == Pass::DEPTH_PRE_PASS)
+      {
+         command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline_layout_,
+            0, { *uniform_buffer_descriptor_sets_[frame_index] }, nullptr);
+
+         command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, depth_pre_pass_pipeline_);
       }
+      else
+      {
+         command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline_layout_,
+            0, { *uniform_buffer_descriptor_sets_[frame_index] }, nullptr);
 
-      vk::DescriptorImageInfo const sampler_info{
-         .sampler{ sampler_ }
-      };
+         command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline_);
 
-      writes.push_back({
-         .dstSet{ sampler_descriptor_set_ },
-         .dstBinding{ 0 },
-         .dstArrayElement{ 0 },
-         .descriptorCount{ 1 },
-         .descriptorType{ vk::DescriptorType::eSampler },
-         .pImageInfo{ &sampler_info },
-         .pBufferInfo{ nullptr },
-         .pTexelBufferView{ nullptr }
-      });
+         // with a pre-pass, depth is already final; only fragments that survived it get shaded
+         command_buffer.setDepthWriteEnable(depth_mode_ == DepthMode::PRE_PASS ? vk::False : vk::True);
+         command_buffer.setDepthCompareOp(depth_mode_ == DepthMode::PRE_PASS ? vk::CompareOp::eEqual : vk::CompareOp::eLess);
+      }
 
-      vk::DescriptorImageInfo const image_info{
-         .imageView{ image_view_ },
-         .imageLayout{ vk::ImageLayout::eShaderReadOnlyOptimal },
-      };
+      // mesh shaders read instances, like everything else, from storage buffers; strides are dynamic, so they are given
+      // for every binding
+      if (not context_.mesh_shader_support)
+         command_buffer.bindVertexBuffers2(Instance::INPUT_BINDING_DESCRIPTIONS[0].binding, { *buffers.instances.buffer },
+            { 0 }, nullptr, { Instance::INPUT_BINDING_DESCRIPTIONS[0].stride });
+
+      command_buffer.setViewport(0, {
+         {
+            .width{ static_cast<float>(extent.width) },
+            .height{ static_cast<float>(extent.height) },
+            .maxDepth{ 1.0f },
+         }
+      });
 
-      writes.push_back({
-         .dstSet{ sampler_descriptor_set_ },
-         .dstBinding{ 1 },
-         .dstArrayElement{ 0 },
-         .descriptorCount{ 1 },
-         .descriptorType{ vk::DescriptorType::eSampledImage },
-         .pImageInfo{ &image_info },
-         .pBufferInfo{ nullptr },
-         .pTexelBufferView{ nullptr }
+      command_buffer.setScissor(0, {
+         {
+            .extent{ extent }
+         }
       });
 
-      context_.device.updateDescriptorSets(writes, {});
-   }
+      std::size_t const first_command{ phase == Phase::LATE ? buffers.command_count : 0uz };
+      std::size_t const first_draw_count{ (phase == Phase::LATE ? buffers.batch_count : 0uz) + first_batch };
+
+      // every mesh's indices, and every interleaved mesh's vertices, are in the geometry pool's buffers, which are bound
+      // once, before the first batch, as there is nothing to bind without any; only split meshes, skinned ones included,
+      // bind or pull streams of their own, after which the pool's vertex buffer has to be bound again
+      std::optional<std::uint32_t> bound_mesh{};
+      std::optional<std::uint32_t> bound_material{};
+      bool pool_streams_bound{};
+      for (std::size_t index{}; index < batches.size(); ++index)
+      {
+         Batch const& batch{ batches[index] };
+         Mesh const& mesh{ meshes_[batch.mesh] };
+         if (not bound_mesh and not context_.mesh_shader_support)
+            command_buffer.bindIndexBuffer(geometry_pool_.index_buffer(), 0, vk::IndexType::eUint16);
+
+         if (batch.mesh not_eq bound_mesh)
+         {
+            if (context_.mesh_shader_support)
+               push_meshlet_descriptors(command_buffer, buffers, mesh);
+            else if (mesh.stream_layout == Vertex::StreamLayout::SPLIT or not pool_streams_bound)
+            {
+               if (vertex_pulling())
+                  push_vertex_descriptors(command_buffer, mesh);
+               else
+                  bind_vertex_streams(command_buffer, pass, mesh);
+
+               pool_streams_bound = mesh.stream_layout == Vertex::StreamLayout::INTERLEAVED;
+            }
+
+            bound_mesh = batch.mesh;
+         }
+
+         // the depth pre-pass samples nothing, so materials only matter to the main pass
+         if (pass == Pass::MAIN and batch.material not_eq bound_material)
+         {
+            command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline_layout_,
+               1, { *materials_[batch.material].descriptor_set }, nullptr);
+            bound_material = batch.material;
+         }
+
+         // the phase's culling pass decides how many of the batch's commands survive
+         vk::DeviceSize const draw_count_offset{ (first_draw_count + index) * sizeof(DrawCount) };
+         if (context_.mesh_shader_support)
+         {
+            VertexStreams const streams{ vertex_streams(mesh) };
+            MeshletDraw const meshlet_draw{
+               .first_command{ static_cast<std::uint32_t>(first_command + batch.first_command) },
+               .first_meshlet{ mesh.first_meshlet },
+               .meshlet_count{ mesh.meshlet_count },
+               .instance_stride{ sizeof(Instance) },
+               .position_offset{ static_cast<std::uint32_t>(streams.position_offset) },
+               .position_stride{ static_cast<std::uint32_t>(streams.position_stride) },
+               .attribute_offset{ static_cast<std::uint32_t>(streams.attribute_offset) },
+               .attribute_stride{ static_cast<std::uint32_t>(streams.attribute_stride) }
+            };
+            command_buffer.pushConstants<MeshletDraw>(pipeline_layout_,
+               vk::ShaderStageFlagBits::eTaskEXT | vk::ShaderStageFlagBits::eMeshEXT, 0, meshlet_draw);
+
+            command_buffer.drawMeshTasksIndirectEXT(buffers.draw_counts.buffer, draw_count_offset, 1, sizeof(DrawCount));
+         }
+         else
+            command_buffer.drawIndexedIndirectCount(
+               buffers.commands.buffer, (first_command + batch.first_command) * sizeof(vk::DrawIndexedIndirectCommand),
+               buffers.draw_counts.buffer, draw_count_offset + offsetof(DrawCount, count),
+               batch.command_count, sizeof(vk::DrawIndexedIndirectCommand));
+      }
 
-   Renderer::~Renderer()
-   {
-      vk::Result const result{ context_.device.waitIdle() };
+      result = command_buffer.end();
       RUNTIME_ASSERT(result == vk::Result::eSuccess,
-         std::format("failed to wait idle on the device! ({})", to_string(result)));
+         std::format("failed to end secondary command buffer! ({})", to_string(result)));
    }
 
-   auto Renderer::record(FrameData const frame_data, Target const& target) -> void
+   auto Renderer::push_meshlet_descriptors(vk::raii::CommandBuffer const& command_buffer, DrawListBuffers const& buffers,
+      Mesh const& mesh) const -> void
    {
-      auto& [model, view, projection]{ *uniform_buffer_mapped_[frame_data.frame_index] };
-
-      static auto start_time{ std::chrono::high_resolution_clock::now() };
-
-      auto const current_time{ std::chrono::high_resolution_clock::now() };
-      float const time{ std::chrono::duration<float>(current_time - start_time).count() };
+      vk::DescriptorBufferInfo const instances_info{ .buffer{ buffers.instances.buffer }, .range{ vk::WholeSize } };
+      vk::DescriptorBufferInfo const commands_info{ .buffer{ buffers.commands.buffer }, .range{ vk::WholeSize } };
+      vk::DescriptorBufferInfo const meshlets_info{ .buffer{ meshlet_buffer_.buffer }, .range{ vk::WholeSize } };
+      vk::DescriptorBufferInfo const meshlet_vertices_info{ .buffer{ mesh.meshlet_vertices.buffer }, .range{ vk::WholeSize } };
+      vk::DescriptorBufferInfo const meshlet_triangles_info{ .buffer{ mesh.meshlet_triangles.buffer }, .range{ vk::WholeSize } };
+
+      VertexStreams const streams{ vertex_streams(mesh) };
+      vk::DescriptorBufferInfo const positions_info{ .buffer{ streams.position_buffer }, .range{ vk::WholeSize } };
+      vk::DescriptorBufferInfo const attributes_info{ .buffer{ streams.attribute_buffer }, .range{ vk::WholeSize } };
+
+      std::array const buffer_infos{
+         std::to_array({
+            &instances_info,
+            &commands_info,
+            &meshlets_info,
+            &meshlet_vertices_info,
+            &meshlet_triangles_info,
+            &positions_info,
+            &attributes_info
+         })
+      };
 
-      model = rotate(glm::mat4(1.0f), time * glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f));
-      view = lookAt(glm::vec3(2.0f, 2.0f, 2.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
-      projection = glm::perspective(glm::radians(45.0f), static_cast<float>(target.extent.width) / target.extent.height, 0.1f, 10.0f);
-      projection[1][1] *= -1;
+      std::array<vk::WriteDescriptorSet, buffer_infos.size()> writes{};
+      for (std::uint32_t binding{}; binding < writes.size(); ++binding)
+         writes[binding] = {
+            .dstBinding{ binding },
+            .descriptorCount{ 1 },
+            .descriptorType{ vk::DescriptorType::eStorageBuffer },
+            .pBufferInfo{ buffer_infos[binding] }
+         };
 
-      //======================================//
+      command_buffer.pushDescriptorSet(vk::PipelineBindPoint::eGraphics, pipeline_layout_, 2, writes);
+   }
 
-      vk::Result result = frame_data.command_buffer.begin({
-         .flags{ vk::CommandBufferUsageFlagBits::eOneTimeSubmit }
-      });
-      RUNTIME_ASSERT(result == vk::Result::eSuccess,
-         std::format("failed to begin command buffer! ({})", to_string(result)));
+   auto Renderer::push_vertex_descriptors(vk::raii::CommandBuffer const& command_buffer, Mesh const& mesh) const -> void
+   {
+      VertexStreams const streams{ vertex_streams(mesh) };
+      vk::DescriptorBufferInfo const positions_info{ .buffer{ streams.position_buffer }, .range{ vk::WholeSize } };
+      vk::DescriptorBufferInfo const attributes_info{ .buffer{ streams.attribute_buffer }, .range{ vk::WholeSize } };
 
-      vk::ImageMemoryBarrier2 const begin_barrier{
-         .srcStageMask{ vk::PipelineStageFlagBits2::eColorAttachmentOutput },
-         .srcAccessMask{ vk::AccessFlagBits2::eNone },
-         .dstStageMask{ vk::PipelineStageFlagBits2::eColorAttachmentOutput },
-         .dstAccessMask{ vk::AccessFlagBits2::eColorAttachmentWrite },
-         .oldLayout{ vk::ImageLayout::eUndefined },
-         .newLayout{ vk::ImageLayout::eColorAttachmentOptimal },
-         .image{ target.image },
-         .subresourceRange{
-            .aspectMask{ vk::ImageAspectFlagBits::eColor },
-            .levelCount{ 1 },
-            .layerCount{ 1 }
+      command_buffer.pushDescriptorSet(vk::PipelineBindPoint::eGraphics, pipeline_layout_, 2, {
+         {
+            .dstBinding{ 0 },
+            .descriptorCount{ 1 },
+            .descriptorType{ vk::DescriptorType::eStorageBuffer },
+            .pBufferInfo{ &positions_info }
+         },
+         {
+            .dstBinding{ 1 },
+            .descriptorCount{ 1 },
+            .descriptorType{ vk::DescriptorType::eStorageBuffer },
+            .pBufferInfo{ &attributes_info }
          }
-      };
-
-      frame_data.command_buffer.pipelineBarrier2({
-         .imageMemoryBarrierCount{ 1 },
-         .pImageMemoryBarriers{ &begin_barrier }
       });
 
-      vk::RenderingAttachmentInfo const attachment_info{
-         .imageView{ target.image_view },
-         .imageLayout{ vk::ImageLayout::eColorAttachmentOptimal },
-         .loadOp{ vk::AttachmentLoadOp::eClear },
-         .storeOp{ vk::AttachmentStoreOp::eStore },
-         .clearValue{ vk::ClearColorValue{ 0.0f, 0.0f, 0.0f, 0.0f } }
+      VertexPulling const vertex_pulling{
+         .position_offset{ static_cast<std::uint32_t>(streams.position_offset) },
+         .position_stride{ static_cast<std::uint32_t>(streams.position_stride) },
+         .attribute_offset{ static_cast<std::uint32_t>(streams.attribute_offset) },
+         .attribute_stride{ static_cast<std::uint32_t>(streams.attribute_stride) }
       };
+      command_buffer.pushConstants<VertexPulling>(pipeline_layout_, vk::ShaderStageFlagBits::eVertex, 0, vertex_pulling);
+   }
 
-      vk::RenderingAttachmentInfo const depth_attachment_info{
-         .imageView{ depth_image_view_ },
-         .imageLayout{ vk::ImageLayout::eDepthAttachmentOptimal },
-         .loadOp{ vk::AttachmentLoadOp::eClear },
-         .storeOp{ vk::AttachmentStoreOp::eStore },
-         .clearValue{ vk::ClearColorValue{ 1.0f, 1.0f, 1.0f, 1.0f } }
-      };
+   auto Renderer::bind_vertex_streams(vk::raii::CommandBuffer const& command_buffer, Pass const pass, Mesh const& mesh) const -> void
+   {
+      VertexStreams const streams{ vertex_streams(mesh) };
 
-      frame_data.command_buffer.beginRendering({
-         .renderArea{
-            .extent{ target.extent }
-         },
-         .layerCount{ 1 },
-         .colorAttachmentCount{ 1 },
-         .pColorAttachments{ &attachment_info },
-         .pDepthAttachment{ &depth_attachment_info }
-      });
+      command_buffer.bindVertexBuffers2(Vertex::INPUT_BINDING_DESCRIPTIONS[0].binding, { streams.position_buffer },
+         { streams.position_offset }, nullptr, { streams.position_stride });
 
-      frame_data.command_buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline_layout_,
-         0, {
-            uniform_buffer_descriptor_sets_[frame_data.frame_index],
-            *sampler_descriptor_set_
-         },
-         nullptr);
+      // the depth pre-pass reads nothing but positions
+      if (pass == Pass::DEPTH_PRE_PASS)
+         return;
 
-      frame_data.command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline_);
+      command_buffer.bindVertexBuffers2(Vertex::INPUT_BINDING_DESCRIPTIONS[1].binding, { streams.attribute_buffer },
+         { streams.attribute_offset }, nullptr, { streams.attribute_stride });
+   }
 
-      frame_data.command_buffer.bindVertexBuffers(0, { vertex_buffer_ }, { 0 });
-      frame_data.command_buffer.bindIndexBuffer(*index_buffer_, 0, vk::IndexType::eUint16);
-      frame_data.command_buffer.setViewport(0, {
-         {
-            .width{ static_cast<float>(target.extent.width) },
-            .height{ static_cast<float>(target.extent.height) },
-            .maxDepth{ 1.0f },
-         }
-      });
+   auto Renderer::vertex_streams(Mesh const& mesh) const -> VertexStreams
+   {
+      // interleaved meshes are read from the pool's buffer as a whole, which covers all of them, their first vertex being
+      // the base vertex, which every command adds onto the vertex index
+      vk::Buffer const vertex_buffer{ geometry_pool_.vertex_buffer() };
+      if (mesh.stream_layout == Vertex::StreamLayout::INTERLEAVED)
+         return {
+            .position_buffer{ vertex_buffer },
+            .position_offset{ 0 },
+            .position_stride{ sizeof(Vertex::Packed) },
+            .attribute_buffer{ vertex_buffer },
+            .attribute_offset{ offsetof(Vertex::Packed, attributes) },
+            .attribute_stride{ sizeof(Vertex::Packed) }
+         };
+
+      // skinned positions start out like those of the pool, so that either is read the same way
+      static_assert(offsetof(Skinner::SkinnedVertex, position) == 0 and
+         std::same_as<decltype(Skinner::SkinnedVertex::position), Half4>,
+         "skinned vertices have to start with a position as the pool stores it!");
+
+      return {
+         .position_buffer{ mesh.skinned_instance ? skinner_.vertex_buffer(*mesh.skinned_instance) : vertex_buffer },
+         .position_offset{ mesh.skinned_instance ? 0 : mesh.vertices.offset },
+         .position_stride{ mesh.skinned_instance ? sizeof(Skinner::SkinnedVertex) : sizeof(Half4) },
+         .attribute_buffer{ vertex_buffer },
+         .attribute_offset{ mesh.attributes.offset },
+         .attribute_stride{ sizeof(Vertex::Attributes) }
+      };
+   }
+
+   auto Renderer::vertex_pulling() const -> bool
+   {
+      return description_.vertex_pulling and not context_.mesh_shader_support;
+   }
 
-      frame_data.command_buffer.setScissor(0, {
+   auto Renderer::update_static_segments(std::uint8_t const frame_index, RecordingInputs const& inputs, glm::mat4 const& view) -> void
+   {
+      std::vector<StaticSegment*> outdated_static_segments{};
+      for (StaticSegment& static_segment : static_segments_ | std::views::values)
+         if (static_segment.recorded_inputs[frame_index] not_eq inputs)
+            outdated_static_segments.push_back(&static_segment);
+
+      // every segment has its own command pool, so they can be re-recorded side by side
+      thread_pool_.execute(outdated_static_segments.size(),
+         [this, frame_index, &inputs, &view, &outdated_static_segments](std::size_t const index, std::size_t) -> void
          {
-            .extent{ target.extent }
-         }
-      });
+            StaticSegment& static_segment{ *outdated_static_segments[index] };
+            DrawListBuffers& buffers{ static_segment.buffers[frame_index] };
+            std::vector<Batch> const batches{ batch(static_segment.draws, view, buffers, static_segment.statistics) };
 
-      frame_data.command_buffer.drawIndexed(static_cast<std::uint32_t>(indices_.size()), 1, 0, 0, 0);
-      frame_data.command_buffer.endRendering();
+            for (Phase const phase : { Phase::EARLY, Phase::LATE })
+            {
+               std::size_t const command_buffer_index{ frame_index * PHASE_COUNT + std::to_underlying(phase) };
+               if (inputs.depth_mode == DepthMode::PRE_PASS)
+                  record_chunk(static_segment.depth_pre_pass_command_buffers[command_buffer_index], {}, Pass::DEPTH_PRE_PASS,
+                     phase, frame_index, batches, 0, buffers, inputs.extent);
 
-      vk::ImageMemoryBarrier2 const end_barrier{
-         .srcStageMask{ vk::PipelineStageFlagBits2::eColorAttachmentOutput },
-         .srcAccessMask{ vk::AccessFlagBits2::eColorAttachmentWrite },
-         .dstStageMask{ vk::PipelineStageFlagBits2::eColorAttachmentOutput },
-         .dstAccessMask{ vk::AccessFlagBits2::eNone },
-         .oldLayout{ vk::ImageLayout::eColorAttachmentOptimal },
-         .newLayout{ vk::ImageLayout::ePresentSrcKHR },
-         .image{ target.image },
-         .subresourceRange{
-            .aspectMask{ vk::ImageAspectFlagBits::eColor },
-            .levelCount{ 1 },
-            .layerCount{ 1 }
-         }
-      };
+               record_chunk(static_segment.main_command_buffers[command_buffer_index], {}, Pass::MAIN,
+                  phase, frame_index, batches, 0, buffers, inputs.extent);
+            }
 
-      frame_data.command_buffer.pipelineBarrier2(
-         {
-            .imageMemoryBarrierCount{ 1 },
-            .pImageMemoryBarriers{ &end_barrier }
+            static_segment.recorded_inputs[frame_index] = inputs;
          });
+   }
 
-      result = frame_data.command_buffer.end();
-      RUNTIME_ASSERT(result == vk::Result::eSuccess,
-         std::format("failed to end command buffer! ({})", to_string(result)));
+   auto Renderer::recording_inputs(Target const& target) const -> RecordingInputs
+   {
+      return {
+         .depth_pre_pass_pipeline{ depth_pre_pass_pipeline_ },
+         .pipeline{ pipeline_ },
+         .meshlet_buffer{ meshlet_buffer_.buffer },
+         .vertex_buffer{ geometry_pool_.vertex_buffer() },
+         .index_buffer{ geometry_pool_.index_buffer() },
+         .color_format{ target.format },
+         .extent{ target.extent },
+         .depth_mode{ depth_mode_ }
+      };
    }
 
    auto Renderer::uniform_buffer_descriptor_set_layout() const -> vk::raii::DescriptorSetLayout
@@ -471,6 +1865,30 @@ namespace eru
                .descriptorType{ vk::DescriptorType::eUniformBuffer },
                .descriptorCount{ 1 },
                .stageFlags{ vk::ShaderStageFlagBits::eAll }
+            },
+            {
+               .binding{ 1 },
+               .descriptorType{ vk::DescriptorType::eUniformBuffer },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eFragment }
+            },
+            {
+               .binding{ 2 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eFragment }
+            },
+            {
+               .binding{ 3 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eFragment }
+            },
+            {
+               .binding{ 4 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eFragment }
             }
          })
       };
@@ -487,7 +1905,7 @@ namespace eru
       return std::move(*descriptor_set_layout);
    }
 
-   auto Renderer::sampler_descriptor_set_layout() const -> vk::raii::DescriptorSetLayout
+   auto Renderer::material_descriptor_set_layout() const -> vk::raii::DescriptorSetLayout
    {
       std::array constexpr bindings{
          std::to_array<vk::DescriptorSetLayoutBinding>({
@@ -513,7 +1931,73 @@ namespace eru
          })
       };
       RUNTIME_ASSERT(descriptor_set_layout.has_value(),
-         std::format("failed to create sampler descriptor set layout! ({})", to_string(descriptor_set_layout.result)));
+         std::format("failed to create material descriptor set layout! ({})", to_string(descriptor_set_layout.result)));
+
+      return std::move(*descriptor_set_layout);
+   }
+
+   auto Renderer::meshlet_descriptor_set_layout() const -> vk::raii::DescriptorSetLayout
+   {
+      // only there with mesh shader support; pushed per mesh, as the cull pass's is per draw list
+      if (not context_.mesh_shader_support)
+         return nullptr;
+
+      // instances, commands, meshlets, meshlet vertices, meshlet triangles, positions and attributes, in that order
+      std::array<vk::DescriptorSetLayoutBinding, 7> bindings{};
+      for (std::uint32_t binding{}; binding < bindings.size(); ++binding)
+         bindings[binding] = {
+            .binding{ binding },
+            .descriptorType{ vk::DescriptorType::eStorageBuffer },
+            .descriptorCount{ 1 },
+            .stageFlags{ vk::ShaderStageFlagBits::eTaskEXT | vk::ShaderStageFlagBits::eMeshEXT }
+         };
+
+      vk::ResultValue descriptor_set_layout{
+         context_.device.createDescriptorSetLayout({
+            .flags{ vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptor },
+            .bindingCount{ static_cast<std::uint32_t>(std::ranges::size(bindings)) },
+            .pBindings{ std::ranges::data(bindings) }
+         })
+      };
+      RUNTIME_ASSERT(descriptor_set_layout.has_value(),
+         std::format("failed to create meshlet descriptor set layout! ({})", to_string(descriptor_set_layout.result)));
+
+      return std::move(*descriptor_set_layout);
+   }
+
+   auto Renderer::vertex_descriptor_set_layout() const -> vk::raii::DescriptorSetLayout
+   {
+      // only there when pulling vertices; pushed per mesh, like the meshlet set it stands in for
+      if (not vertex_pulling())
+         return nullptr;
+
+      // positions and attributes, in that order
+      std::array constexpr bindings{
+         std::to_array<vk::DescriptorSetLayoutBinding>({
+            {
+               .binding{ 0 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eVertex }
+            },
+            {
+               .binding{ 1 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eVertex }
+            }
+         })
+      };
+
+      vk::ResultValue descriptor_set_layout{
+         context_.device.createDescriptorSetLayout({
+            .flags{ vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptor },
+            .bindingCount{ static_cast<std::uint32_t>(std::ranges::size(bindings)) },
+            .pBindings{ std::ranges::data(bindings) }
+         })
+      };
+      RUNTIME_ASSERT(descriptor_set_layout.has_value(),
+         std::format("failed to create vertex descriptor set layout! ({})", to_string(descriptor_set_layout.result)));
 
       return std::move(*descriptor_set_layout);
    }
@@ -524,15 +2008,19 @@ namespace eru
          std::to_array<vk::DescriptorPoolSize>({
             {
                .type{ vk::DescriptorType::eUniformBuffer },
-               .descriptorCount{ MAX_FRAMES_IN_FLIGHT }
+               .descriptorCount{ 2 * MAX_FRAMES_IN_FLIGHT }
+            },
+            {
+               .type{ vk::DescriptorType::eStorageBuffer },
+               .descriptorCount{ 3 * MAX_FRAMES_IN_FLIGHT }
             },
             {
                .type{ vk::DescriptorType::eSampler },
-               .descriptorCount{ 1 }
+               .descriptorCount{ MAX_MATERIALS }
             },
             {
                .type{ vk::DescriptorType::eSampledImage },
-               .descriptorCount{ 1 }
+               .descriptorCount{ MAX_MATERIALS }
             }
          })
       };
@@ -540,7 +2028,7 @@ namespace eru
       vk::ResultValue descriptor_pool{
          context_.device.createDescriptorPool({
             .flags{ vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet },
-            .maxSets{ MAX_FRAMES_IN_FLIGHT + 1 },
+            .maxSets{ MAX_FRAMES_IN_FLIGHT + MAX_MATERIALS },
             .poolSizeCount{ static_cast<std::uint32_t>(std::ranges::size(desciptor_pool_sizes)) },
             .pPoolSizes{ std::ranges::data(desciptor_pool_sizes) }
          })
@@ -569,13 +2057,13 @@ namespace eru
       return std::move(*descriptor_sets);
    }
 
-   auto Renderer::sampler_descriptor_set() const -> vk::raii::DescriptorSet
+   auto Renderer::material_descriptor_set() const -> vk::raii::DescriptorSet
    {
       vk::ResultValue descriptor_sets{
          context_.device.allocateDescriptorSets({
             .descriptorPool{ descriptor_pool_ },
             .descriptorSetCount{ 1 },
-            .pSetLayouts{ &*sampler_descriptor_set_layout_ }
+            .pSetLayouts{ &*material_descriptor_set_layout_ }
          })
       };
       RUNTIME_ASSERT(descriptor_sets.has_value(),
@@ -586,17 +2074,37 @@ namespace eru
 
    auto Renderer::pipeline_layout() const -> vk::raii::PipelineLayout
    {
-      std::array const layouts{
-         std::to_array<vk::DescriptorSetLayout>({
-            *uniform_buffer_descriptor_set_layout_,
-            *sampler_descriptor_set_layout_
-         })
+      std::vector<vk::DescriptorSetLayout> layouts{
+         *uniform_buffer_descriptor_set_layout_,
+         *material_descriptor_set_layout_
       };
 
+      std::vector<vk::PushConstantRange> push_constant_ranges{};
+      if (context_.mesh_shader_support)
+      {
+         layouts.push_back(*meshlet_descriptor_set_layout_);
+         push_constant_ranges.push_back({
+            .stageFlags{ vk::ShaderStageFlagBits::eTaskEXT | vk::ShaderStageFlagBits::eMeshEXT },
+            .offset{ 0 },
+            .size{ sizeof(MeshletDraw) }
+         });
+      }
+      else if (vertex_pulling())
+      {
+         layouts.push_back(*vertex_descriptor_set_layout_);
+         push_constant_ranges.push_back({
+            .stageFlags{ vk::ShaderStageFlagBits::eVertex },
+            .offset{ 0 },
+            .size{ sizeof(VertexPulling) }
+         });
+      }
+
       vk::ResultValue pipeline_layout{
          context_.device.createPipelineLayout({
             .setLayoutCount{ static_cast<std::uint32_t>(std::ranges::size(layouts)) },
-            .pSetLayouts{ std::ranges::data(layouts) }
+            .pSetLayouts{ std::ranges::data(layouts) },
+            .pushConstantRangeCount{ static_cast<std::uint32_t>(std::ranges::size(push_constant_ranges)) },
+            .pPushConstantRanges{ std::ranges::data(push_constant_ranges) }
          })
       };
       RUNTIME_ASSERT(pipeline_layout.has_value(),
@@ -605,82 +2113,244 @@ namespace eru
       return std::move(pipeline_layout.value);
    }
 
+   auto Renderer::shader_code() const -> std::vector<std::uint32_t>
+   {
+      return compile_framework_shader("renderer.slang");
+   }
+
+   auto Renderer::meshlet_shader_code() const -> std::vector<std::uint32_t>
+   {
+      // kept apart from the other shaders, as a module declaring mesh shading capabilities cannot be used without them
+      if (not context_.mesh_shader_support)
+         return {};
+
+      return compile_framework_shader("meshlets.slang");
+   }
+
    auto Renderer::pipeline() const -> vk::raii::Pipeline
    {
-      Slang::ComPtr<slang::IGlobalSession> global_session;
-      createGlobalSession(global_session.writeRef());
-      RUNTIME_ASSERT(global_session,
-         std::format("failed to create a global session! ({})", slang::getLastInternalErrorMessage()));
+      vk::ShaderModuleCreateInfo const shader_module_create_info{
+         .codeSize{ shader_code_.size() * sizeof(decltype(shader_code_)::value_type) },
+         .pCode{ shader_code_.data() }
+      };
+
+      vk::ShaderModuleCreateInfo const meshlet_shader_module_create_info{
+         .codeSize{ meshlet_shader_code_.size() * sizeof(decltype(meshlet_shader_code_)::value_type) },
+         .pCode{ meshlet_shader_code_.data() }
+      };
+
+      std::vector<vk::PipelineShaderStageCreateInfo> shader_stage_create_infos{};
+      if (context_.mesh_shader_support)
+      {
+         shader_stage_create_infos.push_back({
+            .pNext{ &meshlet_shader_module_create_info },
+            .stage{ vk::ShaderStageFlagBits::eTaskEXT },
+            .pName{ "taskMain" }
+         });
+         shader_stage_create_infos.push_back({
+            .pNext{ &meshlet_shader_module_create_info },
+            .stage{ vk::ShaderStageFlagBits::eMeshEXT },
+            .pName{ "meshMain" }
+         });
+      }
+      else
+         shader_stage_create_infos.push_back({
+            .pNext{ &shader_module_create_info },
+            .stage{ vk::ShaderStageFlagBits::eVertex },
+            .pName{ vertex_pulling() ? "pullVertMain" : "vertMain" }
+         });
+
+      shader_stage_create_infos.push_back({
+         .pNext{ &shader_module_create_info },
+         .stage{ vk::ShaderStageFlagBits::eFragment },
+         .pName{ "fragMain" }
+      });
+
+      // vertex strides differ between stream layouts, so that one pipeline draws meshes of either
+      std::vector dynamic_states{
+         vk::DynamicState::eViewport,
+         vk::DynamicState::eScissor,
+         vk::DynamicState::eDepthWriteEnable,
+         vk::DynamicState::eDepthCompareOp
+      };
+      if (not context_.mesh_shader_support)
+         dynamic_states.push_back(vk::DynamicState::eVertexInputBindingStride);
+
+      vk::PipelineDynamicStateCreateInfo const dynamic_state_create_info{
+         .dynamicStateCount{ static_cast<uint32_t>(std::ranges::size(dynamic_states)) },
+         .pDynamicStates{ std::ranges::data(dynamic_states) }
+      };
 
-      std::array slang_targets{
-         std::to_array<slang::TargetDesc>({
+      // pulled vertices leave only the instances to the input assembler
+      std::vector<vk::VertexInputBindingDescription> binding_descriptions{};
+      std::vector<vk::VertexInputAttributeDescription> attribute_descriptions{};
+      if (not vertex_pulling())
+      {
+         binding_descriptions.append_range(Vertex::INPUT_BINDING_DESCRIPTIONS);
+         attribute_descriptions.append_range(Vertex::INPUT_ATTRIBUTE_DESCRIPTIONS);
+      }
+      binding_descriptions.append_range(Instance::INPUT_BINDING_DESCRIPTIONS);
+      attribute_descriptions.append_range(Instance::INPUT_ATTRIBUTE_DESCRIPTIONS);
+
+      vk::PipelineVertexInputStateCreateInfo const vertex_input_state_create_info{
+         .vertexBindingDescriptionCount{ static_cast<std::uint32_t>(std::ranges::size(binding_descriptions)) },
+         .pVertexBindingDescriptions{ std::ranges::data(binding_descriptions) },
+         .vertexAttributeDescriptionCount{ static_cast<std::uint32_t>(std::ranges::size(attribute_descriptions)) },
+         .pVertexAttributeDescriptions{ std::ranges::data(attribute_descriptions) }
+      };
+
+      vk::PipelineInputAssemblyStateCreateInfo constexpr input_assembly_state_create_info{
+         .topology{ vk::PrimitiveTopology::eTriangleList }
+      };
+
+      vk::PipelineViewportStateCreateInfo constexpr viewport_state_create_info{
+         .viewportCount{ 1 },
+         .scissorCount{ 1 }
+      };
+
+      vk::PipelineRasterizationStateCreateInfo constexpr rasterization_state_create_info{
+         .depthClampEnable{ vk::False },
+         .rasterizerDiscardEnable{ vk::False },
+         .polygonMode{ vk::PolygonMode::eFill },
+         .cullMode{ vk::CullModeFlagBits::eBack },
+         .frontFace{ vk::FrontFace::eCounterClockwise },
+         .depthBiasEnable{ vk::False },
+         .depthBiasSlopeFactor{ 1.0f },
+         .lineWidth{ 1.0f }
+      };
+
+      vk::PipelineMultisampleStateCreateInfo constexpr multisample_state_create_info{
+         .rasterizationSamples{ vk::SampleCountFlagBits::e1 },
+         .sampleShadingEnable{ vk::False }
+      };
+
+      vk::PipelineDepthStencilStateCreateInfo constexpr depth_stencil_state_create_info{
+         .depthTestEnable{ vk::True },
+         .depthWriteEnable{ vk::True },
+         .depthCompareOp{ vk::CompareOp::eLess },
+         .depthBoundsTestEnable{ vk::False },
+         .stencilTestEnable{ vk::False },
+      };
+
+      std::array constexpr color_blend_attachment_state{
+         std::to_array<vk::PipelineColorBlendAttachmentState>({
             {
-               .format{ SLANG_SPIRV }
+               .blendEnable{ vk::False },
+               .colorWriteMask{
+                  vk::ColorComponentFlagBits::eR |
+                  vk::ColorComponentFlagBits::eG |
+                  vk::ColorComponentFlagBits::eB |
+                  vk::ColorComponentFlagBits::eA
+               }
             }
          })
       };
 
-      slang::SessionDesc const slang_session_description{
-         .targets{ std::ranges::data(slang_targets) },
-         .targetCount{ static_cast<SlangInt>(std::ranges::size(slang_targets)) },
-         .defaultMatrixLayoutMode{ SLANG_MATRIX_LAYOUT_COLUMN_MAJOR }
+      vk::PipelineColorBlendStateCreateInfo const color_blend_state_create_info{
+         .logicOpEnable{ vk::False },
+         .logicOp{ vk::LogicOp::eCopy },
+         .attachmentCount{ static_cast<std::uint32_t>(std::ranges::size(color_blend_attachment_state)) },
+         .pAttachments{ std::ranges::data(color_blend_attachment_state) }
+      };
+
+      std::array const color_attachments{
+         scene_format()
       };
 
-      Slang::ComPtr<slang::ISession> slang_session;
-      global_session->createSession(slang_session_description, slang_session.writeRef());
-      RUNTIME_ASSERT(slang_session,
-         std::format("failed to create a slang session! ({})", slang::getLastInternalErrorMessage()));
+      vk::PipelineRenderingCreateInfo const pipeline_rendering_create_info{
+         .colorAttachmentCount{ static_cast<std::uint32_t>(std::ranges::size(color_attachments)) },
+         .pColorAttachmentFormats{ std::ranges::data(color_attachments) },
+         .depthAttachmentFormat{ description_.depth_format }
+      };
 
-      Slang::ComPtr const slang_module{
-         slang_session->loadModuleFromSource("shader", "assets/shaders/shader.slang", nullptr, nullptr)
+      vk::ResultValue pipeline{
+         context_.device.createGraphicsPipeline(nullptr, {
+            .pNext{ &pipeline_rendering_create_info },
+            .stageCount{ static_cast<std::uint32_t>(std::ranges::size(shader_stage_create_infos)) },
+            .pStages{ std::ranges::data(shader_stage_create_infos) },
+            .pVertexInputState{ context_.mesh_shader_support ? nullptr : &vertex_input_state_create_info },
+            .pInputAssemblyState{ context_.mesh_shader_support ? nullptr : &input_assembly_state_create_info },
+            .pViewportState{ &viewport_state_create_info },
+            .pRasterizationState{ &rasterization_state_create_info },
+            .pMultisampleState{ &multisample_state_create_info },
+            .pDepthStencilState{ &depth_stencil_state_create_info },
+            .pColorBlendState{ &color_blend_state_create_info },
+            .pDynamicState{ &dynamic_state_create_info },
+            .layout{ pipeline_layout_ },
+         })
       };
-      RUNTIME_ASSERT(slang_module,
-         std::format("failed to load a slang module! ({})", slang::getLastInternalErrorMessage()));
+      RUNTIME_ASSERT(pipeline.has_value(),
+         std::format("failed create a pipeline! ({})", to_string(pipeline.result)));
 
-      Slang::ComPtr<ISlangBlob> spirv;
-      slang_module->getTargetCode(0, spirv.writeRef());
-      RUNTIME_ASSERT(spirv,
-         std::format("failed to load get target code! ({})", slang::getLastInternalErrorMessage()));
+      return std::move(*pipeline);
+   }
 
+   auto Renderer::depth_pre_pass_pipeline() const -> vk::raii::Pipeline
+   {
       vk::ShaderModuleCreateInfo const shader_module_create_info{
-         .codeSize{ spirv->getBufferSize() },
-         .pCode{ static_cast<std::uint32_t const*>(spirv->getBufferPointer()) }
+         .codeSize{ shader_code_.size() * sizeof(decltype(shader_code_)::value_type) },
+         .pCode{ shader_code_.data() }
       };
 
-      std::array const shader_stage_create_infos{
-         std::to_array<vk::PipelineShaderStageCreateInfo>({
-            {
-               .pNext{ &shader_module_create_info },
-               .stage{ vk::ShaderStageFlagBits::eVertex },
-               .pName{ "vertMain" }
-            },
-            {
-               .pNext{ &shader_module_create_info },
-               .stage{ vk::ShaderStageFlagBits::eFragment },
-               .pName{ "fragMain" }
-            }
-         })
+      vk::ShaderModuleCreateInfo const meshlet_shader_module_create_info{
+         .codeSize{ meshlet_shader_code_.size() * sizeof(decltype(meshlet_shader_code_)::value_type) },
+         .pCode{ meshlet_shader_code_.data() }
       };
 
-      std::array constexpr dynamic_states{
+      // the mesh shader is the same as the main pass's, so that equal-testing against its depth is exact
+      std::vector<vk::PipelineShaderStageCreateInfo> shader_stage_create_infos{};
+      if (context_.mesh_shader_support)
+      {
+         shader_stage_create_infos.push_back({
+            .pNext{ &meshlet_shader_module_create_info },
+            .stage{ vk::ShaderStageFlagBits::eTaskEXT },
+            .pName{ "taskMain" }
+         });
+         shader_stage_create_infos.push_back({
+            .pNext{ &meshlet_shader_module_create_info },
+            .stage{ vk::ShaderStageFlagBits::eMeshEXT },
+            .pName{ "meshMain" }
+         });
+      }
+      else
+         shader_stage_create_infos.push_back({
+            .pNext{ &shader_module_create_info },
+            .stage{ vk::ShaderStageFlagBits::eVertex },
+            .pName{ vertex_pulling() ? "pullDepthVertMain" : "depthVertMain" }
+         });
+
+      std::vector dynamic_states{
          vk::DynamicState::eViewport,
          vk::DynamicState::eScissor
       };
+      if (not context_.mesh_shader_support)
+         dynamic_states.push_back(vk::DynamicState::eVertexInputBindingStride);
 
       vk::PipelineDynamicStateCreateInfo const dynamic_state_create_info{
          .dynamicStateCount{ static_cast<uint32_t>(std::ranges::size(dynamic_states)) },
          .pDynamicStates{ std::ranges::data(dynamic_states) }
       };
 
-      vk::PipelineVertexInputStateCreateInfo constexpr vertex_input_state_create_info{
-         .vertexBindingDescriptionCount{ static_cast<std::uint32_t>(std::ranges::size(Vertex::INPUT_BINDING_DESCRIPTIONS)) },
-         .pVertexBindingDescriptions{ std::ranges::data(Vertex::INPUT_BINDING_DESCRIPTIONS) },
-         .vertexAttributeDescriptionCount{ static_cast<std::uint32_t>(std::ranges::size(Vertex::INPUT_ATTRIBUTE_DESCRIPTIONS)) },
-         .pVertexAttributeDescriptions{ std::ranges::data(Vertex::INPUT_ATTRIBUTE_DESCRIPTIONS) }
+      // only positions are fetched; the other attributes would be dead weight in a depth-only pass
+      std::vector<vk::VertexInputBindingDescription> binding_descriptions{};
+      std::vector<vk::VertexInputAttributeDescription> attribute_descriptions{};
+      if (not vertex_pulling())
+      {
+         binding_descriptions.append_range(Vertex::POSITION_INPUT_BINDING_DESCRIPTIONS);
+         attribute_descriptions.append_range(Vertex::POSITION_INPUT_ATTRIBUTE_DESCRIPTIONS);
+      }
+      binding_descriptions.append_range(Instance::INPUT_BINDING_DESCRIPTIONS);
+      attribute_descriptions.append_range(Instance::INPUT_ATTRIBUTE_DESCRIPTIONS);
+
+      vk::PipelineVertexInputStateCreateInfo const vertex_input_state_create_info{
+         .vertexBindingDescriptionCount{ static_cast<std::uint32_t>(std::ranges::size(binding_descriptions)) },
+         .pVertexBindingDescriptions{ std::ranges::data(binding_descriptions) },
+         .vertexAttributeDescriptionCount{ static_cast<std::uint32_t>(std::ranges::size(attribute_descriptions)) },
+         .pVertexAttributeDescriptions{ std::ranges::data(attribute_descriptions) }
       };
 
       vk::PipelineInputAssemblyStateCreateInfo constexpr input_assembly_state_create_info{
-         .topology{ vk::PrimitiveTopology::eTriangleStrip }
+         .topology{ vk::PrimitiveTopology::eTriangleList }
       };
 
       vk::PipelineViewportStateCreateInfo constexpr viewport_state_create_info{
@@ -712,44 +2382,23 @@ namespace eru
          .stencilTestEnable{ vk::False },
       };
 
-      std::array constexpr color_blend_attachment_state{
-         std::to_array<vk::PipelineColorBlendAttachmentState>({
-            {
-               .blendEnable{ vk::False },
-               .colorWriteMask{
-                  vk::ColorComponentFlagBits::eR |
-                  vk::ColorComponentFlagBits::eG |
-                  vk::ColorComponentFlagBits::eB |
-                  vk::ColorComponentFlagBits::eA
-               }
-            }
-         })
-      };
-
-      vk::PipelineColorBlendStateCreateInfo const color_blend_state_create_info{
+      vk::PipelineColorBlendStateCreateInfo constexpr color_blend_state_create_info{
          .logicOpEnable{ vk::False },
          .logicOp{ vk::LogicOp::eCopy },
-         .attachmentCount{ static_cast<std::uint32_t>(std::ranges::size(color_blend_attachment_state)) },
-         .pAttachments{ std::ranges::data(color_blend_attachment_state) }
+         .attachmentCount{ 0 }
       };
 
-      // std::array const color_attachments{
-      //    surface_format_.format,
-      // };
-      //
-      // vk::PipelineRenderingCreateInfo const pipeline_rendering_create_info{
-      //    .colorAttachmentCount{ static_cast<std::uint32_t>(std::ranges::size(color_attachments)) },
-      //    .pColorAttachmentFormats{ std::ranges::data(color_attachments) },
-      //    .depthAttachmentFormat{ vk::Format::eD16Unorm }
-      // };
+      vk::PipelineRenderingCreateInfo const pipeline_rendering_create_info{
+         .depthAttachmentFormat{ description_.depth_format }
+      };
 
       vk::ResultValue pipeline{
          context_.device.createGraphicsPipeline(nullptr, {
-            // .pNext{ &pipeline_rendering_create_info },
+            .pNext{ &pipeline_rendering_create_info },
             .stageCount{ static_cast<std::uint32_t>(std::ranges::size(shader_stage_create_infos)) },
             .pStages{ std::ranges::data(shader_stage_create_infos) },
-            .pVertexInputState{ &vertex_input_state_create_info },
-            .pInputAssemblyState{ &input_assembly_state_create_info },
+            .pVertexInputState{ context_.mesh_shader_support ? nullptr : &vertex_input_state_create_info },
+            .pInputAssemblyState{ context_.mesh_shader_support ? nullptr : &input_assembly_state_create_info },
             .pViewportState{ &viewport_state_create_info },
             .pRasterizationState{ &rasterization_state_create_info },
             .pMultisampleState{ &multisample_state_create_info },
@@ -760,37 +2409,273 @@ namespace eru
          })
       };
       RUNTIME_ASSERT(pipeline.has_value(),
-         std::format("failed create a pipeline! ({})", to_string(pipeline.result)));
+         std::format("failed create a depth pre-pass pipeline! ({})", to_string(pipeline.result)));
 
       return std::move(*pipeline);
    }
 
-   auto Renderer::vertex_buffer() const -> vk::raii::Buffer
+   auto Renderer::cull_descriptor_set_layout() const -> vk::raii::DescriptorSetLayout
    {
-      return context_.create_buffer({
-         .size{ sizeof(decltype(vertices_)::value_type) * vertices_.size() },
-         .usage{ vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eTransferDst },
-         .sharingMode{ vk::SharingMode::eExclusive }
-      });
+      std::array constexpr bindings{
+         std::to_array<vk::DescriptorSetLayoutBinding>({
+            {
+               .binding{ 0 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            },
+            {
+               .binding{ 1 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            },
+            {
+               .binding{ 2 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            },
+            {
+               .binding{ 3 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            },
+            {
+               .binding{ 4 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            },
+            {
+               .binding{ 5 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            },
+            {
+               .binding{ 6 },
+               .descriptorType{ vk::DescriptorType::eUniformBuffer },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            },
+            {
+               .binding{ 7 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            },
+            {
+               .binding{ 8 },
+               .descriptorType{ vk::DescriptorType::eSampledImage },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            }
+         })
+      };
+
+      // pushed per draw list, as their buffers come and go with the lists themselves
+      vk::ResultValue descriptor_set_layout{
+         context_.device.createDescriptorSetLayout({
+            .flags{ vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptor },
+            .bindingCount{ static_cast<std::uint32_t>(std::ranges::size(bindings)) },
+            .pBindings{ std::ranges::data(bindings) }
+         })
+      };
+      RUNTIME_ASSERT(descriptor_set_layout.has_value(),
+         std::format("failed to create cull descriptor set layout! ({})", to_string(descriptor_set_layout.result)));
+
+      return std::move(*descriptor_set_layout);
+   }
+
+   auto Renderer::cull_pipeline_layout() const -> vk::raii::PipelineLayout
+   {
+      std::array const layouts{
+         std::to_array<vk::DescriptorSetLayout>({
+            *cull_descriptor_set_layout_
+         })
+      };
+
+      std::array constexpr push_constant_ranges{
+         std::to_array<vk::PushConstantRange>({
+            {
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute },
+               .offset{ 0 },
+               .size{ sizeof(CullConstants) }
+            }
+         })
+      };
+
+      vk::ResultValue pipeline_layout{
+         context_.device.createPipelineLayout({
+            .setLayoutCount{ static_cast<std::uint32_t>(std::ranges::size(layouts)) },
+            .pSetLayouts{ std::ranges::data(layouts) },
+            .pushConstantRangeCount{ static_cast<std::uint32_t>(std::ranges::size(push_constant_ranges)) },
+            .pPushConstantRanges{ std::ranges::data(push_constant_ranges) }
+         })
+      };
+      RUNTIME_ASSERT(pipeline_layout.has_value(),
+         std::format("failed to create a cull pipeline layout! ({})", to_string(pipeline_layout.result)));
+
+      return std::move(*pipeline_layout);
    }
 
-   auto Renderer::vertex_buffer_memory() const -> vk::raii::DeviceMemory
+   auto Renderer::cull_shader_code() const -> std::vector<std::uint32_t>
    {
-      return context_.allocate_memory(vertex_buffer_.getMemoryRequirements(), vk::MemoryPropertyFlagBits::eDeviceLocal);
+      return compile_framework_shader("culling.slang");
    }
 
-   auto Renderer::index_buffer() const -> vk::raii::Buffer
+   auto Renderer::cull_pipeline(Phase const phase) const -> vk::raii::Pipeline
    {
-      return context_.create_buffer({
-         .size{ sizeof(decltype(vertices_)::value_type) * vertices_.size() },
-         .usage{ vk::BufferUsageFlagBits::eIndexBuffer | vk::BufferUsageFlagBits::eTransferDst },
-         .sharingMode{ vk::SharingMode::eExclusive }
-      });
+      vk::ShaderModuleCreateInfo const shader_module_create_info{
+         .codeSize{ cull_shader_code_.size() * sizeof(decltype(cull_shader_code_)::value_type) },
+         .pCode{ cull_shader_code_.data() }
+      };
+
+      vk::ResultValue pipeline{
+         context_.device.createComputePipeline(nullptr, {
+            .stage{
+               .pNext{ &shader_module_create_info },
+               .stage{ vk::ShaderStageFlagBits::eCompute },
+               .pName{ phase == Phase::EARLY ? "earlyCullMain" : "lateCullMain" }
+            },
+            .layout{ cull_pipeline_layout_ }
+         })
+      };
+      RUNTIME_ASSERT(pipeline.has_value(),
+         std::format("failed create a cull pipeline! ({})", to_string(pipeline.result)));
+
+      return std::move(*pipeline);
+   }
+
+   auto Renderer::cull_frame_buffers() const -> std::vector<CullFrameBuffers>
+   {
+      std::vector<CullFrameBuffers> cull_frame_buffers{};
+      cull_frame_buffers.reserve(MAX_FRAMES_IN_FLIGHT);
+      for (std::size_t index{}; index < MAX_FRAMES_IN_FLIGHT; ++index)
+         cull_frame_buffers.push_back({
+            .frame{ mapped_buffer<CullFrame>(1, vk::BufferUsageFlagBits::eUniformBuffer) },
+            .counters{
+               mapped_buffer<VisibilityCounters>(1, vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst)
+            }
+         });
+
+      return cull_frame_buffers;
+   }
+
+   auto Renderer::staging_buffer(std::span<std::byte const> const data) const -> StagingBuffer
+   {
+      vk::raii::Buffer buffer{
+         context_.create_buffer({
+            .size{ data.size_bytes() },
+            .usage{ vk::BufferUsageFlagBits::eTransferSrc },
+            .sharingMode{ vk::SharingMode::eExclusive }
+         })
+      };
+
+      vk::raii::DeviceMemory memory{
+         context_.allocate_memory(buffer.getMemoryRequirements(),
+            vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)
+      };
+
+      vk::Result const result{ buffer.bindMemory(memory, 0) };
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to bind staging buffer's memory! ({})", to_string(result)));
+
+      vk::ResultValue const mapped_memory{ memory.mapMemory(0, data.size_bytes()) };
+      RUNTIME_ASSERT(mapped_memory.has_value(),
+         std::format("failed to map staging buffer's memory! ({})", to_string(mapped_memory.result)));
+
+      std::memcpy(*mapped_memory, data.data(), data.size_bytes());
+      memory.unmapMemory();
+
+      return {
+         .buffer{ std::move(buffer) },
+         .memory{ std::move(memory) }
+      };
+   }
+
+   auto Renderer::mesh_buffer(std::size_t const size, vk::BufferUsageFlags const usage) const -> MeshBuffer
+   {
+      vk::raii::Buffer buffer{
+         context_.create_buffer({
+            .size{ size },
+            .usage{ usage | vk::BufferUsageFlagBits::eTransferDst },
+            .sharingMode{ vk::SharingMode::eExclusive }
+         })
+      };
+
+      vk::raii::DeviceMemory memory{
+         context_.allocate_memory(buffer.getMemoryRequirements(), vk::MemoryPropertyFlagBits::eDeviceLocal)
+      };
+
+      vk::Result const result{ buffer.bindMemory(memory, 0) };
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to bind mesh buffer's memory! ({})", to_string(result)));
+
+      return {
+         .buffer{ std::move(buffer) },
+         .memory{ std::move(memory) }
+      };
+   }
+
+   template<typename Element>
+   auto Renderer::mapped_buffer(std::size_t const capacity, vk::BufferUsageFlags const usage) const -> MappedBuffer<Element>
+   {
+      vk::raii::Buffer buffer{
+         context_.create_buffer({
+            .size{ capacity * sizeof(Element) },
+            .usage{ usage },
+            .sharingMode{ vk::SharingMode::eExclusive }
+         })
+      };
+
+      vk::raii::DeviceMemory memory{
+         context_.allocate_memory(buffer.getMemoryRequirements(),
+            vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)
+      };
+
+      vk::Result const result{ buffer.bindMemory(memory, 0) };
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to bind mapped buffer's memory! ({})", to_string(result)));
+
+      vk::ResultValue const mapped_memory{ memory.mapMemory(0, vk::WholeSize) };
+      RUNTIME_ASSERT(mapped_memory.has_value(),
+         std::format("failed to map mapped buffer's memory! ({})", to_string(mapped_memory.result)));
+
+      return {
+         .buffer{ std::move(buffer) },
+         .memory{ std::move(memory) },
+         .elements{ static_cast<Element*>(*mapped_memory) },
+         .capacity{ capacity }
+      };
    }
 
-   auto Renderer::index_buffer_memory() const -> vk::raii::DeviceMemory
+   template<typename Element>
+   auto Renderer::device_buffer(std::size_t const capacity, vk::BufferUsageFlags const usage) const -> DeviceBuffer<Element>
    {
-      return context_.allocate_memory(index_buffer_.getMemoryRequirements(), vk::MemoryPropertyFlagBits::eDeviceLocal);
+      vk::raii::Buffer buffer{
+         context_.create_buffer({
+            .size{ capacity * sizeof(Element) },
+            .usage{ usage },
+            .sharingMode{ vk::SharingMode::eExclusive }
+         })
+      };
+
+      vk::raii::DeviceMemory memory{
+         context_.allocate_memory(buffer.getMemoryRequirements(), vk::MemoryPropertyFlagBits::eDeviceLocal)
+      };
+
+      vk::Result const result{ buffer.bindMemory(memory, 0) };
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to bind device buffer's memory! ({})", to_string(result)));
+
+      return {
+         .buffer{ std::move(buffer) },
+         .memory{ std::move(memory) },
+         .capacity{ capacity }
+      };
    }
 
    auto Renderer::uniform_buffers() const -> std::vector<vk::raii::Buffer>
@@ -821,6 +2706,70 @@ namespace eru
       return uniform_buffer_memories;
    }
 
+   auto Renderer::recording_pools() const -> std::vector<RecordingPool>
+   {
+      std::size_t const pool_count{ MAX_FRAMES_IN_FLIGHT * thread_pool_.thread_count() };
+
+      std::vector<RecordingPool> recording_pools{};
+      recording_pools.reserve(pool_count);
+      for (std::size_t index{}; index < pool_count; ++index)
+      {
+         // no per-buffer reset flag; the whole pool is reset once per frame instead
+         vk::ResultValue command_pool{
+            context_.device.createCommandPool({
+               .flags{ vk::CommandPoolCreateFlagBits::eTransient },
+               .queueFamilyIndex{ context_.queue_family_index }
+            })
+         };
+         RUNTIME_ASSERT(command_pool.has_value(),
+            std::format("failed to create a recording command pool! ({})", to_string(command_pool.result)));
+
+         recording_pools.push_back({ .command_pool{ std::move(*command_pool) } });
+      }
+
+      return recording_pools;
+   }
+
+   auto Renderer::static_segment(std::vector<Draw> draws) const -> StaticSegment
+   {
+      // command buffers are reset individually here, as segments are re-recorded only when they are outdated
+      vk::ResultValue command_pool{
+         context_.device.createCommandPool({
+            .flags{ vk::CommandPoolCreateFlagBits::eResetCommandBuffer },
+            .queueFamilyIndex{ context_.queue_family_index }
+         })
+      };
+      RUNTIME_ASSERT(command_pool.has_value(),
+         std::format("failed to create a static segment command pool! ({})", to_string(command_pool.result)));
+
+      vk::ResultValue depth_pre_pass_command_buffers{
+         context_.device.allocateCommandBuffers({
+            .commandPool{ *command_pool },
+            .level{ vk::CommandBufferLevel::eSecondary },
+            .commandBufferCount{ static_cast<std::uint32_t>(MAX_FRAMES_IN_FLIGHT * PHASE_COUNT) }
+         })
+      };
+      RUNTIME_ASSERT(depth_pre_pass_command_buffers.has_value(),
+         std::format("failed to allocate static segment command buffers! ({})", to_string(depth_pre_pass_command_buffers.result)));
+
+      vk::ResultValue main_command_buffers{
+         context_.device.allocateCommandBuffers({
+            .commandPool{ *command_pool },
+            .level{ vk::CommandBufferLevel::eSecondary },
+            .commandBufferCount{ static_cast<std::uint32_t>(MAX_FRAMES_IN_FLIGHT * PHASE_COUNT) }
+         })
+      };
+      RUNTIME_ASSERT(main_command_buffers.has_value(),
+         std::format("failed to allocate static segment command buffers! ({})", to_string(main_command_buffers.result)));
+
+      return {
+         .draws{ std::move(draws) },
+         .command_pool{ std::move(*command_pool) },
+         .depth_pre_pass_command_buffers{ std::move(*depth_pre_pass_command_buffers) },
+         .main_command_buffers{ std::move(*main_command_buffers) }
+      };
+   }
+
    auto Renderer::texture(std::string_view const path) const -> UniquePointer<ktxTexture2>
    {
       if (not std::filesystem::exists(path))
@@ -871,20 +2820,20 @@ namespace eru
       return texture;
    }
 
-   auto Renderer::image() const -> vk::raii::Image
+   auto Renderer::image(ktxTexture2 const& texture) const -> vk::raii::Image
    {
       vk::ResultValue image{
          context_.device.createImage({
             .flags{},
-            .imageType{ static_cast<vk::ImageType>(texture_->numDimensions - 1) },
-            .format{ static_cast<vk::Format>(texture_->vkFormat) },
+            .imageType{ static_cast<vk::ImageType>(texture.numDimensions - 1) },
+            .format{ static_cast<vk::Format>(texture.vkFormat) },
             .extent{
-               .width{ texture_->baseWidth },
-               .height{ texture_->baseHeight },
-               .depth{ texture_->baseDepth }
+               .width{ texture.baseWidth },
+               .height{ texture.baseHeight },
+               .depth{ texture.baseDepth }
             },
-            .mipLevels{ texture_->numLevels },
-            .arrayLayers{ texture_->numLayers },
+            .mipLevels{ texture.numLevels },
+            .arrayLayers{ texture.numLayers },
             .samples{ vk::SampleCountFlagBits::e1 },
             .tiling{ vk::ImageTiling::eOptimal },
             .usage{ vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst },
@@ -897,13 +2846,13 @@ namespace eru
       return std::move(*image);
    }
 
-   auto Renderer::image_view() const -> vk::raii::ImageView
+   auto Renderer::image_view(vk::raii::Image const& image, vk::Format const format) const -> vk::raii::ImageView
    {
       vk::ResultValue image_view{
          context_.device.createImageView({
-            .image{ image_ },
+            .image{ image },
             .viewType{ vk::ImageViewType::e2D },
-            .format{ static_cast<vk::Format>(texture_->vkFormat) },
+            .format{ format },
             .subresourceRange{
                .aspectMask{ vk::ImageAspectFlagBits::eColor },
                .baseMipLevel{ 0 },
@@ -945,37 +2894,35 @@ namespace eru
       return std::move(*sampler);
    }
 
-   auto Renderer::image_memory() const -> vk::raii::DeviceMemory
+   auto Renderer::image_memory(vk::raii::Image const& image) const -> vk::raii::DeviceMemory
    {
-      return context_.allocate_memory(image_.getMemoryRequirements(), vk::MemoryPropertyFlagBits::eDeviceLocal);
+      return context_.allocate_memory(image.getMemoryRequirements(), vk::MemoryPropertyFlagBits::eDeviceLocal);
    }
 
-   auto Renderer::depth_image() const -> vk::raii::Image
+   auto Renderer::depth_image(vk::Extent2D const extent) const -> vk::raii::Image
    {
-      // vk::ResultValue image{
-      //    context_.device.createImage({
-      //       .imageType{ vk::ImageType::e2D },
-      //       .format{ vk::Format::eD16Unorm },
-      //       .extent{
-      //          .width{ surface_extent_.width },
-      //          .height{ surface_extent_.height },
-      //          .depth{ 1 }
-      //       },
-      //       .mipLevels{ 1 },
-      //       .arrayLayers{ 1 },
-      //       .samples{ vk::SampleCountFlagBits::e1 },
-      //       .tiling{ vk::ImageTiling::eOptimal },
-      //       .usage{ vk::ImageUsageFlagBits::eDepthStencilAttachment },
-      //       .sharingMode{ vk::SharingMode::eExclusive },
-      //       .initialLayout{ vk::ImageLayout::eUndefined },
-      //    })
-      // };
-      // RUNTIME_ASSERT(image.result == vk::Result::eSuccess,
-      //    std::format("failed to create depth image! ({})", to_string(image.result)));
-      //
-      // return std::move(*image);
+      vk::ResultValue image{
+         context_.device.createImage({
+            .imageType{ vk::ImageType::e2D },
+            .format{ description_.depth_format },
+            .extent{
+               .width{ extent.width },
+               .height{ extent.height },
+               .depth{ 1 }
+            },
+            .mipLevels{ 1 },
+            .arrayLayers{ 1 },
+            .samples{ vk::SampleCountFlagBits::e1 },
+            .tiling{ vk::ImageTiling::eOptimal },
+            .usage{ vk::ImageUsageFlagBits::eDepthStencilAttachment | vk::ImageUsageFlagBits::eSampled },
+            .sharingMode{ vk::SharingMode::eExclusive },
+            .initialLayout{ vk::ImageLayout::eUndefined },
+         })
+      };
+      RUNTIME_ASSERT(image.result == vk::Result::eSuccess,
+         std::format("failed to create depth image! ({})", to_string(image.result)));
 
-      return nullptr;
+      return std::move(*image);
    }
 
    auto Renderer::depth_image_view() const -> vk::raii::ImageView
@@ -984,7 +2931,7 @@ namespace eru
          context_.device.createImageView({
             .image{ depth_image_ },
             .viewType{ vk::ImageViewType::e2D },
-            .format{ vk::Format::eD16Unorm },
+            .format{ description_.depth_format },
             .subresourceRange{
                .aspectMask{ vk::ImageAspectFlagBits::eDepth },
                .baseMipLevel{ 0 },
@@ -1002,7 +2949,73 @@ namespace eru
 
    auto Renderer::depth_image_memory() const -> vk::raii::DeviceMemory
    {
-      // return context_.allocate_memory(depth_image_.getMemoryRequirements(), vk::MemoryPropertyFlagBits::eDeviceLocal);
-      return nullptr;
+      return context_.allocate_memory(depth_image_.getMemoryRequirements(), vk::MemoryPropertyFlagBits::eDeviceLocal);
+   }
+
+   auto Renderer::color_image(vk::Extent2D const extent) const -> vk::raii::Image
+   {
+      vk::ResultValue image{
+         context_.device.createImage({
+            .imageType{ vk::ImageType::e2D },
+            .format{ scene_format() },
+            .extent{
+               .width{ extent.width },
+               .height{ extent.height },
+               .depth{ 1 }
+            },
+            .mipLevels{ 1 },
+            .arrayLayers{ 1 },
+            .samples{ vk::SampleCountFlagBits::e1 },
+            .tiling{ vk::ImageTiling::eOptimal },
+            .usage{ vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eSampled },
+            .sharingMode{ vk::SharingMode::eExclusive },
+            .initialLayout{ vk::ImageLayout::eUndefined },
+         })
+      };
+      RUNTIME_ASSERT(image.result == vk::Result::eSuccess,
+         std::format("failed to create color image! ({})", to_string(image.result)));
+
+      return std::move(*image);
+   }
+
+   auto Renderer::color_image_view() const -> vk::raii::ImageView
+   {
+      vk::ResultValue image_view{
+         context_.device.createImageView({
+            .image{ color_image_ },
+            .viewType{ vk::ImageViewType::e2D },
+            .format{ scene_format() },
+            .subresourceRange{
+               .aspectMask{ vk::ImageAspectFlagBits::eColor },
+               .baseMipLevel{ 0 },
+               .levelCount{ 1 },
+               .baseArrayLayer{ 0 },
+               .layerCount{ 1 }
+            }
+         })
+      };
+      RUNTIME_ASSERT(image_view.result == vk::Result::eSuccess,
+         std::format("failed to create color image view! ({})", to_string(image_view.result)));
+
+      return std::move(*image_view);
+   }
+
+   auto Renderer::color_image_memory() const -> vk::raii::DeviceMemory
+   {
+      return context_.allocate_memory(color_image_.getMemoryRequirements(), vk::MemoryPropertyFlagBits::eDeviceLocal);
+   }
+
+   auto Renderer::timestamp_query_pool() const -> vk::raii::QueryPool
+   {
+      vk::ResultValue query_pool{
+         context_.device.createQueryPool({
+            .queryType{ vk::QueryType::eTimestamp },
+            .queryCount{ MAX_FRAMES_IN_FLIGHT * TIMESTAMPS_PER_FRAME }
+         })
+      };
+      RUNTIME_ASSERT(query_pool.has_value(),
+         std::format("failed to create a timestamp query pool! ({})", to_string(query_pool.result)));
+
+      return std::move(*query_pool);
    }
 }
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include "eruptor/runtime_assert.hpp"
+#include "eruptor/thread_pool.hpp"
+
+namespace eru
+{
+   namespace
+   {
+      // of the task the thread is running, if any; nested calls to `execute` would otherwise wait on the very work
+      // they are a part of
+      thread_local std::optional<std::size_t> running_thread_index{};
+   }
+
+   ThreadPool::ThreadPool(PassKey<Locator>, std::size_t const thread_count)
+   {
+      RUNTIME_ASSERT(thread_count, "a thread pool needs at least one thread!");
+
+      threads_.reserve(thread_count - 1);
+      for (std::size_t thread_index{ 1 }; thread_index < thread_count; ++thread_index)
+         threads_.emplace_back(
+            [this, thread_index](std::stop_token const& stop_token) -> void
+            {
+               work(stop_token, thread_index);
+            });
+   }
+
+   ThreadPool::~ThreadPool()
+   {
+      for (std::jthread& thread : threads_)
+         thread.request_stop();
+
+      {
+         std::lock_guard const lock{ mutex_ };
+      }
+
+      condition_.notify_all();
+   }
+
+   auto ThreadPool::execute(std::size_t const task_count, Task const& task) -> void
+   {
+      if (not task_count)
+         return;
+
+      if (running_thread_index)
+      {
+         for (std::size_t task_index{}; task_index < task_count; ++task_index)
+            task(task_index, *running_thread_index);
+
+         return;
+      }
+
+      std::lock_guard const execution_lock{ execution_mutex_ };
+
+      {
+         std::unique_lock lock{ mutex_ };
+
+         // threads that woke up too late for the previous batch may still be on their way out
+         done_condition_.wait(lock,
+            [this]
+            {
+               return not busy_threads_;
+            });
+
+         task_ = &task;
+         task_count_ = task_count;
+         next_task_index_ = 0;
+         remaining_tasks_ = task_count;
+         ++generation_;
+      }
+
+      condition_.notify_all();
+
+      std::size_t const completed_tasks{ run_tasks(task, task_count, 0) };
+
+      std::unique_lock lock{ mutex_ };
+      remaining_tasks_ -= completed_tasks;
+      done_condition_.wait(lock,
+         [this]
+         {
+            return not remaining_tasks_ and not busy_threads_;
+         });
+
+      task_ = nullptr;
+   }
+
+   auto ThreadPool::thread_count() const -> std::size_t
+   {
+      return threads_.size() + 1;
+   }
+
+   auto ThreadPool::work(std::stop_token const& stop_token, std::size_t const thread_index) -> void
+   {
+      std::uint64_t handled_generation{};
+      while (true)
+      {
+         Task const* task;
+         std::size_t task_count;
+
+         {
+            std::unique_lock lock{ mutex_ };
+            condition_.wait(lock,
+               [this, &handled_generation, &stop_token]
+               {
+                  return generation_ not_eq handled_generation or stop_token.stop_requested();
+               });
+
+            if (stop_token.stop_requested())
+               break;
+
+            handled_generation = generation_;
+            if (not task_)
+               continue;
+
+            task = task_;
+            task_count = task_count_;
+            ++busy_threads_;
+         }
+
+         std::size_t const completed_tasks{ run_tasks(*task, task_count, thread_index) };
+
+         {
+            std::lock_guard const lock{ mutex_ };
+            remaining_tasks_ -= completed_tasks;
+            --busy_threads_;
+         }
+
+         done_condition_.notify_all();
+      }
+   }
+
+   auto ThreadPool::run_tasks(Task const& task, std::size_t const task_count, std::size_t const thread_index) -> std::size_t
+   {
+      running_thread_index = thread_index;
+
+      std::size_t completed_tasks{};
+      for (std::size_t task_index{ next_task_index_++ }; task_index < task_count; task_index = next_task_index_++)
+      {
+         task(task_index, thread_index);
+         ++completed_tasks;
+      }
+
+      running_thread_index.reset();
+      return completed_tasks;
+   }
+}
\ No newline at end of file
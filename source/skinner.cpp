@@ -0,0 +1,258 @@
+#include "eruptor/context.hpp"
+#include "eruptor/dispatcher.hpp"
+#include "eruptor/runtime_assert.hpp"
+#include "eruptor/skinner.hpp"
+
+#include "core/shader.hpp"
+
+namespace eru
+{
+   Skinner::Skinner() = default;
+
+   auto Skinner::create_mesh(std::span<Vertex const> const vertices) -> std::uint32_t
+   {
+      RUNTIME_ASSERT(not vertices.empty(),
+         "a skinned mesh has to have vertices!");
+
+      std::vector<PackedVertex> packed_vertices{};
+      packed_vertices.reserve(vertices.size());
+      for (Vertex const& vertex : vertices)
+      {
+         RUNTIME_ASSERT(std::max({ vertex.joints.x, vertex.joints.y, vertex.joints.z, vertex.joints.w }) < MAX_JOINTS,
+            std::format("a skinned vertex refers to a joint past the last of {}!", MAX_JOINTS));
+
+         packed_vertices.push_back({
+            .position{ vertex.position },
+            .joints_0{ vertex.joints.x | static_cast<std::uint32_t>(vertex.joints.y) << 16 },
+            .normal{ vertex.normal },
+            .joints_1{ vertex.joints.z | static_cast<std::uint32_t>(vertex.joints.w) << 16 },
+            .weights{ vertex.weights }
+         });
+      }
+
+      Buffer buffer{
+         context_.create_bound_buffer(packed_vertices.size() * sizeof(PackedVertex),
+            vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst, false)
+      };
+      upload(buffer, std::as_bytes(std::span{ packed_vertices }));
+
+      meshes_.push_back({
+         .vertices{ std::move(buffer) },
+         .vertex_count{ static_cast<std::uint32_t>(vertices.size()) }
+      });
+
+      return static_cast<std::uint32_t>(meshes_.size() - 1);
+   }
+
+   auto Skinner::create_instance(std::uint32_t const mesh) -> std::uint32_t
+   {
+      RUNTIME_ASSERT(mesh < meshes_.size(),
+         std::format("there is no skinned mesh {}!", mesh));
+
+      Instance instance{
+         .mesh{ mesh },
+         .skinned_vertices{
+            context_.create_bound_buffer(meshes_[mesh].vertex_count * sizeof(SkinnedVertex),
+               vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eVertexBuffer, false)
+         },
+         .palettes{},
+         .palette{ MAX_JOINTS, glm::mat4{ 1.0f } },
+         .pending{ true }
+      };
+
+      // every frame's palette starts out as the bind pose, so that whichever frame records first skins it
+      instance.palettes.reserve(MAX_FRAMES_IN_FLIGHT);
+      for (std::size_t index{}; index < MAX_FRAMES_IN_FLIGHT; ++index)
+      {
+         Buffer const& palette{
+            instance.palettes.emplace_back(
+               context_.create_bound_buffer(MAX_JOINTS * sizeof(glm::mat4), vk::BufferUsageFlagBits::eStorageBuffer, true))
+         };
+         std::memcpy(palette.mapped, instance.palette.data(), instance.palette.size() * sizeof(glm::mat4));
+      }
+
+      instances_.push_back(std::move(instance));
+      return static_cast<std::uint32_t>(instances_.size() - 1);
+   }
+
+   auto Skinner::pose(std::uint32_t const instance, std::uint8_t const frame_index,
+      std::span<glm::mat4 const> const palette) -> void
+   {
+      RUNTIME_ASSERT(instance < instances_.size(),
+         std::format("there is no skinned instance {}!", instance));
+
+      RUNTIME_ASSERT(palette.size() <= MAX_JOINTS,
+         std::format("a palette of {} joints exceeds the maximum of {}!", palette.size(), MAX_JOINTS));
+
+      // matrices past the given ones are left as they were, as no vertex should refer to them; a pending instance is
+      // still written to, as it may have been posed for another frame
+      Instance& posed_instance{ instances_[instance] };
+      if (not posed_instance.pending and
+         std::ranges::equal(palette, std::span{ posed_instance.palette }.first(palette.size())))
+         return;
+
+      std::ranges::copy(palette, posed_instance.palette.begin());
+      std::memcpy(posed_instance.palettes[frame_index].mapped, posed_instance.palette.data(),
+         posed_instance.palette.size() * sizeof(glm::mat4));
+      posed_instance.pending = true;
+   }
+
+   auto Skinner::record(vk::raii::CommandBuffer const& command_buffer, std::uint8_t const frame_index) -> void
+   {
+      // every instance reads a mesh and a palette of its own and writes to nothing another one touches, so the
+      // dispatcher puts all of them at the same level, with a single barrier after
+      Dispatcher dispatcher{};
+      bool skinned{};
+      for (Instance& instance : instances_)
+      {
+         if (not instance.pending)
+            continue;
+
+         Mesh const& mesh{ meshes_[instance.mesh] };
+         std::array const buffers{
+            std::to_array<Dispatcher::BufferBinding>({
+               {
+                  .binding{ 0 },
+                  .type{ vk::DescriptorType::eStorageBuffer },
+                  .buffer{ mesh.vertices.buffer },
+                  .access{ Dispatcher::Access::READ }
+               },
+               {
+                  .binding{ 1 },
+                  .type{ vk::DescriptorType::eStorageBuffer },
+                  .buffer{ instance.palettes[frame_index].buffer },
+                  .access{ Dispatcher::Access::READ }
+               },
+               {
+                  .binding{ 2 },
+                  .type{ vk::DescriptorType::eStorageBuffer },
+                  .buffer{ instance.skinned_vertices.buffer },
+                  .access{ Dispatcher::Access::WRITE }
+               }
+            })
+         };
+
+         SkinConstants const skin_constants{
+            .vertex_count{ mesh.vertex_count }
+         };
+
+         dispatcher.dispatch({
+            .pipeline{ pipeline_ },
+            .thread_count{ mesh.vertex_count, 1, 1 },
+            .buffers{ buffers },
+            .push_constants{ std::as_bytes(std::span{ &skin_constants, 1 }) }
+         });
+
+         instance.pending = false;
+         skinned = true;
+      }
+
+      if (not skinned)
+         return;
+
+      // the skinned vertices are overwritten in place, so whatever the previous frames drew from them has to be done
+      // first; only an execution dependency, as nothing was written there
+      vk::MemoryBarrier2 constexpr reuse_barrier{
+         .srcStageMask{ vk::PipelineStageFlagBits2::eAllGraphics | vk::PipelineStageFlagBits2::eComputeShader },
+         .dstStageMask{ vk::PipelineStageFlagBits2::eComputeShader }
+      };
+
+      command_buffer.pipelineBarrier2({
+         .memoryBarrierCount{ 1 },
+         .pMemoryBarriers{ &reuse_barrier }
+      });
+
+      dispatcher.record(command_buffer,
+         vk::PipelineStageFlagBits2::eAllGraphics | vk::PipelineStageFlagBits2::eComputeShader,
+         vk::AccessFlagBits2::eVertexAttributeRead | vk::AccessFlagBits2::eShaderStorageRead);
+   }
+
+   auto Skinner::vertex_buffer(std::uint32_t const instance) const -> vk::Buffer
+   {
+      RUNTIME_ASSERT(instance < instances_.size(),
+         std::format("there is no skinned instance {}!", instance));
+
+      return instances_[instance].skinned_vertices.buffer;
+   }
+
+   auto Skinner::vertex_count(std::uint32_t const instance) const -> std::uint32_t
+   {
+      RUNTIME_ASSERT(instance < instances_.size(),
+         std::format("there is no skinned instance {}!", instance));
+
+      return meshes_[instances_[instance].mesh].vertex_count;
+   }
+
+   auto Skinner::layout() const -> Layout
+   {
+      std::array constexpr bindings{
+         std::to_array<vk::DescriptorSetLayoutBinding>({
+            {
+               .binding{ 0 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            },
+            {
+               .binding{ 1 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            },
+            {
+               .binding{ 2 },
+               .descriptorType{ vk::DescriptorType::eStorageBuffer },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute }
+            }
+         })
+      };
+
+      std::array const sets{
+         std::to_array<std::span<vk::DescriptorSetLayoutBinding const>>({
+            bindings
+         })
+      };
+
+      std::array constexpr push_constant_ranges{
+         std::to_array<vk::PushConstantRange>({
+            {
+               .stageFlags{ vk::ShaderStageFlagBits::eCompute },
+               .offset{ 0 },
+               .size{ sizeof(SkinConstants) }
+            }
+         })
+      };
+
+      // pushed per instance, as every instance has buffers of its own
+      return Layout{ {
+         .sets{ sets },
+         .push_constants{ push_constant_ranges },
+         .push_descriptor_set{ 0 }
+      } };
+   }
+
+   auto Skinner::pipeline() const -> ComputePipeline
+   {
+      return { layout_, compile_framework_shader("skinning.slang"), "skinMain" };
+   }
+
+   auto Skinner::upload(Buffer const& destination, std::span<std::byte const> const data) const -> void
+   {
+      Buffer const staging_buffer{
+         context_.create_bound_buffer(data.size_bytes(), vk::BufferUsageFlagBits::eTransferSrc, true)
+      };
+      std::memcpy(staging_buffer.mapped, data.data(), data.size_bytes());
+
+      // waited on right away, which also makes the copy visible to whatever is submitted after
+      context_.submit_immediately(
+         [&](vk::raii::CommandBuffer const& command_buffer) -> void
+         {
+            command_buffer.copyBuffer(staging_buffer.buffer, destination.buffer, {
+               {
+                  .size{ data.size_bytes() }
+               }
+            });
+         });
+   }
+}
\ No newline at end of file
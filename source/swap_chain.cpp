@@ -7,30 +7,170 @@ namespace eru
 {
    SwapChain::SwapChain(PassKey<Window> const, vk::raii::SurfaceKHR const& surface, Description const& parameters)
       : surface_{ surface }
+      , description_{ parameters }
       , image_available_semaphores_{ { context_.create_semaphores(parameters.frames_in_flight) } }
-      , swap_chain_{ swap_chain(parameters) }
-      , swap_chain_image_views_{ swap_chain_image_views(parameters.format) }
+      , surface_format_{ surface_format() }
+      , extent_{ image_extent(parameters.extent) }
+      , swap_chain_{ swap_chain(nullptr) }
    {
    }
 
    SwapChain::~SwapChain()
    {
-      vk::Result const result{ context_.device.waitIdle() };
+      vk::Result result{ context_.device.waitIdle() };
       RUNTIME_ASSERT(result == vk::Result::eSuccess,
          std::format("failed to wait idle on the device! ({})", to_string(result)));
+
+      // presentation is not a part of what waiting idle waits for
+      std::vector<vk::Fence> present_fences{ std::from_range, present_fences_ };
+      for (RetiredSwapChain const& retired_swap_chain : retired_swap_chains_)
+         present_fences.append_range(retired_swap_chain.present_fences);
+
+      if (present_fences.empty())
+         return;
+
+      result = context_.device.waitForFences(present_fences, true, std::numeric_limits<std::uint64_t>::max());
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to wait for the presentation engine! ({})", to_string(result)));
    }
 
-   auto SwapChain::swap_chain(Description const& parameters) const -> vk::raii::SwapchainKHR
+   auto SwapChain::acquire(std::uint8_t const frame_index) const -> std::optional<std::uint32_t>
    {
-      // TODO: use `vk::StructureChain` and `getSurfaceCapabilities2KHR` for more functionality
-      vk::ResultValue surface_capabilities{ context_.physical_device.getSurfaceCapabilitiesKHR(surface_) };
-      RUNTIME_ASSERT(surface_capabilities.has_value(),
-         std::format("failed to query surface capabilities! ({})", to_string(surface_capabilities.result)));
+      auto const [result, image_index]{
+         swap_chain_.acquireNextImage(std::numeric_limits<std::uint64_t>::max(), image_available_semaphores_[frame_index])
+      };
+      if (result == vk::Result::eErrorOutOfDateKHR)
+         return std::nullopt;
 
-      std::uint32_t minimal_image_count{ std::max(parameters.minimal_image_count, surface_capabilities->minImageCount) };
-      if (surface_capabilities->maxImageCount)
-         minimal_image_count = std::min(minimal_image_count, surface_capabilities->maxImageCount);
+      RUNTIME_ASSERT(result == vk::Result::eSuccess or result == vk::Result::eSuboptimalKHR,
+         std::format("failed to acquire a swap chain image! ({})", to_string(result)));
+
+      return image_index;
+   }
+
+   auto SwapChain::present(std::uint32_t const image_index, std::uint64_t const present_id) -> bool
+   {
+      release_presented();
+
+      vk::PresentIdKHR const present_id_info{
+         .swapchainCount{ 1 },
+         .pPresentIds{ &present_id }
+      };
+
+      vk::raii::Fence& present_fence{ present_fences_.emplace_back(this->present_fence()) };
+      vk::SwapchainPresentFenceInfoEXT const present_fence_info{
+         .pNext{ present_id ? &present_id_info : nullptr },
+         .swapchainCount{ 1 },
+         .pFences{ &*present_fence }
+      };
+
+      if (present_id)
+      {
+         RUNTIME_ASSERT(present_id > last_present_id_,
+            std::format("present id {} is not higher than the last one, {}!", present_id, last_present_id_));
+
+         last_present_id_ = present_id;
+      }
+
+      // the fence is signaled even when the swap chain turns out to be out of date, as the semaphore is still waited on
+      vk::Result const result{
+         context_.queue.presentKHR({
+            .pNext{ &present_fence_info },
+            .waitSemaphoreCount{ 1 },
+            .pWaitSemaphores{ &*present_semaphores_[image_index] },
+            .swapchainCount{ 1 },
+            .pSwapchains{ &*swap_chain_ },
+            .pImageIndices{ &image_index }
+         })
+      };
+      if (result == vk::Result::eErrorOutOfDateKHR or result == vk::Result::eSuboptimalKHR)
+         return false;
+
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to present a swap chain image! ({})", to_string(result)));
+
+      return true;
+   }
+
+   auto SwapChain::wait_for_present(std::uint64_t const present_id, std::chrono::nanoseconds const timeout) const -> bool
+   {
+      if (present_id < first_present_id_)
+         return true;
+
+      // an out of date swap chain no longer presents anything, so there is nothing left to wait for
+      vk::Result const result{ swap_chain_.waitForPresent(present_id, static_cast<std::uint64_t>(timeout.count())) };
+      if (result == vk::Result::eTimeout)
+         return false;
+
+      RUNTIME_ASSERT(result == vk::Result::eSuccess or result == vk::Result::eSuboptimalKHR
+         or result == vk::Result::eErrorOutOfDateKHR,
+         std::format("failed to wait for a present! ({})", to_string(result)));
+
+      return true;
+   }
+
+   auto SwapChain::recreate(vk::Extent2D const extent) -> void
+   {
+      release_presented();
+      first_present_id_ = last_present_id_ + 1;
+
+      extent_ = image_extent(extent);
+      vk::raii::SwapchainKHR swap_chain{ this->swap_chain(swap_chain_) };
+
+      retired_swap_chains_.push_back({
+         .swap_chain{ std::exchange(swap_chain_, std::move(swap_chain)) },
+         .image_views{ std::exchange(swap_chain_image_views_, {}) },
+         .present_semaphores{ std::exchange(present_semaphores_, {}) },
+         .present_fences{ std::exchange(present_fences_, {}) }
+      });
+
+      swap_chain_images_ = swap_chain_images();
+      swap_chain_image_views_ = swap_chain_image_views();
+      present_semaphores_ = context_.create_semaphores(image_count());
+   }
+
+   auto SwapChain::image_available_semaphore(std::uint8_t const frame_index) const -> vk::Semaphore
+   {
+      return image_available_semaphores_[frame_index];
+   }
+
+   auto SwapChain::present_semaphore(std::uint32_t const image_index) const -> vk::Semaphore
+   {
+      return present_semaphores_[image_index];
+   }
+
+   auto SwapChain::image(std::uint32_t const image_index) const -> vk::Image
+   {
+      return swap_chain_images_[image_index];
+   }
 
+   auto SwapChain::image_view(std::uint32_t const image_index) const -> vk::ImageView
+   {
+      return swap_chain_image_views_[image_index];
+   }
+
+   auto SwapChain::image_count() const -> std::uint32_t
+   {
+      return static_cast<std::uint32_t>(swap_chain_images_.size());
+   }
+
+   auto SwapChain::extent() const -> vk::Extent2D
+   {
+      return extent_;
+   }
+
+   auto SwapChain::format() const -> vk::Format
+   {
+      return surface_format_.format;
+   }
+
+   auto SwapChain::frames_in_flight() const -> std::uint32_t
+   {
+      return static_cast<std::uint32_t>(image_available_semaphores_.size());
+   }
+
+   auto SwapChain::surface_format() const -> vk::SurfaceFormatKHR
+   {
       // TODO: use `vk::StructureChain` and `getSurfaceFormats2KHR` for more functionality
       vk::ResultValue const available_surface_formats{ context_.physical_device.getSurfaceFormatsKHR(surface_) };
       RUNTIME_ASSERT(available_surface_formats.has_value(),
@@ -42,22 +182,46 @@ namespace eru
       auto surface_format{
          std::ranges::find_if(
             *available_surface_formats,
-            [&parameters](vk::SurfaceFormatKHR const& available_surface_format)
+            [this](vk::SurfaceFormatKHR const& available_surface_format)
             {
                auto const [format, color_space]{ available_surface_format };
-               return format == parameters.format
-                  and color_space == parameters.color_space;
+               return format == description_.format
+                  and color_space == description_.color_space;
             })
       };
       if (surface_format == std::ranges::end(*available_surface_formats))
          surface_format = std::ranges::begin(*available_surface_formats);
 
+      return *surface_format;
+   }
+
+   auto SwapChain::image_extent(vk::Extent2D const requested_extent) const -> vk::Extent2D
+   {
+      // TODO: use `vk::StructureChain` and `getSurfaceCapabilities2KHR` for more functionality
+      vk::ResultValue const surface_capabilities{ context_.physical_device.getSurfaceCapabilitiesKHR(surface_) };
+      RUNTIME_ASSERT(surface_capabilities.has_value(),
+         std::format("failed to query surface capabilities! ({})", to_string(surface_capabilities.result)));
+
       if (surface_capabilities->currentExtent.width == std::numeric_limits<std::uint32_t>::max() and surface_capabilities->currentExtent.height == std::numeric_limits<std::uint32_t>::max())
-         surface_capabilities->currentExtent = {
-            std::clamp<std::uint32_t>(parameters.extent.width, surface_capabilities->minImageExtent.width, surface_capabilities->maxImageExtent.width),
-            std::clamp<std::uint32_t>(parameters.extent.height, surface_capabilities->minImageExtent.height, surface_capabilities->maxImageExtent.height)
+         return {
+            std::clamp<std::uint32_t>(requested_extent.width, surface_capabilities->minImageExtent.width, surface_capabilities->maxImageExtent.width),
+            std::clamp<std::uint32_t>(requested_extent.height, surface_capabilities->minImageExtent.height, surface_capabilities->maxImageExtent.height)
          };
 
+      return surface_capabilities->currentExtent;
+   }
+
+   auto SwapChain::swap_chain(vk::SwapchainKHR const old_swap_chain) const -> vk::raii::SwapchainKHR
+   {
+      // TODO: use `vk::StructureChain` and `getSurfaceCapabilities2KHR` for more functionality
+      vk::ResultValue const surface_capabilities{ context_.physical_device.getSurfaceCapabilitiesKHR(surface_) };
+      RUNTIME_ASSERT(surface_capabilities.has_value(),
+         std::format("failed to query surface capabilities! ({})", to_string(surface_capabilities.result)));
+
+      std::uint32_t minimal_image_count{ std::max(description_.minimal_image_count, surface_capabilities->minImageCount) };
+      if (surface_capabilities->maxImageCount)
+         minimal_image_count = std::min(minimal_image_count, surface_capabilities->maxImageCount);
+
       // TODO: use `vk::StructureChain` for more functionality
       vk::ResultValue const available_surface_present_modes{ context_.physical_device.getSurfacePresentModesKHR(surface_) };
       RUNTIME_ASSERT(available_surface_present_modes.has_value(),
@@ -70,22 +234,23 @@ namespace eru
       auto surface_present_mode{
          std::ranges::find_if(
             *available_surface_present_modes,
-            [&parameters](vk::PresentModeKHR const& available_surface_present_mode)
+            [this](vk::PresentModeKHR const& available_surface_present_mode)
             {
-               return available_surface_present_mode == parameters.present_mode;
+               return available_surface_present_mode == description_.present_mode;
             })
       };
       if (surface_present_mode == std::ranges::end(*available_surface_present_modes))
          surface_present_mode = std::ranges::begin(*available_surface_present_modes);
 
-      // TODO: make use of `oldSwapchain`
+      // handing over the old swap chain lets the presentation engine reuse its resources, and keeps images presented
+      // from it on screen until the new one presents
       vk::ResultValue swap_chain{
          context_.device.createSwapchainKHR({
             .surface{ *surface_ },
             .minImageCount{ minimal_image_count },
-            .imageFormat{ surface_format->format },
-            .imageColorSpace{ surface_format->colorSpace },
-            .imageExtent{ surface_capabilities->currentExtent },
+            .imageFormat{ surface_format_.format },
+            .imageColorSpace{ surface_format_.colorSpace },
+            .imageExtent{ extent_ },
             .imageArrayLayers{ 1 },
             .imageUsage{ vk::ImageUsageFlagBits::eColorAttachment },
             .imageSharingMode{ vk::SharingMode::eExclusive },
@@ -95,7 +260,7 @@ namespace eru
             .compositeAlpha{ vk::CompositeAlphaFlagBitsKHR::eOpaque },
             .presentMode{ *surface_present_mode },
             .clipped{ true },
-            .oldSwapchain{}
+            .oldSwapchain{ old_swap_chain }
          })
       };
       RUNTIME_ASSERT(swap_chain.has_value(),
@@ -113,11 +278,11 @@ namespace eru
       return std::move(*swap_chain_images);
    }
 
-   auto SwapChain::swap_chain_image_views(vk::Format const format) const -> std::vector<vk::raii::ImageView>
+   auto SwapChain::swap_chain_image_views() const -> std::vector<vk::raii::ImageView>
    {
       vk::ImageViewCreateInfo create_info{
          .viewType{ vk::ImageViewType::e2D },
-         .format{ format },
+         .format{ surface_format_.format },
          .components{
             .r{ vk::ComponentSwizzle::eIdentity },
             .g{ vk::ComponentSwizzle::eIdentity },
@@ -147,4 +312,45 @@ namespace eru
 
       return image_views;
    }
+
+   auto SwapChain::present_fence() -> vk::raii::Fence
+   {
+      if (free_present_fences_.empty())
+      {
+         vk::ResultValue fence{ context_.device.createFence({}) };
+         RUNTIME_ASSERT(fence.has_value(),
+            std::format("failed to create a present fence! ({})", to_string(fence.result)));
+
+         return std::move(*fence);
+      }
+
+      vk::raii::Fence fence{ std::move(free_present_fences_.back()) };
+      free_present_fences_.pop_back();
+
+      vk::Result const result{ context_.device.resetFences(*fence) };
+      RUNTIME_ASSERT(result == vk::Result::eSuccess,
+         std::format("failed to reset a present fence! ({})", to_string(result)));
+
+      return fence;
+   }
+
+   auto SwapChain::release_presented() -> void
+   {
+      auto const presented{
+         [](vk::raii::Fence const& fence) -> bool
+         {
+            return fence.getStatus() == vk::Result::eSuccess;
+         }
+      };
+
+      auto const released_fences{ std::ranges::partition(present_fences_, std::not_fn(presented)) };
+      free_present_fences_.append_range(released_fences | std::views::as_rvalue);
+      present_fences_.erase(released_fences.begin(), released_fences.end());
+
+      std::erase_if(retired_swap_chains_,
+         [&presented](RetiredSwapChain const& retired_swap_chain) -> bool
+         {
+            return std::ranges::all_of(retired_swap_chain.present_fences, presented);
+         });
+   }
 }
\ No newline at end of file
@@ -0,0 +1,287 @@
+#include "eruptor/context.hpp"
+#include "eruptor/runtime_assert.hpp"
+#include "eruptor/upscaler.hpp"
+
+#include "core/shader.hpp"
+
+namespace eru
+{
+   Upscaler::Upscaler(vk::Format const target_format)
+      : target_format_{ target_format }
+   {
+   }
+
+   auto Upscaler::record(vk::raii::CommandBuffer const& command_buffer, vk::ImageView const source,
+      vk::Extent2D const source_extent, vk::ImageView const target, vk::Extent2D const target_extent) const -> void
+   {
+      vk::RenderingAttachmentInfo const attachment_info{
+         .imageView{ target },
+         .imageLayout{ vk::ImageLayout::eColorAttachmentOptimal },
+         .loadOp{ vk::AttachmentLoadOp::eDontCare },
+         .storeOp{ vk::AttachmentStoreOp::eStore }
+      };
+
+      command_buffer.beginRendering({
+         .renderArea{
+            .extent{ target_extent }
+         },
+         .layerCount{ 1 },
+         .colorAttachmentCount{ 1 },
+         .pColorAttachments{ &attachment_info }
+      });
+
+      command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline_);
+
+      vk::DescriptorImageInfo const sampler_info{
+         .sampler{ sampler_ }
+      };
+
+      vk::DescriptorImageInfo const source_info{
+         .imageView{ source },
+         .imageLayout{ vk::ImageLayout::eShaderReadOnlyOptimal }
+      };
+
+      std::array const writes{
+         std::to_array<vk::WriteDescriptorSet>({
+            {
+               .dstBinding{ 0 },
+               .descriptorCount{ 1 },
+               .descriptorType{ vk::DescriptorType::eSampler },
+               .pImageInfo{ &sampler_info }
+            },
+            {
+               .dstBinding{ 1 },
+               .descriptorCount{ 1 },
+               .descriptorType{ vk::DescriptorType::eSampledImage },
+               .pImageInfo{ &source_info }
+            }
+         })
+      };
+
+      command_buffer.pushDescriptorSet(vk::PipelineBindPoint::eGraphics, pipeline_layout_, 0, writes);
+
+      UpscaleConstants const upscale_constants{
+         .source_size{ static_cast<float>(source_extent.width), static_cast<float>(source_extent.height) },
+         .target_size{ static_cast<float>(target_extent.width), static_cast<float>(target_extent.height) }
+      };
+      command_buffer.pushConstants<UpscaleConstants>(pipeline_layout_, vk::ShaderStageFlagBits::eFragment, 0, upscale_constants);
+
+      command_buffer.setViewport(0, {
+         {
+            .width{ static_cast<float>(target_extent.width) },
+            .height{ static_cast<float>(target_extent.height) },
+            .maxDepth{ 1.0f },
+         }
+      });
+
+      command_buffer.setScissor(0, {
+         {
+            .extent{ target_extent }
+         }
+      });
+
+      // a single triangle covering the whole target, generated from the vertex index alone
+      command_buffer.draw(3, 1, 0, 0);
+
+      command_buffer.endRendering();
+   }
+
+   auto Upscaler::sampler() const -> vk::raii::Sampler
+   {
+      // the filter places its taps between texels, so that bilinear filtering weighs pairs of them in one fetch
+      vk::ResultValue sampler{
+         context_.device.createSampler({
+            .magFilter{ vk::Filter::eLinear },
+            .minFilter{ vk::Filter::eLinear },
+            .mipmapMode{ vk::SamplerMipmapMode::eNearest },
+            .addressModeU{ vk::SamplerAddressMode::eClampToEdge },
+            .addressModeV{ vk::SamplerAddressMode::eClampToEdge },
+            .addressModeW{ vk::SamplerAddressMode::eClampToEdge },
+            .mipLodBias{},
+            .anisotropyEnable{ vk::False },
+            .compareEnable{ vk::False },
+            .compareOp{ vk::CompareOp::eAlways },
+            .minLod{ 0.0f },
+            .maxLod{ 0.0f },
+            .borderColor{ vk::BorderColor::eFloatTransparentBlack },
+            .unnormalizedCoordinates{ vk::False }
+         })
+      };
+      RUNTIME_ASSERT(sampler.has_value(),
+         std::format("failed to create upscaler sampler! ({})", to_string(sampler.result)));
+
+      return std::move(*sampler);
+   }
+
+   auto Upscaler::descriptor_set_layout() const -> vk::raii::DescriptorSetLayout
+   {
+      std::array constexpr bindings{
+         std::to_array<vk::DescriptorSetLayoutBinding>({
+            {
+               .binding{ 0 },
+               .descriptorType{ vk::DescriptorType::eSampler },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eFragment }
+            },
+            {
+               .binding{ 1 },
+               .descriptorType{ vk::DescriptorType::eSampledImage },
+               .descriptorCount{ 1 },
+               .stageFlags{ vk::ShaderStageFlagBits::eFragment }
+            }
+         })
+      };
+
+      // pushed on every use, as the source is resized along with the resolution
+      vk::ResultValue descriptor_set_layout{
+         context_.device.createDescriptorSetLayout({
+            .flags{ vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptor },
+            .bindingCount{ static_cast<std::uint32_t>(std::ranges::size(bindings)) },
+            .pBindings{ std::ranges::data(bindings) }
+         })
+      };
+      RUNTIME_ASSERT(descriptor_set_layout.has_value(),
+         std::format("failed to create upscaler descriptor set layout! ({})", to_string(descriptor_set_layout.result)));
+
+      return std::move(*descriptor_set_layout);
+   }
+
+   auto Upscaler::pipeline_layout() const -> vk::raii::PipelineLayout
+   {
+      std::array const layouts{
+         std::to_array<vk::DescriptorSetLayout>({
+            *descriptor_set_layout_
+         })
+      };
+
+      std::array constexpr push_constant_ranges{
+         std::to_array<vk::PushConstantRange>({
+            {
+               .stageFlags{ vk::ShaderStageFlagBits::eFragment },
+               .offset{ 0 },
+               .size{ sizeof(UpscaleConstants) }
+            }
+         })
+      };
+
+      vk::ResultValue pipeline_layout{
+         context_.device.createPipelineLayout({
+            .setLayoutCount{ static_cast<std::uint32_t>(std::ranges::size(layouts)) },
+            .pSetLayouts{ std::ranges::data(layouts) },
+            .pushConstantRangeCount{ static_cast<std::uint32_t>(std::ranges::size(push_constant_ranges)) },
+            .pPushConstantRanges{ std::ranges::data(push_constant_ranges) }
+         })
+      };
+      RUNTIME_ASSERT(pipeline_layout.has_value(),
+         std::format("failed to create an upscaler pipeline layout! ({})", to_string(pipeline_layout.result)));
+
+      return std::move(*pipeline_layout);
+   }
+
+   auto Upscaler::pipeline() const -> vk::raii::Pipeline
+   {
+      std::vector<std::uint32_t> const code{ compile_framework_shader("upscaling.slang") };
+
+      vk::ShaderModuleCreateInfo const shader_module_create_info{
+         .codeSize{ code.size() * sizeof(decltype(code)::value_type) },
+         .pCode{ code.data() }
+      };
+
+      std::array const shader_stage_create_infos{
+         std::to_array<vk::PipelineShaderStageCreateInfo>({
+            {
+               .pNext{ &shader_module_create_info },
+               .stage{ vk::ShaderStageFlagBits::eVertex },
+               .pName{ "vertMain" }
+            },
+            {
+               .pNext{ &shader_module_create_info },
+               .stage{ vk::ShaderStageFlagBits::eFragment },
+               .pName{ "fragMain" }
+            }
+         })
+      };
+
+      std::array constexpr dynamic_states{
+         vk::DynamicState::eViewport,
+         vk::DynamicState::eScissor
+      };
+
+      vk::PipelineDynamicStateCreateInfo const dynamic_state_create_info{
+         .dynamicStateCount{ static_cast<uint32_t>(std::ranges::size(dynamic_states)) },
+         .pDynamicStates{ std::ranges::data(dynamic_states) }
+      };
+
+      vk::PipelineVertexInputStateCreateInfo constexpr vertex_input_state_create_info{};
+
+      vk::PipelineInputAssemblyStateCreateInfo constexpr input_assembly_state_create_info{
+         .topology{ vk::PrimitiveTopology::eTriangleList }
+      };
+
+      vk::PipelineViewportStateCreateInfo constexpr viewport_state_create_info{
+         .viewportCount{ 1 },
+         .scissorCount{ 1 }
+      };
+
+      vk::PipelineRasterizationStateCreateInfo constexpr rasterization_state_create_info{
+         .depthClampEnable{ vk::False },
+         .rasterizerDiscardEnable{ vk::False },
+         .polygonMode{ vk::PolygonMode::eFill },
+         .cullMode{ vk::CullModeFlagBits::eNone },
+         .frontFace{ vk::FrontFace::eCounterClockwise },
+         .depthBiasEnable{ vk::False },
+         .lineWidth{ 1.0f }
+      };
+
+      vk::PipelineMultisampleStateCreateInfo constexpr multisample_state_create_info{
+         .rasterizationSamples{ vk::SampleCountFlagBits::e1 },
+         .sampleShadingEnable{ vk::False }
+      };
+
+      std::array constexpr color_blend_attachment_state{
+         std::to_array<vk::PipelineColorBlendAttachmentState>({
+            {
+               .blendEnable{ vk::False },
+               .colorWriteMask{
+                  vk::ColorComponentFlagBits::eR |
+                  vk::ColorComponentFlagBits::eG |
+                  vk::ColorComponentFlagBits::eB |
+                  vk::ColorComponentFlagBits::eA
+               }
+            }
+         })
+      };
+
+      vk::PipelineColorBlendStateCreateInfo const color_blend_state_create_info{
+         .logicOpEnable{ vk::False },
+         .logicOp{ vk::LogicOp::eCopy },
+         .attachmentCount{ static_cast<std::uint32_t>(std::ranges::size(color_blend_attachment_state)) },
+         .pAttachments{ std::ranges::data(color_blend_attachment_state) }
+      };
+
+      vk::PipelineRenderingCreateInfo const pipeline_rendering_create_info{
+         .colorAttachmentCount{ 1 },
+         .pColorAttachmentFormats{ &target_format_ }
+      };
+
+      vk::ResultValue pipeline{
+         context_.device.createGraphicsPipeline(nullptr, {
+            .pNext{ &pipeline_rendering_create_info },
+            .stageCount{ static_cast<std::uint32_t>(std::ranges::size(shader_stage_create_infos)) },
+            .pStages{ std::ranges::data(shader_stage_create_infos) },
+            .pVertexInputState{ &vertex_input_state_create_info },
+            .pInputAssemblyState{ &input_assembly_state_create_info },
+            .pViewportState{ &viewport_state_create_info },
+            .pRasterizationState{ &rasterization_state_create_info },
+            .pMultisampleState{ &multisample_state_create_info },
+            .pColorBlendState{ &color_blend_state_create_info },
+            .pDynamicState{ &dynamic_state_create_info },
+            .layout{ pipeline_layout_ },
+         })
+      };
+      RUNTIME_ASSERT(pipeline.has_value(),
+         std::format("failed create an upscaler pipeline! ({})", to_string(pipeline.result)));
+
+      return std::move(*pipeline);
+   }
+}
\ No newline at end of file
@@ -2,36 +2,54 @@
 
 namespace eru
 {
+   static_assert(
+      Vertex::PositionLayout::STRIDE == offsetof(Vertex::Packed, attributes) and
+      Vertex::PositionLayout::STRIDE + Vertex::AttributeLayout::STRIDE == sizeof(Vertex::Packed),
+      "the attributes have to be laid out like the tail of a packed vertex!");
+
+   static_assert(
+      Vertex::AttributeLayout::STRIDE == sizeof(Vertex::Attributes) and
+      Vertex::AttributeLayout::OFFSETS[0] == offsetof(Vertex::Attributes, color) and
+      Vertex::AttributeLayout::OFFSETS[1] == offsetof(Vertex::Attributes, texture_coordinate),
+      "the attribute layout has to match the attributes!");
+
    decltype(Vertex::INPUT_BINDING_DESCRIPTIONS) Vertex::INPUT_BINDING_DESCRIPTIONS{
       {
          {
             .binding{ 0 },
-            .stride{ static_cast<std::uint32_t>(sizeof(Vertex)) },
+            .stride{ static_cast<std::uint32_t>(sizeof(Packed)) },
+            .inputRate{ vk::VertexInputRate::eVertex }
+         },
+         {
+            .binding{ 2 },
+            .stride{ static_cast<std::uint32_t>(sizeof(Packed)) },
             .inputRate{ vk::VertexInputRate::eVertex }
          }
       }
    };
 
    decltype(Vertex::INPUT_ATTRIBUTE_DESCRIPTIONS) Vertex::INPUT_ATTRIBUTE_DESCRIPTIONS{
+      join(PositionLayout::attribute_descriptions(0), AttributeLayout::attribute_descriptions(2, 1))
+   };
+
+   decltype(Vertex::POSITION_INPUT_BINDING_DESCRIPTIONS) Vertex::POSITION_INPUT_BINDING_DESCRIPTIONS{
       {
-         {
-            .location{ 0 },
-            .binding{ 0 },
-            .format{ vk::Format::eR32G32B32Sfloat },
-            .offset{ offsetof(Vertex, position) }
-         },
-         {
-            .location{ 1 },
-            .binding{ 0 },
-            .format{ vk::Format::eR32G32B32Sfloat },
-            .offset{ offsetof(Vertex, color) }
-         },
-         {
-            .location{ 2 },
-            .binding{ 0 },
-            .format{ vk::Format::eR32G32Sfloat },
-            .offset{ offsetof(Vertex, texture_coordinate) }
-         }
+         INPUT_BINDING_DESCRIPTIONS[0]
       }
    };
+
+   decltype(Vertex::POSITION_INPUT_ATTRIBUTE_DESCRIPTIONS) Vertex::POSITION_INPUT_ATTRIBUTE_DESCRIPTIONS{
+      PositionLayout::attribute_descriptions(0)
+   };
+
+   auto Vertex::packed() const -> Packed
+   {
+      return {
+         .position{ encode_half(position) },
+         .attributes{
+            .color{ encode_unorm8(glm::vec4{ color, 1.0f }) },
+            .texture_coordinate{ encode_unorm16(texture_coordinate) }
+         }
+      };
+   }
 }
\ No newline at end of file
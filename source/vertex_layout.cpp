@@ -0,0 +1,74 @@
+#include "eruptor/vertex_layout.hpp"
+
+namespace eru
+{
+   namespace
+   {
+      // unlike `glm::sign`, never 0, so that normals on the equator still fold onto an edge
+      auto sign_not_zero(glm::vec2 const& value) -> glm::vec2
+      {
+         return { value.x < 0.0f ? -1.0f : 1.0f, value.y < 0.0f ? -1.0f : 1.0f };
+      }
+   }
+
+   auto encode_half(glm::vec3 const& value) -> Half4
+   {
+      return {
+         .bits{ glm::packHalf1x16(value.x), glm::packHalf1x16(value.y), glm::packHalf1x16(value.z),
+            glm::packHalf1x16(1.0f) }
+      };
+   }
+
+   auto encode_half(glm::vec2 const& value) -> Half2
+   {
+      return {
+         .bits{ glm::packHalf1x16(value.x), glm::packHalf1x16(value.y) }
+      };
+   }
+
+   auto encode_unorm8(glm::vec4 const& value) -> Unorm8x4
+   {
+      glm::u8vec4 const packed{ glm::packUnorm<std::uint8_t>(value) };
+      return {
+         .values{ packed.x, packed.y, packed.z, packed.w }
+      };
+   }
+
+   auto encode_unorm16(glm::vec2 const& value) -> Unorm16x2
+   {
+      glm::u16vec2 const packed{ glm::packUnorm<std::uint16_t>(value) };
+      return {
+         .values{ packed.x, packed.y }
+      };
+   }
+
+   auto encode_octahedral(glm::vec3 const& normal) -> Snorm16x2
+   {
+      // projected onto the octahedron, with the lower half folded over the upper one
+      glm::vec2 folded{ glm::vec2{ normal } / (std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z)) };
+      if (normal.z < 0.0f)
+         folded = (1.0f - glm::abs(glm::vec2{ folded.y, folded.x })) * sign_not_zero(folded);
+
+      glm::i16vec2 const packed{ glm::packSnorm<std::int16_t>(folded) };
+      return {
+         .values{ packed.x, packed.y }
+      };
+   }
+
+   auto decode_octahedral(Snorm16x2 const& encoded_normal) -> glm::vec3
+   {
+      glm::vec2 const folded{
+         glm::unpackSnorm<float>(glm::i16vec2{ encoded_normal.values[0], encoded_normal.values[1] })
+      };
+
+      glm::vec3 normal{ folded, 1.0f - std::abs(folded.x) - std::abs(folded.y) };
+      if (normal.z < 0.0f)
+      {
+         glm::vec2 const unfolded{ (1.0f - glm::abs(glm::vec2{ normal.y, normal.x })) * sign_not_zero(folded) };
+         normal.x = unfolded.x;
+         normal.y = unfolded.y;
+      }
+
+      return glm::normalize(normal);
+   }
+}
\ No newline at end of file
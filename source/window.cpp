@@ -1,4 +1,5 @@
 ﻿#include "eruptor/locator.hpp"
+#include "eruptor/platform.hpp"
 #include "eruptor/window.hpp"
 
 #include "core/dependencies.hpp"
@@ -34,6 +35,30 @@ namespace eru
       }
       , swap_chain_{ PassKey<Window>{}, surface_, swap_chain_description }
    {
+      glfwSetWindowUserPointer(native_window_.get(), this);
+      glfwSetFramebufferSizeCallback(native_window_.get(),
+         [](NativeHandle* const native_window, int const width, int const height)
+         {
+            static_cast<Window*>(glfwGetWindowUserPointer(native_window))->framebuffer_extent_ = glm::uvec2{ width, height };
+            Locator::get<Platform>().request_redraw();
+         });
+
+      // anything that can change what the window shows wakes up a platform waiting for a redraw
+      auto constexpr request_redraw{
+         [](auto...)
+         {
+            Locator::get<Platform>().request_redraw();
+         }
+      };
+
+      glfwSetWindowRefreshCallback(native_window_.get(), request_redraw);
+      glfwSetWindowFocusCallback(native_window_.get(), request_redraw);
+      glfwSetKeyCallback(native_window_.get(), request_redraw);
+      glfwSetCharCallback(native_window_.get(), request_redraw);
+      glfwSetMouseButtonCallback(native_window_.get(), request_redraw);
+      glfwSetCursorPosCallback(native_window_.get(), request_redraw);
+      glfwSetCursorEnterCallback(native_window_.get(), request_redraw);
+      glfwSetScrollCallback(native_window_.get(), request_redraw);
    }
 
    auto Window::change_visibility(bool const visible) -> void
@@ -58,6 +83,11 @@ namespace eru
       return extent;
    }
 
+   auto Window::framebuffer_extent() const -> glm::uvec2
+   {
+      return framebuffer_extent_;
+   }
+
    auto Window::change_position(glm::uvec2 const position) -> void
    {
       glfwSetWindowPos(native_window_.get(), position.x, position.y);
@@ -80,6 +110,11 @@ namespace eru
       return glfwGetWindowTitle(native_window_.get());
    }
 
+   auto Window::swap_chain() -> SwapChain&
+   {
+      return swap_chain_;
+   }
+
    auto Window::swap_chain() const -> SwapChain const&
    {
       return swap_chain_;